@@ -11,12 +11,28 @@
 #include "../grammers/CFG.h"
 #include "../visualization/HTTPTreeBuilder.h"
 #include "../visualization/DotGenerator.h"
+#include "../pipeline/HTTP10Framer.h"
+#include "../pipeline/Verdict.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
 
 using namespace std;
 
-bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
+// Message/rejection counters for the Performance panel
+static void countResult(bool ok, VerdictCode code)
+{
+    Metrics::add(Counter::Messages);
+    if (!ok) {
+        Metrics::add(Counter::Rejected);
+        Metrics::countError((size_t)code);
+    }
+}
+
+// Full diagnostic run over exactly one request
+static bool checkSingleRequest(const std::string& input, ProtocolCheckResult& out)
 {
     out = ProtocolCheckResult{};
+    TraceSpan span("check_request");
 
     std::stringstream log;
     log << "=== HTTP/1.0 Request Validator ===\n";
@@ -27,6 +43,7 @@ bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
         out.syntaxMessage = "Input is empty";
         log << "Error: empty input\n";
         out.logText = log.str();
+        countResult(false, VerdictCode::EmptyInput);
         return false;
     }
 
@@ -144,6 +161,7 @@ bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
         }
 
         out.logText = log.str();
+        countResult(false, VerdictCode::SyntaxError);
         return false;
     }
 
@@ -165,11 +183,13 @@ bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
             log << "Error code: " << sem.code << "\n";
 
         out.logText = log.str();
+        countResult(false, verdictCodeFromSemantic(sem.code));
         return false;
     }
 
     out.semanticsOk = true;
     out.semanticsMessage = "Semantics OK";
+    countResult(true, VerdictCode::Ok);
     log << "✓ SEMANTICS VALID: The request meaning is valid!\n";
 
     log << "\n--- Step 6: Generating Parse Tree Visualization ---\n";
@@ -191,3 +211,49 @@ bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
     return true;
 }
 
+bool runHTTP10Check(const std::string& input, ProtocolCheckResult& out)
+{
+    // A pasted keep-alive stream or corpus holds several requests; the
+    // single-request pipeline would only ever look at the first one.
+    std::vector<FramedMessage> frames;
+    size_t consumed = 0;
+    FrameStatus status = HTTP10Framer::split(input, frames, consumed);
+
+    bool hasRest = consumed < input.size();
+    if (frames.size() + (hasRest ? 1 : 0) < 2)
+        return checkSingleRequest(input, out);
+
+    std::vector<std::string> messages;
+    for (const FramedMessage& m : frames)
+        messages.emplace_back(m.head);
+    if (hasRest)
+        messages.emplace_back(input.substr(consumed));
+
+    std::stringstream log;
+    log << "=== HTTP/1.0 Stream ===\n";
+    log << "Input size: " << input.size() << " bytes, " << messages.size() << " requests\n";
+    if (status != FrameStatus::Incomplete)
+        log << "Framing stopped at offset " << consumed << ": " << frameStatusName(status) << "\n";
+    log << "\n";
+
+    // Report every request; the result shown is that of the first failure
+    // (or the last request when all pass)
+    ProtocolCheckResult current;
+    bool allOk = true;
+    for (size_t k = 0; k < messages.size(); ++k) {
+        size_t offset = k < frames.size() ? frames[k].offset : consumed;
+        log << "##### Request " << (k + 1) << " of " << messages.size()
+            << " (offset " << offset << ") #####\n";
+        if (k < frames.size() && !frames[k].body.empty())
+            log << "Body: " << frames[k].body.size() << " bytes (Content-Length)\n";
+
+        bool ok = checkSingleRequest(messages[k], current);
+        log << current.logText << "\n";
+
+        if (allOk) out = current;
+        allOk &= ok;
+    }
+
+    out.logText = log.str();
+    return allOk;
+}
@@ -6,6 +6,7 @@
 #include "panels/Panel_Generator.h"
 #include "panels/Panel_InputEditor.h"
 #include "panels/Panel_Results.h"
+#include "panels/Panel_Metrics.h"
 
 void DrawProtocolGui(ProtocolGuiState& state)
 {
@@ -35,12 +36,16 @@ void DrawProtocolGui(ProtocolGuiState& state)
     DrawMessageGenerator(state);
     DrawInputEditor(state);
     DrawResultsPanel(state);
+    DrawMetricsPanel(state);
 
     ImGui::EndChild();
     ImGui::End();
 }
 
 ProtocolGuiState::ProtocolGuiState() {
+    // Stage timings are cheap next to a GUI check; record from the start
+    Metrics::setEnabled(true);
+
     genOptions.headers = {
         {"Host", "example.com", true, false},
         {"User-Agent", "TestClient/1.0", true, false},
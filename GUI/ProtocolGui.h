@@ -5,6 +5,7 @@
 #include "HTTP10Checker.h"
 #include "imgui.h"
 #include "../protocols/HTTP10/HTTP10MessageGenerator.h"
+#include "../utils/Metrics.h"
 
 // --------------------------
 // Protocol selection enum
@@ -38,6 +39,11 @@ struct ProtocolGuiState {
     int parseTreeWidth = 0;
     int parseTreeHeight = 0;
     std::string loadedImagePath;  // Track which image is loaded
+
+    // Performance panel
+    MetricsSnapshot metrics;
+    double metricsTakenAt = -1.0;
+    std::string tracePath;        // last saved Chrome trace
 };
 // --------------------------
 // Main function to render ALL GUI panels
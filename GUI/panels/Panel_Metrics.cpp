@@ -0,0 +1,111 @@
+#include "Panel_Metrics.h"
+#include "imgui.h"
+
+#include <filesystem>
+
+#include "../../utils/Metrics.h"
+#include "../../utils/Trace.h"
+#include "../../pipeline/Verdict.h"
+
+static const char* errorName(size_t code)
+{
+    return code < (size_t)VerdictCode::Count ? verdictCodeName((VerdictCode)code) : nullptr;
+}
+
+static void textMicros(uint64_t nanos)
+{
+    ImGui::Text("%.1f", (double)nanos / 1000.0);
+}
+
+void DrawMetricsPanel(ProtocolGuiState& state)
+{
+    ImGui::Separator();
+    if (!ImGui::CollapsingHeader("Performance"))
+        return;
+
+    bool enabled = Metrics::enabled();
+    if (ImGui::Checkbox("Record", &enabled))
+        Metrics::setEnabled(enabled);
+    ImGui::SameLine();
+    if (ImGui::Button("Reset"))
+        Metrics::reset();
+    ImGui::SameLine();
+    if (ImGui::Button("Copy JSON"))
+        ImGui::SetClipboardText(Metrics::snapshot().toJson(errorName).c_str());
+    ImGui::SameLine();
+    if (ImGui::Button("Copy Prometheus"))
+        ImGui::SetClipboardText(Metrics::snapshot().toPrometheus(errorName).c_str());
+
+    // Timeline of the next checks, for Perfetto / chrome://tracing
+    bool tracing = Trace::enabled();
+    if (ImGui::Checkbox("Record trace", &tracing)) {
+        if (tracing) Trace::start();
+        else         Trace::stop();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save trace")) {
+        Trace::stop();
+        std::filesystem::path outputDir = std::filesystem::current_path() / "visualization" / "output";
+        std::filesystem::create_directories(outputDir);
+        state.tracePath = (outputDir / "trace.json").string();
+        if (!Trace::writeChromeJson(state.tracePath))
+            state.tracePath.clear();
+    }
+    if (tracing || !state.tracePath.empty()) {
+        TraceStats ts = Trace::stats();
+        ImGui::SameLine();
+        ImGui::TextDisabled("%llu events, %llu overwritten", (unsigned long long)ts.recorded,
+                            (unsigned long long)ts.dropped);
+    }
+    if (!state.tracePath.empty())
+        ImGui::TextDisabled("Trace: %s", state.tracePath.c_str());
+
+    // Snapshots walk every thread's histograms; a few per second is plenty
+    double now = ImGui::GetTime();
+    if (now - state.metricsTakenAt > 0.25) {
+        state.metrics = Metrics::snapshot();
+        state.metricsTakenAt = now;
+    }
+    const MetricsSnapshot& m = state.metrics;
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+    if (ImGui::BeginTable("StageTable", 7, flags)) {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Mean us");
+        ImGui::TableSetupColumn("p50 us");
+        ImGui::TableSetupColumn("p99 us");
+        ImGui::TableSetupColumn("p99.9 us");
+        ImGui::TableSetupColumn("Max us");
+        ImGui::TableHeadersRow();
+
+        for (size_t i = 0; i < (size_t)Stage::Count; ++i) {
+            const HistogramSnapshot& h = m.stages[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(stageName((Stage)i));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)h.count);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", h.meanNanos() / 1000.0);
+            ImGui::TableNextColumn(); textMicros(h.percentileNanos(0.50));
+            ImGui::TableNextColumn(); textMicros(h.percentileNanos(0.99));
+            ImGui::TableNextColumn(); textMicros(h.percentileNanos(0.999));
+            ImGui::TableNextColumn(); textMicros(h.maxNanos);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Spacing();
+    for (size_t i = 0; i < (size_t)Counter::Count; ++i)
+        ImGui::BulletText("%s: %llu", counterName((Counter)i), (unsigned long long)m.counters[i]);
+
+    bool anyErrors = false;
+    for (size_t code = 0; code < MAX_ERROR_CODES; ++code) {
+        if (!m.errors[code]) continue;
+        if (!anyErrors) {
+            ImGui::Spacing();
+            ImGui::Text("Errors by code:");
+            anyErrors = true;
+        }
+        const char* name = errorName(code);
+        ImGui::BulletText("%s: %llu", name ? name : "?", (unsigned long long)m.errors[code]);
+    }
+}
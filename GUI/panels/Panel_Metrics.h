@@ -0,0 +1,4 @@
+#pragma once
+#include "../ProtocolGui.h"
+
+void DrawMetricsPanel(ProtocolGuiState& state);
@@ -0,0 +1,20 @@
+//
+// Heap allocation counting for the benchmarks: replaces the global
+// operator new/delete in any executable that links AllocCounter.cpp.
+//
+
+#ifndef BENCH_ALLOCCOUNTER_H
+#define BENCH_ALLOCCOUNTER_H
+
+#include <cstdint>
+
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// Totals for the calling thread since it started (never reset; take the
+// difference of two calls)
+AllocStats threadAllocStats();
+
+#endif // BENCH_ALLOCCOUNTER_H
@@ -0,0 +1,482 @@
+//
+// micro_bench: per-engine microbenchmarks on fixed, seeded inputs.
+//
+//   micro_bench [--filter TEXT] [--min-time SECONDS] [--seed N]
+//               [--format table|json|csv] [--out FILE]
+//
+// Every case reports ns/op, heap bytes/op and allocations/op (counted by
+// the operator new replacement in AllocCounter.cpp). The JSON and CSV
+// formats are stable so results can be diffed between releases. Run from
+// the build directory (grammar files are resolved relative to it).
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "json.hpp"
+
+#include "../grammers/CFG.h"
+#include "../grammers/CFG_CYK.h"
+#include "../grammers/PDA.h"
+#include "../grammers/PDAExecutor.h"
+#include "../grammers/DPDA.h"
+#include "../grammers/TerminalDFA.h"
+#include "../grammers/SentenceGenerator.h"
+#include "../parsers/CoverageGenerator.h"
+#include "../parsers/SLR.h"
+#include "../pipeline/HTTP10Validator.h"
+#include "../protocols/HTTP10/HTTP10CorpusGenerator.h"
+#include "../protocols/HTTP10/HTTP10MessageGenerator.h"
+#include "../protocols/HTTP10/HTTP10Mutator.h"
+#include "../protocols/HTTP10/HTTP10Protocol.h"
+#include "../protocols/HTTP10/HTTP10Tokenizer.h"
+#include "../protocols/HTTP10/HTTP10_semantics.h"
+#include "../protocols/HTTP10/HTTPrequest.h"
+#include "../visualization/DotGenerator.h"
+#include "../visualization/HTTPTreeBuilder.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchCase {
+    std::string name;
+    std::string size;                   // input label ("small", "n=32", ...)
+    size_t inputBytes = 0;
+    std::function<size_t()> op;         // result folded into a sink so it is not optimised away
+    bool quiet = false;                 // op writes to std::cout (CYK): silence it
+};
+
+struct BenchResult {
+    std::string name;
+    std::string size;
+    size_t inputBytes = 0;
+    uint64_t iterations = 0;
+    double nsPerOp = 0;
+    double bytesPerOp = 0;
+    double allocsPerOp = 0;
+};
+
+volatile size_t sink = 0;
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+BenchResult measure(const BenchCase& c, double minSeconds) {
+    NullBuffer null;
+    std::streambuf* saved = c.quiet ? std::cout.rdbuf(&null) : nullptr;
+
+    sink = sink + c.op();               // warm-up: caches, lazy statics
+
+    // Grow the batch until one run lasts minSeconds
+    uint64_t iterations = 1;
+    BenchResult r{c.name, c.size, c.inputBytes};
+    while (true) {
+        AllocStats a0 = threadAllocStats();
+        auto t0 = Clock::now();
+        size_t acc = 0;
+        for (uint64_t i = 0; i < iterations; ++i)
+            acc += c.op();
+        double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        AllocStats a1 = threadAllocStats();
+        sink = sink + acc;
+
+        if (seconds >= minSeconds || iterations >= (1ull << 32)) {
+            r.iterations = iterations;
+            r.nsPerOp = seconds * 1e9 / (double)iterations;
+            r.bytesPerOp = (double)(a1.bytes - a0.bytes) / (double)iterations;
+            r.allocsPerOp = (double)(a1.allocations - a0.allocations) / (double)iterations;
+            break;
+        }
+
+        double scale = seconds > 0 ? minSeconds / seconds * 1.2 : 100.0;
+        iterations = std::max(iterations * 2, (uint64_t)((double)iterations * std::min(scale, 100.0)));
+    }
+
+    if (saved) std::cout.rdbuf(saved);
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+struct HttpInput {
+    std::string label;
+    std::string message;
+    std::vector<Token> tokens;
+    std::vector<std::string> terminals;     // for SLR::parse
+    std::vector<int> ids;                   // for SLR::accepts
+    std::vector<int> pdaIds;                // for PDAExecutor / CompiledDPDA::accepts
+    HTTPRequest request;
+    ParseTree tree;
+};
+
+// Valid GET with `headers` headers and a `depth`-segment path; names and
+// values come from the seeded generator, so every run sees the same bytes
+std::string makeRequest(std::mt19937_64& rng, int headers, int depth) {
+    auto word = [&](size_t len) {
+        std::string s;
+        for (size_t i = 0; i < len; ++i) s.push_back((char)('a' + rng() % 26));
+        return s;
+    };
+
+    HTTP10MessageOptions opt;
+    for (int i = 0; i < depth; ++i)
+        opt.path.push_back(word(3 + rng() % 6));
+    for (int i = 0; i < headers; ++i)
+        opt.headers.push_back({"X-" + word(4 + rng() % 8), word(6 + rng() % 20), true, false});
+    return HTTP10MessageGenerator::generate(opt);
+}
+
+std::vector<HttpInput> makeHttpInputs(uint64_t seed, const HTTP10Validator& validator) {
+    struct Shape { const char* label; int headers; int depth; };
+    const Shape shapes[] = {{"small", 2, 1}, {"medium", 16, 4}, {"large", 64, 8}};
+
+    std::mt19937_64 rng(seed);
+    std::vector<HttpInput> inputs;
+    for (const Shape& s : shapes) {
+        HttpInput in;
+        in.label = s.label;
+        in.message = makeRequest(rng, s.headers, s.depth);
+
+        HTTP10Tokenizer tokenizer;
+        in.tokens = tokenizer.tokenize(in.message);
+        for (const Token& t : in.tokens) {
+            if (t.base == BaseToken::END_OF_INPUT) continue;
+            in.terminals.push_back(HTTPTreeBuilder::tokenToTerminal(t));
+            in.ids.push_back(validator.terminalFor(t));
+        }
+        in.request = HTTPRequest::fromTokens(in.tokens);
+        in.tree = HTTPTreeBuilder::build(in.tokens);
+        inputs.push_back(std::move(in));
+    }
+    return inputs;
+}
+
+std::string makeCykInput(std::mt19937_64& rng, size_t n) {
+    std::string w;
+    for (size_t i = 0; i < n; ++i) w.push_back(rng() % 2 ? 'a' : 'b');
+    return w;
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+void printTable(std::ostream& os, const std::vector<BenchResult>& results) {
+    os << std::left << std::setw(18) << "benchmark" << std::setw(8) << "size"
+       << std::right << std::setw(10) << "bytes" << std::setw(14) << "ns/op"
+       << std::setw(14) << "B/op" << std::setw(12) << "allocs/op" << std::setw(12) << "iters" << "\n";
+    for (const auto& r : results) {
+        os << std::left << std::setw(18) << r.name << std::setw(8) << r.size
+           << std::right << std::setw(10) << r.inputBytes
+           << std::fixed << std::setprecision(1) << std::setw(14) << r.nsPerOp
+           << std::setw(14) << r.bytesPerOp << std::setw(12) << r.allocsPerOp
+           << std::setw(12) << r.iterations << "\n";
+    }
+}
+
+void printCsv(std::ostream& os, const std::vector<BenchResult>& results) {
+    os << "benchmark,size,input_bytes,iterations,ns_per_op,bytes_per_op,allocs_per_op\n";
+    for (const auto& r : results) {
+        os << r.name << "," << r.size << "," << r.inputBytes << "," << r.iterations << ","
+           << std::fixed << std::setprecision(2) << r.nsPerOp << "," << r.bytesPerOp << ","
+           << r.allocsPerOp << "\n";
+    }
+}
+
+void printJson(std::ostream& os, const std::vector<BenchResult>& results, uint64_t seed, double minTime) {
+    nlohmann::json j;
+    j["context"] = {
+        {"seed", seed},
+        {"min_time_s", minTime},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+#ifdef NDEBUG
+        {"assertions", false},
+#else
+        {"assertions", true},
+#endif
+    };
+    j["benchmarks"] = nlohmann::json::array();
+    for (const auto& r : results) {
+        j["benchmarks"].push_back({
+            {"name", r.name},
+            {"size", r.size},
+            {"input_bytes", r.inputBytes},
+            {"iterations", r.iterations},
+            {"ns_per_op", r.nsPerOp},
+            {"bytes_per_op", r.bytesPerOp},
+            {"allocs_per_op", r.allocsPerOp},
+        });
+    }
+    os << j.dump(2) << "\n";
+}
+
+void usage() {
+    std::cerr << "Usage: micro_bench [--filter TEXT] [--min-time SECONDS] [--seed N] "
+                 "[--format table|json|csv] [--out FILE]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string format = "table";
+    std::string outFile;
+    double minTime = 0.2;
+    uint64_t seed = 20251201;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue)        filter = argv[++i];
+        else if (arg == "--min-time" && hasValue) minTime = std::atof(argv[++i]);
+        else if (arg == "--seed" && hasValue)     seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--format" && hasValue)   format = argv[++i];
+        else if (arg == "--out" && hasValue)      outFile = argv[++i];
+        else { usage(); return 2; }
+    }
+    if (format != "table" && format != "json" && format != "csv") { usage(); return 2; }
+
+    // ----- fixtures (built once, outside every measurement) -----
+    CFG grammar("protocols/HTTP10/http10.json");
+    if (grammar.getProductions().empty()) {
+        std::cerr << "Error: cannot load protocols/HTTP10/http10.json (run from the build directory)\n";
+        return 1;
+    }
+    SLR slr(grammar);
+    HTTP10Validator validator(grammar);
+    PDA pda("protocols/HTTP10/http10_pda.json");
+    CFG fromPda = pda.toCFG();
+    cyk::CFG cnf("bench/cyk_cnf.json");
+    SentenceGenerator sentences(grammar);
+
+    PDAExecutor pdaExecutor(pda);
+    CompiledDPDA dpda(pda);
+    TerminalDFA dfa = TerminalDFA::fromGrammar(grammar);     // same terminal ids as slr
+
+    std::vector<HttpInput> http = makeHttpInputs(seed, validator);
+    for (auto& in : http)
+        for (const auto& name : in.terminals) in.pdaIds.push_back(pdaExecutor.terminalId(name));
+    std::mt19937_64 cykRng(seed ^ 0xC1CULL);
+
+    // ----- cases -----
+    std::vector<BenchCase> cases;
+
+    cases.push_back({"slr_build", "http10", 0, [&] {
+        SLR built(grammar);
+        return (size_t)built.stateCount();
+    }});
+    cases.push_back({"dfa_build", "http10", 0, [&] {
+        return (size_t)TerminalDFA::fromGrammar(grammar).stateCount();
+    }});
+    cases.push_back({"pda_to_cfg", "http10", 0, [&] {
+        return pda.toCFG().getProductions().size();
+    }});
+    cases.push_back({"pda_to_cfg_lazy", "http10", 0, [&] {
+        return pda.toReducedCFG().getProductions().size();
+    }});
+    cases.push_back({"cfg_simplify", "http10", 0, [&] {
+        CFG g = fromPda;                // includes the copy: simplify() mutates
+        g.simplify();
+        return g.getProductions().size();
+    }});
+    cases.push_back({"cfg_sentence", "http10", 0, [&, rng = Xoshiro256(seed), scratch = SentenceScratch(),
+                                                   out = std::vector<int>()]() mutable {
+        (void)sentences.generate(rng, scratch, out);
+        return out.size();
+    }});
+
+    for (auto& in : http) {
+        const size_t bytes = in.message.size();
+        cases.push_back({"tokenize", in.label, bytes, [&in, tokenizer = HTTP10Tokenizer(),
+                                                       tokens = std::vector<Token>()]() mutable {
+            tokenizer.tokenize(in.message, tokens);
+            return tokens.size();
+        }});
+        cases.push_back({"slr_parse", in.label, bytes, [&] {
+            return (size_t)slr.parse(in.terminals);
+        }});
+        cases.push_back({"slr_accepts", in.label, bytes, [&in, &slr, stack = std::vector<int>()]() mutable {
+            return (size_t)slr.accepts(in.ids, stack);
+        }});
+        cases.push_back({"dfa_accepts", in.label, bytes, [&] {
+            return (size_t)dfa.accepts(in.ids);
+        }});
+        cases.push_back({"pda_exec", in.label, bytes, [&in, &pdaExecutor, scratch = PdaScratch()]() mutable {
+            return (size_t)pdaExecutor.accepts(in.pdaIds, scratch);
+        }});
+        cases.push_back({"dpda_exec", in.label, bytes, [&in, &dpda, scratch = DpdaScratch()]() mutable {
+            return (size_t)dpda.accepts(in.pdaIds, scratch);
+        }});
+        cases.push_back({"semantics", in.label, bytes, [&] {
+            return (size_t)HTTP10_semantics::validateRequest(in.request).ok;
+        }});
+        cases.push_back({"tree_build", in.label, bytes, [&] {
+            return HTTPTreeBuilder::build(in.tokens)->children.size();
+        }});
+        cases.push_back({"dot_generate", in.label, bytes, [&] {
+            return DotGenerator::generate(in.tree).size();
+        }});
+        cases.push_back({"validate", in.label, bytes, [&in, &validator, scratch = ValidatorScratch()]() mutable {
+            return (size_t)validator.validate(in.message, scratch).ok();
+        }});
+    }
+
+    // Coverage corpus: a handful of requests reaching every production,
+    // SLR state and ACTION cell; one op validates all of them
+    CoverageOptions coverageOptions;
+    coverageOptions.sentences.seed = seed;
+    coverageOptions.sentences.maxLength = 40;
+    coverageOptions.sentences.lexemes = HTTP10Protocol::terminalLexemes();
+    coverageOptions.sentences.separator = "";
+    const CoverageCorpus coverage = CoverageGenerator(grammar, slr, coverageOptions).run();
+    size_t coverageBytes = 0;
+    for (const auto& text : coverage.texts) coverageBytes += text.size();
+    cases.push_back({"validate", "coverage", coverageBytes, [&, scratch = ValidatorScratch()]() mutable {
+        size_t ok = 0;
+        for (const auto& text : coverage.texts) ok += validator.validate(text, scratch).ok();
+        return ok;
+    }});
+
+    // Error paths: mutants of valid corpus messages, cycled through one per op
+    HTTP10CorpusOptions mutantSource;
+    mutantSource.seed = seed;
+    mutantSource.invalidRatio = 0.0;
+    HTTP10CorpusGenerator sourceCorpus(mutantSource);
+    HTTP10Mutator mutator;
+    for (uint64_t i = 0; i < 256; ++i)
+        mutator.addSeed(sourceCorpus.message(i));
+
+    Xoshiro256 mutantRng(seed);
+    std::vector<std::string> mutants(1024);
+    std::vector<std::vector<std::string>> mutantTerminals;
+    size_t mutantBytes = 0;
+    HTTP10Tokenizer mutantTokenizer;
+    std::vector<Token> mutantTokens;
+    for (auto& m : mutants) {
+        (void)mutator.mutate(mutantRng, m);
+        mutantBytes += m.size();
+        mutantTokenizer.tokenize(m, mutantTokens);
+        auto& names = mutantTerminals.emplace_back();
+        for (const Token& t : mutantTokens)
+            if (t.base != BaseToken::END_OF_INPUT) names.push_back(HTTPTreeBuilder::tokenToTerminal(t));
+    }
+    mutantBytes /= mutants.size();
+
+    cases.push_back({"mutate", "corpus", mutantBytes, [&, rng = Xoshiro256(seed), out = std::string()]() mutable {
+        (void)mutator.mutate(rng, out);
+        return out.size();
+    }});
+    cases.push_back({"slr_parse", "mutant", mutantBytes, [&, i = size_t(0)]() mutable {
+        return (size_t)slr.parse(mutantTerminals[i++ % mutantTerminals.size()]);
+    }});
+    cases.push_back({"validate", "mutant", mutantBytes, [&, i = size_t(0), scratch = ValidatorScratch()]() mutable {
+        return (size_t)validator.validate(mutants[i++ % mutants.size()], scratch).ok();
+    }});
+
+    // Whole-corpus table walks, one message after another or interleaved
+    // (acceptsMany / validateMany); one op runs all of them
+    HTTP10CorpusOptions batchSource;
+    batchSource.seed = seed;
+    HTTP10CorpusGenerator batchCorpus(batchSource);
+    std::vector<std::string> batchMessages(1024);
+    std::vector<std::string_view> batchViews;
+    std::vector<std::vector<int>> batchIds;
+    std::vector<const std::vector<int>*> batchInputs;
+    size_t batchBytes = 0;
+    HTTP10Tokenizer batchTokenizer;
+    std::vector<Token> batchTokens;
+    for (uint64_t i = 0; i < batchMessages.size(); ++i) {
+        batchMessages[i] = batchCorpus.message(i);
+        batchBytes += batchMessages[i].size();
+        batchTokenizer.tokenize(batchMessages[i], batchTokens);
+        auto& ids = batchIds.emplace_back();
+        for (const Token& t : batchTokens)
+            if (t.base != BaseToken::END_OF_INPUT) ids.push_back(validator.terminalFor(t));
+    }
+    for (const auto& m : batchMessages) batchViews.emplace_back(m);
+    for (const auto& ids : batchIds) batchInputs.push_back(&ids);
+
+    cases.push_back({"slr_accepts", "corpus", batchBytes, [&, stack = std::vector<int>()]() mutable {
+        size_t ok = 0;
+        for (const auto& ids : batchIds) ok += slr.accepts(ids, stack);
+        return ok;
+    }});
+    cases.push_back({"slr_many", "corpus", batchBytes, [&, stacks = std::vector<std::vector<int>>(),
+                                                        accepted = std::vector<uint8_t>(batchIds.size())]() mutable {
+        slr.acceptsMany(batchInputs.data(), batchInputs.size(), stacks, accepted.data());
+        return (size_t)std::count(accepted.begin(), accepted.end(), 1);
+    }});
+    cases.push_back({"dfa_accepts", "corpus", batchBytes, [&] {
+        size_t ok = 0;
+        for (const auto& ids : batchIds) ok += dfa.accepts(ids);
+        return ok;
+    }});
+    cases.push_back({"dfa_many", "corpus", batchBytes, [&, accepted = std::vector<uint8_t>(batchIds.size())]() mutable {
+        dfa.acceptsMany(batchInputs.data(), batchInputs.size(), accepted.data());
+        return (size_t)std::count(accepted.begin(), accepted.end(), 1);
+    }});
+    cases.push_back({"validate", "corpus", batchBytes, [&, scratch = ValidatorScratch()]() mutable {
+        size_t ok = 0;
+        for (auto m : batchViews) ok += validator.validate(m, scratch).ok();
+        return ok;
+    }});
+    cases.push_back({"validate_many", "corpus", batchBytes, [&, scratch = ValidatorScratch(),
+                                                             out = std::vector<Verdict>(batchViews.size())]() mutable {
+        validator.validateMany(batchViews.data(), batchViews.size(), scratch, out.data());
+        return (size_t)std::count_if(out.begin(), out.end(), [](const Verdict& v) { return v.ok(); });
+    }});
+
+    for (size_t n : {8, 16, 32}) {
+        std::string w = makeCykInput(cykRng, n);
+        BenchCase c{"cyk_analyze", "n=" + std::to_string(n), n, [&cnf, w] {
+            cnf.analyze(w);
+            return w.size();
+        }};
+        c.quiet = true;                 // analyze() prints its table
+        cases.push_back(std::move(c));
+    }
+
+    // ----- run -----
+    std::vector<BenchResult> results;
+    for (const auto& c : cases) {
+        std::string full = c.name + "/" + c.size;
+        if (!filter.empty() && full.find(filter) == std::string::npos) continue;
+        std::cerr << "  " << full << "\n";
+        results.push_back(measure(c, minTime));
+    }
+
+    std::ofstream file;
+    if (!outFile.empty()) {
+        file.open(outFile);
+        if (!file) {
+            std::cerr << "Error: cannot write " << outFile << "\n";
+            return 1;
+        }
+    }
+    std::ostream& os = outFile.empty() ? std::cout : file;
+
+    if (format == "json")     printJson(os, results, seed, minTime);
+    else if (format == "csv") printCsv(os, results);
+    else                      printTable(os, results);
+    return 0;
+}
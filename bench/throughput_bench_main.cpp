@@ -0,0 +1,446 @@
+//
+// throughput_bench: end-to-end messages/sec and latency percentiles of the
+// validation pipeline on a generated traffic mix, single-threaded and at
+// N threads.
+//
+//   throughput_bench [--messages N] [--invalid PERCENT]
+//                    [--headers COUNT:WEIGHT,...] [--depth SEGMENTS:WEIGHT,...]
+//                    [--methods NAME:WEIGHT,...] [--threads 1,2,4,...]
+//                    [--seconds S] [--tree] [--seed N] [--engine slr|dfa]
+//                    [--prefilter] [--format table|json] [--out FILE]
+//   throughput_bench --write FILE [--length-prefixed] [--messages N] [mix options]
+//
+// Each message goes through what runHTTP10Check does per request minus the
+// Graphviz render: tokenize, SLR parse and semantics (HTTP10Validator), plus
+// the parse tree build for accepted messages with --tree. --engine dfa runs
+// the syntax step on the grammar compiled to a DFA; --prefilter puts the
+// regular approximation's DFA in front of it and reports its hit rate from
+// one extra, untimed pass. Workers share one
+// validator and walk the same corpus from different offsets until the time
+// is up; every message is timed individually into a log-linear histogram.
+// Run from the build directory (grammar files are resolved relative to it).
+//
+// --write only generates: the mix goes to FILE as newline-delimited (or
+// length-prefixed) records using every hardware thread, for corpora too big
+// to hold in memory.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json.hpp"
+
+#include "../grammers/CFG.h"
+#include "../pipeline/HTTP10Validator.h"
+#include "../protocols/HTTP10/HTTP10CorpusGenerator.h"
+#include "../utils/Metrics.h"
+#include "../visualization/HTTPTreeBuilder.h"
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Traffic mix
+// ---------------------------------------------------------------------------
+
+// "value:weight,value:weight,..." e.g. "0:10,4:60,16:30"; a value without
+// a weight counts 1
+template <typename T>
+bool parseWeighted(const std::string& spec, std::vector<std::pair<T, double>>& out) {
+    std::vector<std::pair<T, double>> parsed;
+    std::istringstream in(spec);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        size_t colon = item.find(':');
+        std::istringstream value(item.substr(0, colon));
+        T v{};
+        if (!(value >> v)) return false;
+        double w = colon == std::string::npos ? 1.0 : std::atof(item.c_str() + colon + 1);
+        if (w < 0) return false;
+        parsed.emplace_back(v, w);
+    }
+    if (parsed.empty()) return false;
+    out = std::move(parsed);
+    return true;
+}
+
+bool parseCounts(const std::string& spec, std::vector<WeightedCount>& out) {
+    std::vector<std::pair<int, double>> parsed;
+    if (!parseWeighted(spec, parsed)) return false;
+    out.clear();
+    for (const auto& [v, w] : parsed) out.push_back({v, w});
+    return true;
+}
+
+std::string describe(const std::vector<WeightedCount>& list) {
+    std::ostringstream os;
+    for (size_t i = 0; i < list.size(); ++i)
+        os << (i ? "," : "") << list[i].value << ":" << list[i].weight;
+    return os.str();
+}
+
+std::string describe(const std::vector<std::pair<std::string, double>>& list) {
+    std::ostringstream os;
+    for (size_t i = 0; i < list.size(); ++i)
+        os << (i ? "," : "") << list[i].first << ":" << list[i].second;
+    return os.str();
+}
+
+struct TrafficMix {
+    size_t messages = 20000;
+    HTTP10CorpusOptions corpus;
+};
+
+struct Corpus {
+    std::string data;
+    std::vector<std::string_view> views;
+    HTTP10CorpusStats stats;
+};
+
+Corpus buildCorpus(const TrafficMix& mix) {
+    HTTP10CorpusGenerator generator(mix.corpus);
+
+    Corpus c;
+    c.stats = generator.append(c.data, 0, mix.messages);
+    c.views = HTTP10CorpusGenerator::splitRecords(c.data, mix.corpus.format);
+    return c;
+}
+
+// ---------------------------------------------------------------------------
+// Runs
+// ---------------------------------------------------------------------------
+
+struct RunResult {
+    unsigned threads = 0;
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t rejected = 0;
+    double seconds = 0;
+    HistogramSnapshot latency;
+
+    [[nodiscard]] double messagesPerSecond() const { return seconds > 0 ? (double)messages / seconds : 0; }
+    [[nodiscard]] double megabytesPerSecond() const { return seconds > 0 ? (double)bytes / seconds / 1e6 : 0; }
+};
+
+struct alignas(64) WorkerResult {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t rejected = 0;
+    uint64_t treeNodes = 0;         // keeps the --tree work observable
+    HistogramSnapshot latency;
+};
+
+void runWorker(const HTTP10Validator& validator, const Corpus& corpus, size_t start, bool tree,
+               const std::atomic<bool>& go, const std::atomic<bool>& stop, WorkerResult& out) {
+    ValidatorScratch scratch;
+    const size_t n = corpus.views.size();
+
+    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+    size_t i = start;
+    while (!stop.load(std::memory_order_relaxed)) {
+        // Poll the stop flag once per burst, not once per message
+        for (int burst = 0; burst < 32; ++burst) {
+            const std::string_view msg = corpus.views[i];
+            if (++i == n) i = 0;
+
+            const uint64_t t0 = Trace::nowNanos();
+            const Verdict v = validator.validate(msg, scratch);
+            if (tree && v.ok())
+                out.treeNodes += HTTPTreeBuilder::build(scratch.tokens)->children.size();
+            const uint64_t ns = Trace::nowNanos() - t0;
+
+            out.messages++;
+            out.bytes += msg.size();
+            out.rejected += !v.ok();
+            out.latency.count++;
+            out.latency.sumNanos += ns;
+            out.latency.maxNanos = std::max(out.latency.maxNanos, ns);
+            out.latency.buckets[LatencyHistogram::bucketOf(ns)]++;
+        }
+    }
+}
+
+RunResult runAt(unsigned threads, const HTTP10Validator& validator, const Corpus& corpus,
+                double seconds, bool tree) {
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> pool;
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+
+    // Spread the starting points so threads do not walk the corpus in lockstep
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t start = corpus.views.size() * t / threads;
+        pool.emplace_back(runWorker, std::cref(validator), std::cref(corpus), start, tree,
+                          std::cref(go), std::cref(stop), std::ref(results[t]));
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& th : pool) th.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    RunResult r;
+    r.threads = threads;
+    r.seconds = elapsed;
+    for (const auto& w : results) {
+        r.messages += w.messages;
+        r.bytes += w.bytes;
+        r.rejected += w.rejected;
+        r.latency.count += w.latency.count;
+        r.latency.sumNanos += w.latency.sumNanos;
+        r.latency.maxNanos = std::max(r.latency.maxNanos, w.latency.maxNanos);
+        for (int b = 0; b < LatencyHistogram::BUCKETS; ++b)
+            r.latency.buckets[b] += w.latency.buckets[b];
+    }
+    return r;
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+// Share of the messages reaching the syntax step that the prefilter rejected
+double prefilterHitRate(const MetricsSnapshot& m) {
+    const uint64_t seen = m.counter(Counter::PrefilterRejects) + m.counter(Counter::PrefilterPasses);
+    return seen ? (double)m.counter(Counter::PrefilterRejects) / (double)seen : 0.0;
+}
+
+void printTable(std::ostream& os, const TrafficMix& mix, const Corpus& corpus,
+                const std::vector<RunResult>& runs, const MetricsSnapshot* prefilter) {
+    const HTTP10CorpusStats& st = corpus.stats;
+    os << "corpus: " << st.records << " messages, " << st.bytes << " bytes"
+       << " (avg " << st.bytes / std::max<uint64_t>(1, st.records) << "), "
+       << st.invalid << " invalid (" << std::fixed << std::setprecision(1)
+       << 100.0 * mix.corpus.invalidRatio << "% requested)\n";
+    os << "headers " << describe(mix.corpus.headerCounts) << "  depth " << describe(mix.corpus.uriDepths)
+       << "  methods " << describe(mix.corpus.methods) << "\n";
+    if (prefilter) {
+        os << "prefilter: " << prefilter->counter(Counter::PrefilterRejects) << " of "
+           << prefilter->counter(Counter::PrefilterRejects) + prefilter->counter(Counter::PrefilterPasses)
+           << " parsed messages rejected (" << std::setprecision(1) << 100.0 * prefilterHitRate(*prefilter)
+           << "% hit rate)\n";
+    }
+    os << "\n";
+
+    os << std::setw(8) << "threads" << std::setw(14) << "msgs/s" << std::setw(10) << "MB/s"
+       << std::setw(9) << "speedup" << std::setw(8) << "eff%"
+       << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(10) << "p999 us"
+       << std::setw(10) << "max us" << std::setw(10) << "reject%" << "\n";
+
+    const double base = runs.empty() ? 0 : runs.front().messagesPerSecond() / runs.front().threads;
+    for (const auto& r : runs) {
+        const double speedup = base > 0 ? r.messagesPerSecond() / base : 0;
+        auto us = [&](double q) { return (double)r.latency.percentileNanos(q) / 1000.0; };
+        os << std::setw(8) << r.threads
+           << std::setw(14) << std::setprecision(0) << r.messagesPerSecond()
+           << std::setw(10) << std::setprecision(1) << r.megabytesPerSecond()
+           << std::setw(9) << std::setprecision(2) << speedup
+           << std::setw(8) << std::setprecision(0) << 100.0 * speedup / r.threads
+           << std::setprecision(2)
+           << std::setw(10) << us(0.50) << std::setw(10) << us(0.99) << std::setw(10) << us(0.999)
+           << std::setw(10) << (double)r.latency.maxNanos / 1000.0
+           << std::setw(10) << std::setprecision(1)
+           << (r.messages ? 100.0 * (double)r.rejected / (double)r.messages : 0.0) << "\n";
+    }
+}
+
+void printJson(std::ostream& os, const TrafficMix& mix, const Corpus& corpus,
+               const std::vector<RunResult>& runs, uint64_t seed, bool tree, const std::string& engine,
+               const MetricsSnapshot* prefilter) {
+    nlohmann::json j;
+    j["context"] = {
+        {"seed", seed},
+        {"tree", tree},
+        {"engine", engine},
+        {"hardware_threads", std::thread::hardware_concurrency()},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+    };
+    j["corpus"] = {
+        {"messages", corpus.stats.records},
+        {"bytes", corpus.stats.bytes},
+        {"invalid", corpus.stats.invalid},
+        {"invalid_percent", 100.0 * mix.corpus.invalidRatio},
+        {"headers", describe(mix.corpus.headerCounts)},
+        {"depth", describe(mix.corpus.uriDepths)},
+        {"methods", describe(mix.corpus.methods)},
+    };
+    if (prefilter) {
+        j["prefilter"] = {
+            {"rejects", prefilter->counter(Counter::PrefilterRejects)},
+            {"passes", prefilter->counter(Counter::PrefilterPasses)},
+            {"hit_rate", prefilterHitRate(*prefilter)},
+        };
+    }
+    j["runs"] = nlohmann::json::array();
+    for (const auto& r : runs) {
+        j["runs"].push_back({
+            {"threads", r.threads},
+            {"seconds", r.seconds},
+            {"messages", r.messages},
+            {"rejected", r.rejected},
+            {"messages_per_second", r.messagesPerSecond()},
+            {"megabytes_per_second", r.megabytesPerSecond()},
+            {"p50_ns", r.latency.percentileNanos(0.50)},
+            {"p99_ns", r.latency.percentileNanos(0.99)},
+            {"p999_ns", r.latency.percentileNanos(0.999)},
+            {"max_ns", r.latency.maxNanos},
+            {"mean_ns", r.latency.meanNanos()},
+        });
+    }
+    os << j.dump(2) << "\n";
+}
+
+void usage() {
+    std::cerr << "Usage: throughput_bench [--messages N] [--invalid PERCENT]\n"
+                 "                        [--headers COUNT:WEIGHT,...] [--depth SEGMENTS:WEIGHT,...]\n"
+                 "                        [--methods NAME:WEIGHT,...] [--threads 1,2,4,...]\n"
+                 "                        [--seconds S] [--tree] [--seed N] [--engine slr|dfa]\n"
+                 "                        [--prefilter] [--format table|json] [--out FILE]\n"
+                 "       throughput_bench --write FILE [--length-prefixed] [--messages N] [mix options]\n";
+}
+
+bool parseThreads(const std::string& spec, std::vector<unsigned>& out) {
+    out.clear();
+    std::istringstream in(spec);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int n = std::atoi(item.c_str());
+        if (n <= 0) return false;
+        out.push_back((unsigned)n);
+    }
+    return !out.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    TrafficMix mix;
+    std::vector<unsigned> threads;
+    double seconds = 2.0;
+    bool tree = false;
+    uint64_t seed = 20251201;
+    std::string format = "table";
+    std::string outFile;
+    std::string writeFile;
+    std::string engine = "slr";
+    bool prefilter = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+
+        if (arg == "--messages" && hasValue)      mix.messages = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--invalid" && hasValue)  mix.corpus.invalidRatio = std::atof(argv[++i]) / 100.0;
+        else if (arg == "--headers" && hasValue)  ok = parseCounts(argv[++i], mix.corpus.headerCounts);
+        else if (arg == "--depth" && hasValue)    ok = parseCounts(argv[++i], mix.corpus.uriDepths);
+        else if (arg == "--methods" && hasValue)  ok = parseWeighted(argv[++i], mix.corpus.methods);
+        else if (arg == "--threads" && hasValue)  ok = parseThreads(argv[++i], threads);
+        else if (arg == "--seconds" && hasValue)  seconds = std::atof(argv[++i]);
+        else if (arg == "--tree")                 tree = true;
+        else if (arg == "--seed" && hasValue)     seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--engine" && hasValue)   engine = argv[++i];
+        else if (arg == "--prefilter")            prefilter = true;
+        else if (arg == "--format" && hasValue)   format = argv[++i];
+        else if (arg == "--out" && hasValue)      outFile = argv[++i];
+        else if (arg == "--write" && hasValue)    writeFile = argv[++i];
+        else if (arg == "--length-prefixed")      mix.corpus.format = RecordFormat::LengthPrefixed;
+        else ok = false;
+
+        if (!ok) { usage(); return 2; }
+    }
+    if (mix.messages == 0 || seconds <= 0 || (format != "table" && format != "json") ||
+        (engine != "slr" && engine != "dfa")) {
+        usage();
+        return 2;
+    }
+
+    mix.corpus.seed = seed;
+
+    if (!writeFile.empty()) {
+        try {
+            const auto t0 = std::chrono::steady_clock::now();
+            HTTP10CorpusStats st = HTTP10CorpusGenerator(mix.corpus).writeFile(writeFile, mix.messages);
+            const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            std::cerr << st.records << " records (" << st.invalid << " invalid), " << st.bytes
+                      << " bytes in " << s << " s\n";
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // Default scaling ladder: 1, 2, 4, ... up to the hardware thread count
+    if (threads.empty()) {
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 1; t < hw; t *= 2) threads.push_back(t);
+        threads.push_back(hw);
+    }
+
+    CFG grammar("protocols/HTTP10/http10.json");
+    if (grammar.getProductions().empty()) {
+        std::cerr << "Error: cannot load protocols/HTTP10/http10.json (run from the build directory)\n";
+        return 1;
+    }
+    ValidatorOptions options;
+    options.engine = engine == "dfa" ? SyntaxEngine::Dfa : SyntaxEngine::Slr;
+    options.prefilter = prefilter;
+    HTTP10Validator validator(grammar, options);
+    Corpus corpus;
+    try {
+        corpus = buildCorpus(mix);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+
+    // One untimed pass warms the caches and sizes the scratch buffers
+    runAt(1, validator, corpus, std::min(seconds, 0.2), tree);
+
+    std::vector<RunResult> runs;
+    for (unsigned t : threads) {
+        std::cerr << "  " << t << " thread" << (t == 1 ? "" : "s") << "\n";
+        runs.push_back(runAt(t, validator, corpus, seconds, tree));
+    }
+
+    // Metrics stays off while timing; the hit rate comes from one counted pass
+    MetricsSnapshot counted;
+    const bool countPrefilter = validator.prefilterDfa() != nullptr;
+    if (countPrefilter) {
+        Metrics::reset();
+        Metrics::setEnabled(true);
+        ValidatorScratch scratch;
+        for (auto msg : corpus.views) (void)validator.validate(msg, scratch);
+        Metrics::setEnabled(false);
+        counted = Metrics::snapshot();
+    }
+
+    std::ofstream file;
+    if (!outFile.empty()) {
+        file.open(outFile);
+        if (!file) {
+            std::cerr << "Error: cannot write " << outFile << "\n";
+            return 1;
+        }
+    }
+    std::ostream& os = outFile.empty() ? std::cout : file;
+
+    if (format == "json") printJson(os, mix, corpus, runs, seed, tree, engine, countPrefilter ? &counted : nullptr);
+    else                  printTable(os, mix, corpus, runs, countPrefilter ? &counted : nullptr);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "CaptureValidator.h"
+
+#include <chrono>
+
+CaptureValidator::CaptureValidator(const HTTP10Validator& validator, CaptureOptions options)
+    : validator(validator), options(options)
+{
+}
+
+CaptureReport CaptureValidator::run(const std::string& captureFile) const {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    CaptureReport report;
+    PcapReader reader(captureFile);
+    report.captureBytes = reader.fileSize();
+
+    BatchValidator batch(validator, options.batch);
+
+    // Current chunk: request bytes back to back, plus where each one came from
+    std::string arena;
+    std::vector<size_t> offsets;
+    std::vector<uint64_t> flowIds;
+
+    auto flushChunk = [&]() {
+        if (offsets.empty()) return;
+
+        std::vector<std::string_view> views;
+        views.reserve(offsets.size());
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            size_t end = i + 1 < offsets.size() ? offsets[i + 1] : arena.size();
+            views.emplace_back(arena.data() + offsets[i], end - offsets[i]);
+        }
+
+        auto t0 = Clock::now();
+        BatchReport br = batch.run(views);
+        report.validateSeconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        report.validation += br.total;
+
+        for (size_t i = 0; i < br.verdicts.size(); ++i) {
+            FlowVerdicts& fv = report.flows[flowIds[i]];
+            const Verdict& v = br.verdicts[i];
+            if (v.ok()) {
+                fv.accepted++;
+            } else if (fv.firstError == VerdictCode::Ok) {
+                fv.firstError = v.code;
+                fv.firstErrorOffset = v.errorOffset;
+                fv.firstErrorRequest = fv.requests;
+            }
+            fv.requests++;
+        }
+
+        arena.clear();
+        offsets.clear();
+        flowIds.clear();
+    };
+
+    TcpReassembler reassembler(options.reassembly,
+        [&](uint64_t flowId, const FlowKey& flow, std::string_view message) {
+            if (flowId >= report.flows.size()) report.flows.resize(flowId + 1);
+            if (report.flows[flowId].flow.empty()) report.flows[flowId].flow = flow.toString();
+
+            offsets.push_back(arena.size());
+            flowIds.push_back(flowId);
+            arena.append(message.data(), message.size());
+
+            if (offsets.size() >= options.chunkMessages) flushChunk();
+        });
+
+    TcpSegment seg;
+    report.packets = reader.forEachPacket([&](const RawPacket& pkt) {
+        if (!PcapReader::decodeTcp(pkt, seg)) return;
+        report.tcpSegments++;
+        reassembler.add(seg);
+    });
+
+    reassembler.finish();
+    flushChunk();
+
+    report.reassembly = reassembler.stats();
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,65 @@
+//
+// Offline validation of HTTP/1.0 requests found in a pcap/pcapng capture.
+//
+
+#ifndef CAPTURE_CAPTUREVALIDATOR_H
+#define CAPTURE_CAPTUREVALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "TcpReassembler.h"
+#include "../pipeline/BatchValidator.h"
+
+struct CaptureOptions {
+    ReassemblyOptions reassembly;
+    BatchOptions batch;
+    size_t chunkMessages = 64 * 1024;   // validate once this many requests are buffered
+};
+
+struct FlowVerdicts {
+    std::string flow;                   // "client:port -> server:80"
+    uint64_t requests = 0;
+    uint64_t accepted = 0;
+    VerdictCode firstError = VerdictCode::Ok;
+    int32_t firstErrorOffset = -1;
+    uint64_t firstErrorRequest = 0;     // 0-based index within the flow
+};
+
+struct CaptureReport {
+    uint64_t packets = 0;
+    uint64_t captureBytes = 0;
+    uint64_t tcpSegments = 0;           // decoded TCP segments, any port
+    ReassemblyStats reassembly;
+    WorkerCounters validation;
+    std::vector<FlowVerdicts> flows;    // indexed by flow id
+
+    double seconds = 0.0;               // wall time for the whole run
+    double validateSeconds = 0.0;       // part of `seconds` spent in BatchValidator
+
+    [[nodiscard]] double requestsPerSecond() const {
+        return seconds > 0.0 ? (double)validation.messages / seconds : 0.0;
+    }
+    [[nodiscard]] double captureGbitPerSecond() const {
+        return seconds > 0.0 ? (double)captureBytes * 8.0 / seconds / 1e9 : 0.0;
+    }
+};
+
+// Reader -> TCP reassembly -> request framing -> BatchValidator.
+// Requests are copied into a chunk buffer and validated a chunk at a time,
+// so memory stays bounded for captures of any size.
+class CaptureValidator {
+public:
+    CaptureValidator(const HTTP10Validator& validator, CaptureOptions options = {});
+
+    // Throws std::runtime_error if the capture cannot be read
+    [[nodiscard]] CaptureReport run(const std::string& captureFile) const;
+
+private:
+    const HTTP10Validator& validator;
+    CaptureOptions options;
+};
+
+#endif // CAPTURE_CAPTUREVALIDATOR_H
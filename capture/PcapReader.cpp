@@ -0,0 +1,367 @@
+#include "PcapReader.h"
+
+#include <cerrno>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Link types (https://www.tcpdump.org/linktypes.html)
+constexpr uint16_t LINKTYPE_NULL = 0;
+constexpr uint16_t LINKTYPE_ETHERNET = 1;
+constexpr uint16_t LINKTYPE_RAW = 101;
+constexpr uint16_t LINKTYPE_LINUX_SLL = 113;
+constexpr uint16_t LINKTYPE_IPV4 = 228;
+constexpr uint16_t LINKTYPE_IPV6 = 229;
+constexpr uint16_t LINKTYPE_LINUX_SLL2 = 276;
+
+uint16_t be16(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+uint32_t be32(const uint8_t* p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+
+// File-order integer read; `swap` when the writer's byte order differs from ours (LE)
+uint32_t rd32(const uint8_t* p, bool swap) {
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    return swap ? __builtin_bswap32(v) : v;
+}
+uint16_t rd16(const uint8_t* p, bool swap) {
+    uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+    return swap ? __builtin_bswap16(v) : v;
+}
+
+// pcapng if_tsresol: MSB clear = 10^-v seconds, set = 2^-v seconds
+uint64_t toNanos(uint64_t ts, uint8_t tsresol) {
+    if (tsresol & 0x80) {
+        return (uint64_t)((long double)ts * 1e9L / std::ldexp(1.0L, tsresol & 0x7f));
+    }
+    int exp = 9 - (int)tsresol;
+    uint64_t scale = 1;
+    for (int i = 0; i < std::abs(exp); ++i) scale *= 10;
+    return exp >= 0 ? ts * scale : ts / scale;
+}
+
+void setV4Mapped(uint8_t dst[16], const uint8_t* v4) {
+    std::memset(dst, 0, 10);
+    dst[10] = 0xff;
+    dst[11] = 0xff;
+    std::memcpy(dst + 12, v4, 4);
+}
+
+bool decodeTcpHeader(const uint8_t* p, size_t len, TcpSegment& out) {
+    if (len < 20) return false;
+    size_t doff = (size_t)(p[12] >> 4) * 4;
+    if (doff < 20 || doff > len) return false;
+
+    out.flow.srcPort = be16(p);
+    out.flow.dstPort = be16(p + 2);
+    out.seq = be32(p + 4);
+    out.flags = p[13];
+    out.payload = p + doff;
+    out.payloadLen = len - doff;
+    return true;
+}
+
+bool decodeIPv4(const uint8_t* p, size_t len, TcpSegment& out) {
+    if (len < 20 || (p[0] >> 4) != 4) return false;
+    size_t ihl = (size_t)(p[0] & 0x0f) * 4;
+    size_t total = be16(p + 2);
+    if (ihl < 20 || total < ihl) return false;
+    if (total < len) len = total;       // strip Ethernet padding
+    if (len < ihl) return false;
+
+    if (p[9] != 6) return false;                        // not TCP
+    if ((be16(p + 6) & 0x3fff) != 0) return false;      // MF flag or fragment offset
+
+    setV4Mapped(out.flow.src, p + 12);
+    setV4Mapped(out.flow.dst, p + 16);
+    return decodeTcpHeader(p + ihl, len - ihl, out);
+}
+
+bool decodeIPv6(const uint8_t* p, size_t len, TcpSegment& out) {
+    if (len < 40 || (p[0] >> 4) != 6) return false;
+    size_t payload = be16(p + 4);
+    if (40 + payload < len) len = 40 + payload;
+
+    std::memcpy(out.flow.src, p + 8, 16);
+    std::memcpy(out.flow.dst, p + 24, 16);
+
+    uint8_t next = p[6];
+    size_t off = 40;
+    while (true) {
+        if (next == 6) return decodeTcpHeader(p + off, len - off, out);
+        if (off + 8 > len) return false;
+        switch (next) {
+            case 0:  // hop-by-hop
+            case 43: // routing
+            case 60: // destination options
+                next = p[off];
+                off += ((size_t)p[off + 1] + 1) * 8;
+                break;
+            case 51: // authentication header
+                next = p[off];
+                off += ((size_t)p[off + 1] + 2) * 4;
+                break;
+            default: // fragment (44), ESP, no-next-header, ...
+                return false;
+        }
+        if (off > len) return false;
+    }
+}
+
+bool decodeIP(const uint8_t* p, size_t len, TcpSegment& out) {
+    if (len < 1) return false;
+    switch (p[0] >> 4) {
+        case 4:  return decodeIPv4(p, len, out);
+        case 6:  return decodeIPv6(p, len, out);
+        default: return false;
+    }
+}
+
+bool decodeEtherType(uint16_t type, const uint8_t* p, size_t len, TcpSegment& out) {
+    if (type == 0x0800) return decodeIPv4(p, len, out);
+    if (type == 0x86dd) return decodeIPv6(p, len, out);
+    return false;
+}
+
+} // namespace
+
+// ----------------------------------------------------------
+// FlowKey
+// ----------------------------------------------------------
+bool FlowKey::operator==(const FlowKey& o) const {
+    return srcPort == o.srcPort && dstPort == o.dstPort &&
+           std::memcmp(src, o.src, 16) == 0 && std::memcmp(dst, o.dst, 16) == 0;
+}
+
+size_t FlowKeyHash::operator()(const FlowKey& k) const {
+    // FNV-1a over the whole key
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    };
+    mix(k.src, 16);
+    mix(k.dst, 16);
+    mix(reinterpret_cast<const uint8_t*>(&k.srcPort), 2);
+    mix(reinterpret_cast<const uint8_t*>(&k.dstPort), 2);
+    return (size_t)h;
+}
+
+std::string FlowKey::toString() const {
+    auto addr = [](const uint8_t* a) {
+        std::ostringstream ss;
+        static const uint8_t mapped[12] = {0,0,0,0,0,0,0,0,0,0,0xff,0xff};
+        if (std::memcmp(a, mapped, 12) == 0) {
+            ss << (int)a[12] << "." << (int)a[13] << "." << (int)a[14] << "." << (int)a[15];
+        } else {
+            ss << "[" << std::hex;
+            for (int i = 0; i < 16; i += 2) {
+                if (i) ss << ":";
+                ss << ((a[i] << 8) | a[i + 1]);
+            }
+            ss << "]";
+        }
+        return ss.str();
+    };
+    return addr(src) + ":" + std::to_string(srcPort) + " -> " + addr(dst) + ":" + std::to_string(dstPort);
+}
+
+// ----------------------------------------------------------
+// PcapReader
+// ----------------------------------------------------------
+PcapReader::PcapReader(const std::string& filename) {
+#ifdef _WIN32
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+        throw std::runtime_error("Unable to open capture: " + filename);
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    base = fallback.data();
+    size = fallback.size();
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open capture: " + filename + ": " + std::strerror(errno));
+
+    struct stat st{};
+    fstat(fd, &st);
+    size = (size_t)st.st_size;
+
+    if (size > 0) {
+        void* m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("mmap failed for " + filename + ": " + std::strerror(errno));
+        }
+        // One sequential pass: let the kernel read ahead aggressively
+        madvise(m, size, MADV_SEQUENTIAL);
+        base = static_cast<const uint8_t*>(m);
+    }
+    close(fd);
+#endif
+
+    if (size < 4)
+        throw std::runtime_error("Not a capture file: " + filename);
+
+    uint32_t magic = rd32(base, false);
+    pcapng = magic == 0x0A0D0D0A;
+    bool pcap = magic == 0xa1b2c3d4 || magic == 0xd4c3b2a1 ||
+                magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+    if (!pcap && !pcapng)
+        throw std::runtime_error("Not a pcap/pcapng file: " + filename);
+}
+
+PcapReader::~PcapReader() {
+#ifndef _WIN32
+    if (base) munmap(const_cast<uint8_t*>(base), size);
+#endif
+}
+
+size_t PcapReader::forEachPacket(const std::function<void(const RawPacket&)>& visit) const {
+    return pcapng ? forEachPcapNg(visit) : forEachPcap(visit);
+}
+
+size_t PcapReader::forEachPcap(const std::function<void(const RawPacket&)>& visit) const {
+    if (size < 24) return 0;
+
+    uint32_t magic = rd32(base, false);
+    bool swap = magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1;
+    bool nanos = magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+    uint16_t linkType = (uint16_t)(rd32(base + 20, swap) & 0xffff);
+
+    size_t count = 0;
+    size_t off = 24;
+    while (off + 16 <= size) {
+        const uint8_t* h = base + off;
+        uint32_t sec = rd32(h, swap);
+        uint32_t frac = rd32(h + 4, swap);
+        uint32_t capLen = rd32(h + 8, swap);
+        uint32_t origLen = rd32(h + 12, swap);
+        off += 16;
+        if (capLen > size - off) break;     // truncated capture
+
+        RawPacket pkt;
+        pkt.data = base + off;
+        pkt.capLen = capLen;
+        pkt.origLen = origLen;
+        pkt.timestampNs = (uint64_t)sec * 1000000000ull + (nanos ? frac : (uint64_t)frac * 1000ull);
+        pkt.linkType = linkType;
+        visit(pkt);
+
+        off += capLen;
+        count++;
+    }
+    return count;
+}
+
+size_t PcapReader::forEachPcapNg(const std::function<void(const RawPacket&)>& visit) const {
+    struct Interface { uint16_t linkType; uint8_t tsresol; };
+    std::vector<Interface> interfaces;
+    bool swap = false;
+
+    size_t count = 0;
+    size_t off = 0;
+    while (off + 12 <= size) {
+        const uint8_t* b = base + off;
+        uint32_t type = rd32(b, false);
+
+        // Section Header Block: byte order is decided here, interfaces reset
+        if (type == 0x0A0D0D0A) {
+            uint32_t bom = rd32(b + 8, false);
+            swap = bom == 0x4D3C2B1A;
+            interfaces.clear();
+        } else {
+            type = rd32(b, swap);
+        }
+
+        uint32_t len = rd32(b + 4, swap);
+        if (len < 12 || len > size - off) break;
+        const uint8_t* body = b + 8;
+        size_t bodyLen = len - 12;
+
+        if (type == 1 && bodyLen >= 8) {
+            // Interface Description Block
+            Interface itf{ rd16(body, swap), 6 };
+            size_t o = 8;
+            while (o + 4 <= bodyLen) {
+                uint16_t code = rd16(body + o, swap);
+                uint16_t olen = rd16(body + o + 2, swap);
+                if (code == 0) break;
+                if (code == 9 && olen >= 1 && o + 4 < bodyLen) itf.tsresol = body[o + 4];
+                o += 4 + ((olen + 3u) & ~3u);
+            }
+            interfaces.push_back(itf);
+        } else if (type == 6 && bodyLen >= 20) {
+            // Enhanced Packet Block
+            uint32_t ifId = rd32(body, swap);
+            uint64_t ts = ((uint64_t)rd32(body + 4, swap) << 32) | rd32(body + 8, swap);
+            uint32_t capLen = rd32(body + 12, swap);
+            uint32_t origLen = rd32(body + 16, swap);
+
+            if (ifId < interfaces.size() && capLen <= bodyLen - 20) {
+                RawPacket pkt;
+                pkt.data = body + 20;
+                pkt.capLen = capLen;
+                pkt.origLen = origLen;
+                pkt.timestampNs = toNanos(ts, interfaces[ifId].tsresol);
+                pkt.linkType = interfaces[ifId].linkType;
+                visit(pkt);
+                count++;
+            }
+        } else if (type == 3 && bodyLen >= 4 && !interfaces.empty()) {
+            // Simple Packet Block: interface 0, no timestamp
+            uint32_t origLen = rd32(body, swap);
+            RawPacket pkt;
+            pkt.data = body + 4;
+            pkt.capLen = std::min<uint32_t>(origLen, (uint32_t)(bodyLen - 4));
+            pkt.origLen = origLen;
+            pkt.linkType = interfaces[0].linkType;
+            visit(pkt);
+            count++;
+        }
+
+        off += len;
+    }
+    return count;
+}
+
+bool PcapReader::decodeTcp(const RawPacket& packet, TcpSegment& out) {
+    const uint8_t* p = packet.data;
+    size_t len = packet.capLen;
+    out.timestampNs = packet.timestampNs;
+
+    switch (packet.linkType) {
+        case LINKTYPE_ETHERNET: {
+            if (len < 14) return false;
+            size_t off = 12;
+            uint16_t type = be16(p + off);
+            while ((type == 0x8100 || type == 0x88a8) && off + 6 <= len) {   // VLAN tags
+                off += 4;
+                type = be16(p + off);
+            }
+            off += 2;
+            return off <= len && decodeEtherType(type, p + off, len - off, out);
+        }
+        case LINKTYPE_LINUX_SLL:
+            return len >= 16 && decodeEtherType(be16(p + 14), p + 16, len - 16, out);
+        case LINKTYPE_LINUX_SLL2:
+            return len >= 20 && decodeEtherType(be16(p), p + 20, len - 20, out);
+        case LINKTYPE_NULL:
+            return len >= 4 && decodeIP(p + 4, len - 4, out);
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+            return decodeIP(p, len, out);
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Memory-mapped pcap / pcapng reader and Ethernet/IP/TCP decoding.
+// No libpcap: the file is mapped and walked in place.
+//
+
+#ifndef CAPTURE_PCAPREADER_H
+#define CAPTURE_PCAPREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// One captured frame, pointing into the mapped file
+struct RawPacket {
+    const uint8_t* data = nullptr;
+    uint32_t capLen = 0;
+    uint32_t origLen = 0;
+    uint64_t timestampNs = 0;
+    uint16_t linkType = 0;      // LINKTYPE_* value
+};
+
+// IPv4 addresses are stored as v4-mapped IPv6 so both share one key type
+struct FlowKey {
+    uint8_t src[16];
+    uint8_t dst[16];
+    uint16_t srcPort;
+    uint16_t dstPort;
+
+    bool operator==(const FlowKey& o) const;
+    [[nodiscard]] std::string toString() const;
+};
+
+struct FlowKeyHash {
+    size_t operator()(const FlowKey& k) const;
+};
+
+struct TcpSegment {
+    FlowKey flow{};
+    uint32_t seq = 0;
+    uint8_t flags = 0;
+    const uint8_t* payload = nullptr;
+    size_t payloadLen = 0;
+    uint64_t timestampNs = 0;
+
+    static constexpr uint8_t FIN = 0x01;
+    static constexpr uint8_t SYN = 0x02;
+    static constexpr uint8_t RST = 0x04;
+};
+
+class PcapReader {
+public:
+    // Throws std::runtime_error if the file cannot be opened or is not pcap/pcapng
+    explicit PcapReader(const std::string& filename);
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+
+    // Calls `visit` for every packet in file order. Returns the packet count.
+    size_t forEachPacket(const std::function<void(const RawPacket&)>& visit) const;
+
+    [[nodiscard]] size_t fileSize() const { return size; }
+    [[nodiscard]] bool isPcapNg() const { return pcapng; }
+
+    // Link layer + IPv4/IPv6 + TCP. false for anything that is not a
+    // complete, unfragmented TCP segment.
+    static bool decodeTcp(const RawPacket& packet, TcpSegment& out);
+
+private:
+    size_t forEachPcap(const std::function<void(const RawPacket&)>& visit) const;
+    size_t forEachPcapNg(const std::function<void(const RawPacket&)>& visit) const;
+
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    bool pcapng = false;
+#ifdef _WIN32
+    std::vector<uint8_t> fallback;  // no mmap: file read into memory
+#endif
+};
+
+#endif // CAPTURE_PCAPREADER_H
@@ -0,0 +1,215 @@
+#include "TcpReassembler.h"
+
+#include <algorithm>
+
+namespace {
+
+// Signed distance a - b in sequence space (handles 2^32 wrap-around)
+int32_t seqDiff(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b);
+}
+
+} // namespace
+
+TcpReassembler::TcpReassembler(ReassemblyOptions options, MessageSink sink)
+    : options(options), sink(std::move(sink))
+{
+}
+
+void TcpReassembler::add(const TcpSegment& seg) {
+    if (seg.flow.dstPort != options.serverPort) return;
+
+    counters.segments++;
+    counters.payloadBytes += seg.payloadLen;
+
+    auto it = flows.find(seg.flow);
+    if (seg.flags & TcpSegment::SYN) {
+        // New connection (or reuse of the 4-tuple): start fresh after the SYN
+        if (it != flows.end()) {
+            close(it->second, it->first);
+            flows.erase(it);
+        }
+
+        Flow f;
+        f.id = nextFlowId++;
+        f.nextSeq = seg.seq + 1;
+        it = flows.emplace(seg.flow, std::move(f)).first;
+        counters.flows++;
+    } else if (it == flows.end()) {
+        if (seg.payloadLen == 0) return;
+        // Capture started mid-connection: trust the first data we see
+        Flow f;
+        f.id = nextFlowId++;
+        f.nextSeq = seg.seq;
+        it = flows.emplace(seg.flow, std::move(f)).first;
+        counters.flows++;
+    }
+
+    Flow& flow = it->second;
+    const FlowKey& key = it->first;
+
+    if (seg.payloadLen > 0) {
+        int32_t d = seqDiff(seg.seq, flow.nextSeq);
+
+        if (d <= 0) {
+            // In order, or overlapping data we already have: keep only the new tail
+            size_t already = (size_t)(-(int64_t)d);
+            if (already >= seg.payloadLen) {
+                counters.retransmittedBytes += seg.payloadLen;
+            } else {
+                counters.retransmittedBytes += already;
+                deliver(flow, key, seg.payload + already, seg.payloadLen - already);
+                drainPending(flow, key);
+            }
+        } else if (flow.pending.size() < options.maxPendingSegments &&
+                   flow.buffer.size() + flow.pendingBytes + seg.payloadLen <= options.maxFlowBuffer) {
+            // Ahead of the stream: hold until the hole is filled
+            flow.pending.push_back({seg.seq, std::string((const char*)seg.payload, seg.payloadLen)});
+            flow.pendingBytes += seg.payloadLen;
+        } else {
+            // No room to wait: accept the loss, resynchronise on this segment
+            counters.gaps++;
+            flow.buffer.clear();
+            flow.scanned = 0;
+            flow.pending.clear();
+            flow.pendingBytes = 0;
+            flow.skipping = true;
+            flow.bodyRemaining = 0;
+            flow.nextSeq = seg.seq;
+            deliver(flow, key, seg.payload, seg.payloadLen);
+        }
+    }
+
+    if (seg.flags & (TcpSegment::FIN | TcpSegment::RST)) {
+        close(flow, key);
+        flows.erase(seg.flow);
+    }
+}
+
+void TcpReassembler::deliver(Flow& flow, const FlowKey& key, const uint8_t* data, size_t len) {
+    flow.nextSeq += (uint32_t)len;
+
+    if (flow.bodyRemaining > 0) {
+        size_t skip = (size_t)std::min<uint64_t>(flow.bodyRemaining, len);
+        flow.bodyRemaining -= skip;
+        counters.bodyBytes += skip;
+        data += skip;
+        len -= skip;
+        if (len == 0) return;
+    }
+
+    flow.buffer.append((const char*)data, len);
+    extract(flow, key);
+}
+
+void TcpReassembler::drainPending(Flow& flow, const FlowKey& key) {
+    bool progress = true;
+    while (progress && !flow.pending.empty()) {
+        progress = false;
+        for (size_t i = 0; i < flow.pending.size(); ++i) {
+            Pending& p = flow.pending[i];
+            int32_t d = seqDiff(p.seq, flow.nextSeq);
+            if (d > 0) continue;
+
+            size_t already = (size_t)(-(int64_t)d);
+            std::string data = std::move(p.data);
+            flow.pendingBytes -= data.size();
+            flow.pending.erase(flow.pending.begin() + (std::ptrdiff_t)i);
+
+            if (already < data.size())
+                deliver(flow, key, (const uint8_t*)data.data() + already, data.size() - already);
+            else
+                counters.retransmittedBytes += data.size();
+            progress = true;
+            break;
+        }
+    }
+}
+
+void TcpReassembler::extract(Flow& flow, const FlowKey& key) {
+    std::string& buf = flow.buffer;
+    std::string_view view(buf);
+    size_t start = 0;
+
+    while (true) {
+        // Keep-alive clients may send empty lines between requests
+        while (start < view.size()) {
+            if (view[start] == '\n') start += 1;
+            else if (view[start] == '\r' && start + 1 < view.size() && view[start + 1] == '\n') start += 2;
+            else break;
+        }
+
+        FramedMessage m;
+        FrameStatus status = HTTP10Framer::frame(view.substr(start), m, options.framing,
+                                                 start == 0 ? flow.scanned : 0);
+        if (status == FrameStatus::Incomplete) {
+            if (m.head.empty()) break;
+
+            // Head complete, body still arriving: validate now, skip the
+            // body as it comes in (deliver) instead of buffering it
+            if (flow.skipping) {
+                flow.skipping = false;
+            } else {
+                counters.messages++;
+                sink(flow.id, key, m.head);
+            }
+            size_t available = view.size() - start - m.head.size();
+            counters.bodyBytes += available;
+            flow.bodyRemaining = m.contentLength - available;
+            start = view.size();
+            break;
+        }
+
+        if (status != FrameStatus::Complete) {
+            // The body length is unknown: validate what we have, then resynchronise
+            counters.framingErrors++;
+            if (!m.head.empty() && !flow.skipping) {
+                counters.messages++;
+                sink(flow.id, key, m.head);
+            }
+            start = view.size();
+            flow.skipping = true;
+            break;
+        }
+
+        if (flow.skipping) {
+            flow.skipping = false;      // tail of a request we lost the start of
+        } else {
+            counters.messages++;
+            sink(flow.id, key, m.head);
+        }
+        counters.bodyBytes += m.body.size();
+        start += m.size();
+    }
+
+    if (start > 0) buf.erase(0, start);
+    // The last byte or two may start a terminator the next segment ends
+    flow.scanned = buf.size() >= 2 ? buf.size() - 2 : 0;
+
+    if (buf.size() > options.maxFlowBuffer) {
+        counters.overflows++;
+        buf.clear();
+        flow.scanned = 0;
+        flow.skipping = true;
+    }
+}
+
+void TcpReassembler::close(Flow& flow, const FlowKey& key) {
+    if (flow.bodyRemaining > 0) {
+        // Closed mid-body: the head was already validated
+        counters.incomplete++;
+        flow.bodyRemaining = 0;
+    } else if (!flow.buffer.empty() && !flow.skipping) {
+        // A request cut off by the close is still a (malformed) request
+        counters.incomplete++;
+        counters.messages++;
+        sink(flow.id, key, std::string_view(flow.buffer));
+    }
+    flow.buffer.clear();
+}
+
+void TcpReassembler::finish() {
+    for (auto& [key, flow] : flows)
+        close(flow, key);
+    flows.clear();
+}
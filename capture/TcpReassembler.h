@@ -0,0 +1,87 @@
+//
+// Client->server TCP stream reassembly with a hard per-flow memory bound.
+//
+
+#ifndef CAPTURE_TCPREASSEMBLER_H
+#define CAPTURE_TCPREASSEMBLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "PcapReader.h"
+#include "../pipeline/HTTP10Framer.h"
+
+struct ReassemblyOptions {
+    uint16_t serverPort = 80;           // only segments sent TO this port are kept
+    size_t maxFlowBuffer = 64 * 1024;   // bytes buffered per flow (in-order + out-of-order)
+    size_t maxPendingSegments = 64;     // out-of-order segments held per flow
+    FramerLimits framing;
+};
+
+struct ReassemblyStats {
+    uint64_t segments = 0;              // segments towards serverPort
+    uint64_t payloadBytes = 0;
+    uint64_t flows = 0;
+    uint64_t messages = 0;
+    uint64_t retransmittedBytes = 0;    // already-delivered bytes seen again
+    uint64_t gaps = 0;                  // lost data: stream resynchronised
+    uint64_t overflows = 0;             // a request outgrew maxFlowBuffer
+    uint64_t incomplete = 0;            // flow closed in the middle of a request
+    uint64_t framingErrors = 0;         // unusable Content-Length etc.: stream resynchronised
+    uint64_t bodyBytes = 0;             // request bodies, counted and dropped
+};
+
+// Rebuilds each client byte stream and cuts it into requests with
+// HTTP10Framer (blank line, then a Content-Length body). The head of every
+// request (or the trailing partial request when the flow closes) is handed
+// to the sink; the view is only valid during the call. Bodies are never
+// buffered: once a head is out, the rest of its body is skipped as it
+// arrives, so a flow costs at most maxFlowBuffer whatever it uploads.
+class TcpReassembler {
+public:
+    using MessageSink = std::function<void(uint64_t flowId, const FlowKey& flow, std::string_view message)>;
+
+    TcpReassembler(ReassemblyOptions options, MessageSink sink);
+
+    void add(const TcpSegment& segment);
+
+    // Close every open flow (end of capture)
+    void finish();
+
+    [[nodiscard]] const ReassemblyStats& stats() const { return counters; }
+
+private:
+    struct Pending {
+        uint32_t seq;
+        std::string data;
+    };
+
+    struct Flow {
+        uint64_t id = 0;
+        uint32_t nextSeq = 0;
+        std::string buffer;
+        size_t scanned = 0;             // bytes of buffer already searched for a terminator
+        bool skipping = false;          // after a gap/overflow: drop until the next terminator
+        uint64_t bodyRemaining = 0;     // body bytes still to skip before the next request
+        std::vector<Pending> pending;
+        size_t pendingBytes = 0;
+    };
+
+    void deliver(Flow& flow, const FlowKey& key, const uint8_t* data, size_t len);
+    void drainPending(Flow& flow, const FlowKey& key);
+    void extract(Flow& flow, const FlowKey& key);
+    void close(Flow& flow, const FlowKey& key);
+
+    ReassemblyOptions options;
+    MessageSink sink;
+    uint64_t nextFlowId = 0;
+    std::unordered_map<FlowKey, Flow, FlowKeyHash> flows;
+    ReassemblyStats counters;
+};
+
+#endif // CAPTURE_TCPREASSEMBLER_H
@@ -0,0 +1,139 @@
+//
+// pcap_validate: validate every HTTP/1.0 request in a pcap/pcapng capture.
+//
+//   pcap_validate CAPTURE [--port N] [--workers N] [--max-flow-buffer BYTES] [--cache-mb N] [--flows]
+//                 [--metrics FILE] [--trace FILE]
+//
+// --metrics records per-stage latency histograms and writes them to FILE
+// (Prometheus text if FILE ends in .prom, JSON otherwise).
+// --trace records a per-thread timeline of every stage and writes it as
+// Chrome trace_event JSON (open in Perfetto).
+//
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "CaptureValidator.h"
+#include "Metrics.h"
+#include "Trace.h"
+
+static void usage() {
+    std::cerr << "Usage: pcap_validate CAPTURE [--port N] [--workers N] "
+                 "[--max-flow-buffer BYTES] [--cache-mb N] [--flows] [--grammar FILE] "
+                 "[--metrics FILE] [--trace FILE]\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 2; }
+
+    std::string capture = argv[1];
+    std::string grammar = "protocols/HTTP10/http10.json";
+    CaptureOptions options;
+    bool listFlows = false;
+    size_t cacheMegabytes = 0;
+    std::string metricsFile;
+    std::string traceFile;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--port" && hasValue)                 options.reassembly.serverPort = (uint16_t)std::atoi(argv[++i]);
+        else if (arg == "--workers" && hasValue)         options.batch.workers = (unsigned)std::atoi(argv[++i]);
+        else if (arg == "--max-flow-buffer" && hasValue) options.reassembly.maxFlowBuffer = (size_t)std::atoll(argv[++i]);
+        else if (arg == "--cache-mb" && hasValue)        cacheMegabytes = (size_t)std::atol(argv[++i]);
+        else if (arg == "--grammar" && hasValue)         grammar = argv[++i];
+        else if (arg == "--metrics" && hasValue)         metricsFile = argv[++i];
+        else if (arg == "--trace" && hasValue)           traceFile = argv[++i];
+        else if (arg == "--flows")                       listFlows = true;
+        else { usage(); return 2; }
+    }
+
+    Metrics::setEnabled(!metricsFile.empty());
+    if (!traceFile.empty()) Trace::start();
+    HTTP10Validator validator(grammar);
+
+    // Captures are dominated by repeats of a few requests
+    std::unique_ptr<VerdictCache> cache;
+    if (cacheMegabytes > 0) {
+        CacheOptions co;
+        co.maxBytes = cacheMegabytes << 20;
+        cache = std::make_unique<VerdictCache>(co);
+        options.batch.cache = cache.get();
+    }
+
+    CaptureValidator runner(validator, options);
+
+    CaptureReport r;
+    try {
+        r = runner.run(capture);
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << "\n";
+        return 1;
+    }
+    Trace::stop();
+
+    if (listFlows) {
+        std::cout << "--- Per-flow verdicts ---\n";
+        for (const auto& f : r.flows) {
+            if (f.requests == 0) continue;
+            std::cout << f.flow << "  requests=" << f.requests << " accepted=" << f.accepted;
+            if (f.firstError != VerdictCode::Ok) {
+                std::cout << "  first error: " << verdictCodeName(f.firstError)
+                          << " (request " << f.firstErrorRequest
+                          << ", offset " << f.firstErrorOffset << ")";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "\n";
+    }
+
+    const auto& ra = r.reassembly;
+    const auto& v = r.validation;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Packets:      " << r.packets << " (" << r.tcpSegments << " TCP, "
+              << ra.segments << " to port " << options.reassembly.serverPort << ")\n";
+    std::cout << "Flows:        " << ra.flows << " (gaps " << ra.gaps << ", overflows " << ra.overflows
+              << ", incomplete " << ra.incomplete << ", framing errors " << ra.framingErrors << ")\n";
+    std::cout << "Requests:     " << v.messages << " (" << v.accepted << " accepted, "
+              << v.syntaxErrors << " syntax errors, " << v.semanticErrors << " semantic errors)\n";
+    std::cout << "Bodies:       " << ra.bodyBytes << " bytes skipped\n";
+    std::cout << "Time:         " << r.seconds << " s (" << r.validateSeconds << " s validating)\n";
+    std::cout << "Throughput:   " << std::setprecision(0) << r.requestsPerSecond() << " requests/s, "
+              << std::setprecision(2) << r.captureGbitPerSecond() << " Gbit/s of capture\n";
+    if (cache) {
+        CacheStats cs = cache->stats();
+        std::cout << "Cache:        " << cs.hits << " hits, " << cs.misses << " misses ("
+                  << std::setprecision(1) << cs.hitRate() * 100.0 << "%), " << cs.entries << " entries\n";
+    }
+
+    if (!metricsFile.empty()) {
+        auto errorName = [](size_t code) -> const char* {
+            return code < (size_t)VerdictCode::Count ? verdictCodeName((VerdictCode)code) : nullptr;
+        };
+        MetricsSnapshot m = Metrics::snapshot();
+        bool prom = metricsFile.ends_with(".prom");
+
+        std::ofstream out(metricsFile);
+        out << (prom ? m.toPrometheus(errorName) : m.toJson(errorName));
+        if (!out) {
+            std::cerr << "Error: cannot write " << metricsFile << "\n";
+            return 1;
+        }
+    }
+
+    if (!traceFile.empty()) {
+        TraceStats ts = Trace::stats();
+        if (!Trace::writeChromeJson(traceFile)) {
+            std::cerr << "Error: cannot write " << traceFile << "\n";
+            return 1;
+        }
+        std::cout << "Trace:        " << ts.recorded << " events from " << ts.threads << " threads ("
+                  << ts.dropped << " overwritten) -> " << traceFile << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+//
+// Stand-in main for the fuzz targets on toolchains without libFuzzer.
+//
+//   fuzz_TARGET [--runs N] [--seed S] [--max-len BYTES] [--write-dict FILE] [FILE|DIR ...]
+//
+// Every FILE (and every regular file in DIR) is run through the target
+// once, e.g. a libFuzzer corpus or a crash reproducer. --runs adds N
+// random inputs, spliced from grammar lexemes and random bytes, so a gcc
+// build can still smoke-test the target. --write-dict writes the libFuzzer
+// dictionary (-dict=FILE) and exits.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "FuzzTargets.h"
+#include "../protocols/HTTP10/HTTP10Protocol.h"
+#include "../utils/Xoshiro.h"
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv);
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static void usage() {
+    std::cerr << "Usage: fuzz_TARGET [--runs N] [--seed S] [--max-len BYTES] [--write-dict FILE] [FILE|DIR ...]\n";
+}
+
+static bool runFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot read " << path.string() << "\n";
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t runs = 0;
+    uint64_t seed = 1;
+    size_t maxLen = 512;
+    std::string dictFile;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--runs" && hasValue)            runs = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue)       seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-len" && hasValue)    maxLen = (size_t)std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--write-dict" && hasValue) dictFile = argv[++i];
+        else if (!arg.empty() && arg[0] == '-')     { usage(); return 2; }
+        else                                        inputs.push_back(arg);
+    }
+
+    if (!dictFile.empty()) {
+        std::ofstream out(dictFile, std::ios::binary);
+        out << fuzzDictionary();
+        if (!out) {
+            std::cerr << "Cannot write " << dictFile << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    try {
+        LLVMFuzzerInitialize(&argc, &argv);
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << "\n";
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t executed = 0;
+
+    for (const std::string& input : inputs) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(input, ec)) {
+            for (const auto& entry : std::filesystem::directory_iterator(input, ec)) {
+                if (!entry.is_regular_file()) continue;
+                executed += runFile(entry.path());
+            }
+        } else {
+            if (!runFile(input)) return 1;
+            executed++;
+        }
+    }
+
+    std::vector<std::string> pieces;
+    for (const auto& [terminal, forms] : HTTP10Protocol::terminalLexemes())
+        pieces.insert(pieces.end(), forms.begin(), forms.end());
+
+    Xoshiro256 rng(seed);
+    std::string data;
+    for (uint64_t r = 0; r < runs; ++r) {
+        data.clear();
+        const size_t target = (size_t)rng.below(maxLen + 1);
+        while (data.size() < target) {
+            if (rng.chance(0.9)) data += pieces[rng.below(pieces.size())];
+            else data += (char)rng.below(256);
+        }
+        data.resize(target);
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        executed++;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Executed " << executed << " inputs in " << seconds << " s ("
+              << (seconds > 0 ? (double)executed / seconds : 0.0) << " exec/s)\n";
+    return 0;
+}
@@ -0,0 +1,203 @@
+#include "FuzzTargets.h"
+
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#include "../grammers/CFG.h"
+#include "../parsers/EarleyRecognizer.h"
+#include "../parsers/SLR.h"
+#include "../pipeline/HTTP10Validator.h"
+#include "../protocols/HTTP10/HTTP10Protocol.h"
+#include "../protocols/HTTP10/HTTP10_semantics.h"
+#include "../protocols/HTTP10/HTTPrequest.h"
+#include "../utils/Log.h"
+
+// Absolute path baked in by CMake so the fuzzers run from any directory
+#ifndef PV_FUZZ_GRAMMAR
+#define PV_FUZZ_GRAMMAR "protocols/HTTP10/http10.json"
+#endif
+
+namespace {
+
+// explain() re-tokenizes and builds strings; past this size it would
+// dominate exec/sec without reaching new code
+constexpr size_t kExplainLimit = 4096;
+
+const std::string kUnknownTerminal = "<UNKNOWN>";
+
+struct Shared {
+    CFG grammar{std::string(PV_FUZZ_GRAMMAR)};
+    HTTP10Validator validator{grammar};
+    EarleyRecognizer earley{grammar};
+    std::vector<int> earleyId;      // SLR terminal id -> Earley terminal id
+
+    Shared() {
+        const SLR& slr = validator.parser();
+        for (int t = 0; t < slr.eosId(); ++t)
+            earleyId.push_back(earley.terminalId(slr.terminalName(t)));
+    }
+};
+
+Shared& shared() {
+    static Shared s;
+    return s;
+}
+
+// Fuzzers are single-threaded; the buffers live as long as the process so
+// steady-state inputs do not allocate
+struct Buffers {
+    ValidatorScratch scratch;
+    std::vector<FramedMessage> frames;
+    std::vector<Verdict> verdicts;
+    std::vector<std::string> names;
+    std::vector<int> terminals;
+    std::vector<int> earley;
+    EarleyScratch earleyScratch;
+};
+
+Buffers& buffers() {
+    static Buffers b;
+    return b;
+}
+
+// The map-driven parser writes lastDiagnostic / lastErrorIndex, so it
+// gets its own copy of the shared tables
+SLR& legacyParser() {
+    static SLR slr = shared().validator.parser();
+    return slr;
+}
+
+void tokenNames(const HTTP10Validator& v, const std::vector<Token>& tokens, std::vector<std::string>& names) {
+    names.clear();
+    for (const Token& t : tokens) {
+        if (t.base == BaseToken::END_OF_INPUT) continue;
+        const int id = v.terminalFor(t);
+        names.push_back(id >= 0 ? v.parser().terminalName(id) : kUnknownTerminal);
+    }
+}
+
+void escape(std::string& out, std::string_view bytes) {
+    static const char* hex = "0123456789ABCDEF";
+    for (unsigned char c : bytes) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += (char)c;
+        } else if (c < 0x20 || c >= 0x7F) {
+            out += "\\x";
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+        } else {
+            out += (char)c;
+        }
+    }
+}
+
+} // namespace
+
+void fuzzInitialize() {
+    Log::setLevel(LogLevel::Off);
+    shared();
+    legacyParser();
+}
+
+// ---------------------------------------------------------------------------
+// Targets
+// ---------------------------------------------------------------------------
+
+void fuzzPipeline(const uint8_t* data, size_t size) {
+    const HTTP10Validator& validator = shared().validator;
+    Buffers& b = buffers();
+    const std::string_view message(reinterpret_cast<const char*>(data), size);
+
+    const Verdict v = validator.validate(message, b.scratch);
+    if (!v.ok() && size <= kExplainLimit) {
+        const Diagnosis d = validator.explain(message);
+        if (d.verdict.code != v.code) std::abort();
+        (void)d.format();
+    }
+
+    b.frames.clear();
+    b.verdicts.clear();
+    const size_t consumed = validator.validateStream(message, b.scratch, b.frames, b.verdicts);
+    if (consumed > size || b.frames.size() != b.verdicts.size()) std::abort();
+}
+
+void fuzzParser(const uint8_t* data, size_t size) {
+    const HTTP10Validator& validator = shared().validator;
+    Buffers& b = buffers();
+    const std::string_view message(reinterpret_cast<const char*>(data), size);
+
+    Verdict v;
+    if (!validator.tokenizeStage(message, b.scratch.tokenizer, b.scratch.tokens, b.scratch.terminals, v))
+        return;
+
+    tokenNames(validator, b.scratch.tokens, b.names);
+    SLR& slr = legacyParser();
+    const bool parsed = slr.parse(b.names);
+    if (parsed != validator.parser().accepts(b.scratch.terminals, b.scratch.stack)) std::abort();
+    if (!parsed && (slr.lastErrorIndex < 0 || slr.lastErrorIndex > (int)b.names.size())) std::abort();
+
+    HTTPRequest req;
+    std::string error;
+    if (!HTTPRequest::tryFromTokens(b.scratch.tokens, req, error)) return;
+
+    (void)HTTP10_semantics::validateRequest(req);
+    uint64_t length = 0;
+    bool present = false;
+    (void)HTTP10_semantics::contentLength(req, length, present);
+}
+
+bool fuzzCrossCheck(const uint8_t* data, size_t size, std::string* report) {
+    if (size == 0) return true;
+    Shared& s = shared();
+    Buffers& b = buffers();
+    const SLR& slr = s.validator.parser();
+
+    b.terminals.clear();
+    const bool terminalMode = data[0] & 1;
+    if (terminalMode) {
+        for (size_t i = 1; i < size; ++i) b.terminals.push_back(data[i] % slr.eosId());
+    } else {
+        Verdict v;
+        const std::string_view message(reinterpret_cast<const char*>(data + 1), size - 1);
+        if (!s.validator.tokenizeStage(message, b.scratch.tokenizer, b.scratch.tokens, b.terminals, v))
+            return true;
+    }
+
+    b.earley.clear();
+    for (int t : b.terminals) b.earley.push_back(t >= 0 ? s.earleyId[t] : -1);
+
+    const bool slrAccepts = slr.accepts(b.terminals, b.scratch.stack);
+    const bool earleyAccepts = s.earley.accepts(b.earley, b.earleyScratch);
+    if (slrAccepts == earleyAccepts) return true;
+
+    if (report) {
+        *report = std::string(terminalMode ? "terminals:" : "message:");
+        for (int t : b.terminals) *report += " " + (t >= 0 ? slr.terminalName(t) : kUnknownTerminal);
+        *report += std::string("\nSLR ") + (slrAccepts ? "accepts" : "rejects") +
+                   ", Earley " + (earleyAccepts ? "accepts" : "rejects");
+    }
+    return false;
+}
+
+std::string fuzzDictionary() {
+    std::string out = "# HTTP/1.0 grammar terminals (generated by fuzzDictionary())\n";
+    for (const auto& [terminal, forms] : HTTP10Protocol::terminalLexemes()) {
+        out += "# " + terminal + "\n";
+        for (const std::string& form : forms) {
+            out += '"';
+            escape(out, form);
+            out += "\"\n";
+        }
+    }
+
+    // Not terminals, but the strings semantics and framing branch on
+    out += "# semantics\n";
+    for (const char* extra : {"Content-Length", "\r\n\r\n", "HTTP/"}) {
+        out += '"';
+        escape(out, extra);
+        out += "\"\n";
+    }
+    return out;
+}
@@ -0,0 +1,36 @@
+//
+// In-process fuzz targets. Each fuzz_*.cpp wraps one of these in
+// LLVMFuzzerTestOneInput; FuzzReplayMain.cpp drives the same entry points
+// from files where libFuzzer is not available. The grammar is loaded and
+// the SLR tables are compiled once per process and shared by every input.
+//
+
+#ifndef FUZZ_FUZZTARGETS_H
+#define FUZZ_FUZZTARGETS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Silences logging and builds the shared parser; safe to call repeatedly
+void fuzzInitialize();
+
+// Bytes as one message: validate(), explain() on rejects (both must agree
+// on the verdict) and validateStream() over the same bytes
+void fuzzPipeline(const uint8_t* data, size_t size);
+
+// Bytes through the tokenizer, the map-driven SLR::parse() (must agree
+// with the compiled tables) and the non-throwing HTTPRequest builder
+void fuzzParser(const uint8_t* data, size_t size);
+
+// SLR and an Earley recognizer over the same grammar must agree on
+// acceptance. The first byte picks the input form: even = the rest is a
+// message to tokenize, odd = every further byte is a terminal id (mod the
+// terminal count), which reaches deep grammar states text rarely does.
+// Returns false on disagreement, described in `report` when given.
+bool fuzzCrossCheck(const uint8_t* data, size_t size, std::string* report = nullptr);
+
+// libFuzzer dictionary (-dict=) seeded from the grammar terminals' lexemes
+std::string fuzzDictionary();
+
+#endif // FUZZ_FUZZTARGETS_H
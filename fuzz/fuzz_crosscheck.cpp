@@ -0,0 +1,20 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "FuzzTargets.h"
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    fuzzInitialize();
+    return 0;
+}
+
+// A disagreement is the only thing this target prints: the terminal
+// sequence and both answers, right before the crash libFuzzer reports
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::string report;
+    if (!fuzzCrossCheck(data, size, &report)) {
+        std::fprintf(stderr, "%s\n", report.c_str());
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,11 @@
+#include "FuzzTargets.h"
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    fuzzInitialize();
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    fuzzPipeline(data, size);
+    return 0;
+}
@@ -4,8 +4,12 @@
 
 #include "CFG.h"
 
+#include <sstream>
 #include <utility>
 
+#include "../utils/Log.h"
+#include "../utils/Metrics.h"
+
 
 DiagnosticInfo buildDiagnostic(
         const std::vector<std::string>& expected,
@@ -25,9 +29,10 @@ void production::print() const {
 }
 
 CFG::CFG(std::string jsonFile) : filename(std::move(jsonFile)) {
+    ScopedTimer timer(Stage::GrammarLoad);
     std::ifstream input(filename);
     if (!input.is_open()) {
-        std::cerr << "Error: Unable to open file." << std::endl;
+        LOG_ERROR("CFG") << "Unable to open file: " << filename;
         return;
     }
 
@@ -78,7 +83,7 @@ void CFG::readJsonObject(json &jsonObj) {
 
 DiagnosticInfo CFG::buildDiagnostic(
         const std::vector<std::string>& expected,
-        const std::string& got)
+        const std::string& got) const
 {
     DiagnosticInfo d;
     d.title = "Syntax Error";
@@ -539,12 +544,15 @@ json CFG::buildLL1Table() {
         for (const auto& terminal : firstAlpha) {
             if (table[A].count(terminal)) {
                 // CONFLICT DETECTED!
-                std::cerr << "WARNING: LL(1) conflict detected for [" << A << ", " << terminal << "]" << std::endl;
-                std::cerr << "  Existing: " << A << " -> ";
-                for (const auto& s : table[A][terminal]) std::cerr << s << " ";
-                std::cerr << std::endl << "  New:      " << A << " -> ";
-                for (const auto& s : alpha) std::cerr << s << " ";
-                std::cerr << std::endl;
+                if (Log::enabled(LogLevel::Warn)) {
+                    std::ostringstream out;
+                    out << "LL(1) conflict detected for [" << A << ", " << terminal << "]\n";
+                    out << "  Existing: " << A << " ->";
+                    for (const auto& s : table[A][terminal]) out << " " << s;
+                    out << "\n  New:      " << A << " ->";
+                    for (const auto& s : alpha) out << " " << s;
+                    Log::write(LogLevel::Warn, "CFG", out.str());
+                }
             } else {
                 table[A][terminal] = alpha;
             }
@@ -566,7 +574,7 @@ json CFG::buildLL1Table() {
                         }
                     }
                     if (isDifferent) {
-                        std::cerr << "WARNING: LL(1) conflict detected for [" << A << ", " << terminal << "]" << std::endl;
+                        LOG_WARN("CFG") << "LL(1) conflict detected for [" << A << ", " << terminal << "]";
                     }
                 } else {
                     table[A][terminal] = alpha.empty() ? std::vector<std::string>{""} : alpha;
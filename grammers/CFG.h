@@ -73,7 +73,7 @@ public:
 
     DiagnosticInfo buildDiagnostic(
         const std::vector<std::string>& expected,
-        const std::string& got);
+        const std::string& got) const;
     explicit CFG(std::string jsonFile);
     CFG(json &jsonObj);
     CFG() = default;
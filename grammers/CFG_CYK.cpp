@@ -2,6 +2,8 @@
 #include <fstream>
 #include <algorithm>
 
+namespace cyk {
+
 CFG::CFG(const std::string& filename) {
     std::ifstream input(filename);
     nlohmann::json j;
@@ -268,3 +270,5 @@ void CFG::analyze(const std::string& w) {
     }
     std::cout << "----------------------------------------------------" << std::endl;
 }
+
+} // namespace cyk
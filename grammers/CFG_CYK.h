@@ -8,6 +8,10 @@
 #include <string>
 #include "json.hpp"
 
+// Own namespace: this CNF-only CFG would otherwise clash with grammers/CFG.h
+// in any program that links both
+namespace cyk {
+
 
 struct Derivation {
     bool isTerminal;        // Is dit een A -> a regel?
@@ -57,4 +61,6 @@ public:
     void analyze(const std::string& w);
 };
 
+} // namespace cyk
+
 #endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "DPDA.h"
+
+#include <stdexcept>
+
+// ---------------------------------------------------------------------------
+// Analysis
+// ---------------------------------------------------------------------------
+
+PdaDeterminismReport analyzeDeterminism(const PDA& pda) {
+    // (state, top) -> input ("" = epsilon) -> transitions
+    std::map<std::pair<std::string, std::string>, std::map<std::string, std::vector<size_t>>> cells;
+    const auto& transitions = pda.getTransitions();
+    for (size_t i = 0; i < transitions.size(); ++i) {
+        const transition& t = transitions[i];
+        cells[{t.fromState, t.stackTop}][t.inputSymbol].push_back(i);
+    }
+
+    PdaDeterminismReport report;
+    for (const auto& [key, byInput] : cells) {
+        auto epsilon = byInput.find("");
+        if (epsilon != byInput.end() && (byInput.size() > 1 || epsilon->second.size() > 1)) {
+            // The epsilon move competes with everything else here
+            PdaConflict c{key.first, key.second, "", {}};
+            for (const auto& [input, list] : byInput)
+                c.transitions.insert(c.transitions.end(), list.begin(), list.end());
+            report.conflicts.push_back(std::move(c));
+            continue;
+        }
+        for (const auto& [input, list] : byInput)
+            if (list.size() > 1) report.conflicts.push_back({key.first, key.second, input, list});
+    }
+    return report;
+}
+
+std::string PdaDeterminismReport::format(const PDA& pda) const {
+    const auto& transitions = pda.getTransitions();
+    std::string out;
+    for (const PdaConflict& c : conflicts) {
+        out += "state " + c.state + ", stack top " + c.stackTop + ", ";
+        out += c.input.empty() ? "epsilon move next to other moves:" : "input " + c.input + " has several moves:";
+        for (size_t i : c.transitions) {
+            const transition& t = transitions[i];
+            out += "\n  #" + std::to_string(i) + " " + t.fromState + " --" +
+                   (t.inputSymbol.empty() ? "eps" : t.inputSymbol) + ", " + t.stackTop + " / [";
+            for (size_t k = 0; k < t.stackPush.size(); ++k) out += (k ? " " : "") + t.stackPush[k];
+            out += "]--> " + t.toState;
+        }
+        out += "\n";
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Compilation
+// ---------------------------------------------------------------------------
+
+CompiledDPDA::CompiledDPDA(const PDA& pda, DpdaOptions options) : opt(options) {
+    const PdaDeterminismReport report = analyzeDeterminism(pda);
+    if (!report.deterministic())
+        throw std::invalid_argument("CompiledDPDA: PDA is not deterministic\n" + report.format(pda));
+    if (pda.getStartState().empty() || pda.getStartStack().empty())
+        throw std::invalid_argument("CompiledDPDA: PDA has no start state or start stack symbol");
+
+    std::map<std::string, int> stateIds, symbolIds;
+    auto intern = [](std::map<std::string, int>& ids, const std::string& name) {
+        return ids.emplace(name, (int)ids.size()).first->second;
+    };
+    for (const auto& s : pda.getStates()) intern(stateIds, s);
+    for (const auto& g : pda.getStackAlphabet()) intern(symbolIds, g);
+    for (const auto& a : pda.getAlphabet()) intern(terminalIds, a);
+    startState = intern(stateIds, pda.getStartState());
+    startSymbol = intern(symbolIds, pda.getStartStack());
+    for (const transition& t : pda.getTransitions()) {
+        intern(stateIds, t.fromState);
+        intern(stateIds, t.toState);
+        intern(symbolIds, t.stackTop);
+        for (const auto& b : t.stackPush) intern(symbolIds, b);
+        if (!t.inputSymbol.empty()) intern(terminalIds, t.inputSymbol);
+    }
+    numStates = (int)stateIds.size();
+    numSymbols = (int)symbolIds.size();
+    numTerminals = (int)terminalIds.size();
+
+    const size_t columns = (size_t)numTerminals + 1;     // last column: end of input
+    table.assign((size_t)numStates * numSymbols * columns, -1);
+    for (const transition& t : pda.getTransitions()) {
+        Move m{stateIds.at(t.toState), (uint32_t)pushes.size(), (uint16_t)t.stackPush.size(),
+               !t.inputSymbol.empty()};
+        for (auto it = t.stackPush.rbegin(); it != t.stackPush.rend(); ++it)
+            pushes.push_back(symbolIds.at(*it));
+
+        const size_t row = ((size_t)stateIds.at(t.fromState) * numSymbols + symbolIds.at(t.stackTop)) * columns;
+        const int32_t index = (int32_t)moves.size();
+        moves.push_back(m);
+        if (m.consumes) {
+            table[row + terminalIds.at(t.inputSymbol)] = index;
+        } else {
+            for (size_t c = 0; c < columns; ++c) table[row + c] = index;
+        }
+    }
+
+    // Guard against epsilon cycles: a run of more epsilon moves than there
+    // are (state, top, depth) triples is treated as looping
+    epsilonLimit = (size_t)numStates * numSymbols * ((size_t)opt.stackCapacity + 1);
+}
+
+int CompiledDPDA::terminalId(const std::string& name) const {
+    auto it = terminalIds.find(name);
+    return it == terminalIds.end() ? -1 : it->second;
+}
+
+// ---------------------------------------------------------------------------
+// Execution
+// ---------------------------------------------------------------------------
+
+bool CompiledDPDA::accepts(const std::vector<int>& terminals, DpdaScratch& scratch, int* errorIndex) const {
+    if (scratch.stack.size() < opt.stackCapacity) scratch.stack.resize(opt.stackCapacity);
+    scratch.overflow = false;
+    int32_t* stack = scratch.stack.data();
+    const size_t capacity = opt.stackCapacity;
+    const size_t columns = (size_t)numTerminals + 1;
+
+    const size_t n = terminals.size();
+    size_t ip = 0;
+    size_t sp = 0;
+    size_t epsilonRun = 0;
+    int32_t state = startState;
+    if (capacity == 0) {
+        scratch.overflow = true;
+        if (errorIndex) *errorIndex = 0;
+        return false;
+    }
+    stack[sp++] = startSymbol;
+
+    while (sp > 0) {
+        size_t column = (size_t)numTerminals;
+        if (ip < n) {
+            const int a = terminals[ip];
+            if (a < 0 || a >= numTerminals) break;
+            column = (size_t)a;
+        }
+
+        const int32_t index = table[((size_t)state * numSymbols + stack[sp - 1]) * columns + column];
+        if (index < 0) break;
+        const Move& m = moves[index];
+
+        sp--;
+        if (sp + m.pushCount > capacity) {
+            scratch.overflow = true;
+            break;
+        }
+        for (uint16_t k = 0; k < m.pushCount; ++k) stack[sp++] = pushes[m.pushBegin + k];
+        state = m.to;
+
+        if (m.consumes) {
+            ip++;
+            epsilonRun = 0;
+        } else if (++epsilonRun > epsilonLimit) {
+            break;
+        }
+    }
+
+    if (sp == 0 && ip == n) return true;
+    if (errorIndex) *errorIndex = (int)ip;
+    return false;
+}
@@ -0,0 +1,89 @@
+//
+// Determinism analysis of PDA specs, and a flat-table executor for the
+// ones that pass.
+//
+
+#ifndef MB_DPDA_H
+#define MB_DPDA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PDA.h"
+
+// Moves that make one (state, stack top) nondeterministic
+struct PdaConflict {
+    std::string state;
+    std::string stackTop;
+    std::string input;                  // "" for an epsilon move clashing with input moves
+    std::vector<size_t> transitions;    // indices into PDA::getTransitions()
+};
+
+struct PdaDeterminismReport {
+    std::vector<PdaConflict> conflicts;
+
+    [[nodiscard]] bool deterministic() const { return conflicts.empty(); }
+
+    // One line per conflict, naming the clashing transitions
+    [[nodiscard]] std::string format(const PDA& pda) const;
+};
+
+// A PDA is deterministic when, for every state and stack top, no input
+// symbol has two moves and an epsilon move is the only move there
+PdaDeterminismReport analyzeDeterminism(const PDA& pda);
+
+struct DpdaOptions {
+    // Fixed stack capacity; a run that would push past it is rejected
+    uint32_t stackCapacity = 256;
+};
+
+// Per-thread stack, sized once to the capacity
+struct DpdaScratch {
+    std::vector<int32_t> stack;
+    bool overflow = false;              // last run hit DpdaOptions::stackCapacity
+};
+
+// One int32 per (state, stack top, input column): the index of the only
+// move that applies, or -1. An epsilon move fills every column of its
+// (state, top), end of input included, so a step is one lookup whether it
+// consumes or not. Accepts by empty stack, like PDAExecutor.
+class CompiledDPDA {
+public:
+    // Throws std::invalid_argument, listing the conflicts, if `pda` is not
+    // deterministic
+    explicit CompiledDPDA(const PDA& pda, DpdaOptions options = {});
+
+    // `terminals` holds ids from terminalId(); -1 (unknown) is rejected.
+    // errorIndex as in PDAExecutor::accepts(). const: shareable across threads.
+    [[nodiscard]] bool accepts(const std::vector<int>& terminals, DpdaScratch& scratch,
+                               int* errorIndex = nullptr) const;
+
+    [[nodiscard]] int terminalId(const std::string& name) const;
+    [[nodiscard]] int terminalCount() const { return numTerminals; }
+
+private:
+    struct Move {
+        int32_t to;
+        uint32_t pushBegin;     // into pushes, bottom of the pushed block first
+        uint16_t pushCount;
+        bool consumes;
+    };
+
+    DpdaOptions opt;
+    int numStates = 0;
+    int numSymbols = 0;
+    int numTerminals = 0;
+    int32_t startState = 0;
+    int32_t startSymbol = 0;
+    size_t epsilonLimit = 0;    // longest epsilon run before a run is declared looping
+    std::map<std::string, int> terminalIds;
+
+    std::vector<int32_t> table;
+    std::vector<Move> moves;
+    std::vector<int32_t> pushes;
+};
+
+#endif //MB_DPDA_H
@@ -4,10 +4,14 @@
 
 #include "PDA.h"
 
+#include <map>
+
+#include "../utils/Log.h"
+
 PDA::PDA(std::string jsonFile) : filename(std::move(jsonFile)) {
     std::ifstream input(filename);
     if (!input.is_open()) {
-        std::cerr << "Error: Unable to open file." << std::endl;
+        LOG_ERROR("PDA") << "Unable to open file: " << filename;
         return;
     }
 
@@ -202,3 +206,173 @@ CFG PDA::toCFG() {
     return CFG(jsonObj);
 }
 
+
+// ---------------------------------------------------------------------------
+// Lazy triple construction
+// ---------------------------------------------------------------------------
+
+CFG PDA::toReducedCFG(PdaConversionStats* stats) const {
+    // Dense ids; transitions may name states or stack symbols the lists omit
+    std::map<std::string, int> stateIds, symbolIds;
+    std::vector<const std::string*> stateNames, symbolNames;
+    auto intern = [](std::map<std::string, int>& ids, std::vector<const std::string*>& names,
+                     const std::string& name) {
+        auto [it, added] = ids.emplace(name, (int)names.size());
+        if (added) names.push_back(&it->first);
+        return it->second;
+    };
+    for (const auto& s : states) intern(stateIds, stateNames, s);
+    for (const auto& g : stackAlphabet) intern(symbolIds, symbolNames, g);
+    const int q0 = intern(stateIds, stateNames, startState);
+    const int z0 = intern(symbolIds, symbolNames, startStack);
+
+    struct Move {
+        int from, top, to;
+        const std::string* input;
+        std::vector<int> push;
+    };
+    std::vector<Move> moves;
+    for (const transition& t : transitions) {
+        Move m{intern(stateIds, stateNames, t.fromState), intern(symbolIds, symbolNames, t.stackTop),
+               intern(stateIds, stateNames, t.toState), &t.inputSymbol, {}};
+        for (const auto& b : t.stackPush) m.push.push_back(intern(symbolIds, symbolNames, b));
+        moves.push_back(std::move(m));
+    }
+
+    const size_t Q = stateNames.size();
+    const size_t G = symbolNames.size();
+    auto triple = [&](size_t p, size_t A, size_t q) { return (p * G + A) * Q + q; };
+
+    std::vector<std::vector<int>> movesFrom(Q * G);     // (p, A) -> moves popping A in p
+    std::vector<std::vector<int>> pushing(G);           // B -> moves whose push contains B
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& m = moves[i];
+        movesFrom[(size_t)m.from * G + m.top].push_back((int)i);
+        for (int b : m.push)
+            if (pushing[b].empty() || pushing[b].back() != (int)i) pushing[b].push_back((int)i);
+    }
+
+    // layers[i][s]: after popping the first i pushed symbols through
+    // productive triples, the PDA can be in state s
+    std::vector<char> productive(Q * G * Q, 0);
+    std::vector<std::vector<char>> layers;
+    auto walk = [&](const Move& m) {
+        layers.resize(std::max(layers.size(), m.push.size() + 1));
+        layers[0].assign(Q, 0);
+        layers[0][m.to] = 1;
+        for (size_t i = 0; i < m.push.size(); ++i) {
+            layers[i + 1].assign(Q, 0);
+            for (size_t s = 0; s < Q; ++s) {
+                if (!layers[i][s]) continue;
+                for (size_t r = 0; r < Q; ++r)
+                    if (productive[triple(s, m.push[i], r)]) layers[i + 1][r] = 1;
+            }
+        }
+        return m.push.size();
+    };
+
+    // 1. Productive triples: a move makes [p,A,q] productive for every q its
+    //    push chain can end in; a new productive [s,B,r] re-queues the
+    //    moves that push B
+    size_t productiveCount = 0;
+    std::vector<int> work(moves.size());
+    std::vector<char> queued(moves.size(), 1);
+    for (size_t i = 0; i < moves.size(); ++i) work[i] = (int)i;
+    while (!work.empty()) {
+        const int i = work.back();
+        work.pop_back();
+        queued[i] = 0;
+        const Move& m = moves[i];
+        const size_t k = walk(m);
+        for (size_t q = 0; q < Q; ++q) {
+            const size_t id = triple(m.from, m.top, q);
+            if (!layers[k][q] || productive[id]) continue;
+            productive[id] = 1;
+            productiveCount++;
+            for (int j : pushing[m.top]) {
+                if (queued[j]) continue;
+                queued[j] = 1;
+                work.push_back(j);
+            }
+        }
+    }
+
+    // 2. Productions, from S outwards over productive triples only
+    auto name = [&](size_t id) {
+        const size_t p = id / (G * Q), A = (id / Q) % G, q = id % Q;
+        return "[" + *stateNames[p] + "," + *symbolNames[A] + "," + *stateNames[q] + "]";
+    };
+
+    const std::string startSymbol = "S";
+    std::vector<production> productions;
+    std::vector<std::string> variables{startSymbol};
+    std::vector<char> reached(Q * G * Q, 0);
+    std::vector<size_t> pending;
+    auto reach = [&](size_t id) {
+        if (reached[id]) return;
+        reached[id] = 1;
+        variables.push_back(name(id));
+        pending.push_back(id);
+    };
+
+    for (size_t q = 0; q < Q; ++q) {
+        const size_t id = triple(q0, z0, q);
+        if (!productive[id]) continue;
+        productions.emplace_back(startSymbol, std::vector<std::string>{name(id)});
+        reach(id);
+    }
+
+    std::vector<int> chain;
+    std::vector<std::string> body;
+    while (!pending.empty()) {
+        const size_t id = pending.back();
+        pending.pop_back();
+        const size_t p = id / (G * Q), A = (id / Q) % G, q = id % Q;
+        const std::string head = name(id);
+
+        for (int i : movesFrom[p * G + A]) {
+            const Move& m = moves[i];
+            const size_t k = walk(m);
+            if (!layers[k][q]) continue;
+
+            // Every chain m.to = r0 .. rk = q, picked backwards: layers[i-1]
+            // guarantees r_{i-1} is reachable from r0, so no branch dead-ends
+            chain.assign(k + 1, 0);
+            chain[k] = (int)q;
+            auto emit = [&](auto& self, size_t level) -> void {
+                if (level == 0) {
+                    body.clear();
+                    if (!m.input->empty()) body.push_back(*m.input);
+                    for (size_t j = 1; j <= k; ++j) {
+                        const size_t part = triple(chain[j - 1], m.push[j - 1], chain[j]);
+                        body.push_back(name(part));
+                        reach(part);
+                    }
+                    productions.emplace_back(head, body);
+                    return;
+                }
+                for (size_t s = 0; s < Q; ++s) {
+                    if (!layers[level - 1][s] || !productive[triple(s, m.push[level - 1], chain[level])]) continue;
+                    chain[level - 1] = (int)s;
+                    self(self, level - 1);
+                }
+            };
+            emit(emit, k);
+        }
+    }
+
+    std::sort(variables.begin(), variables.end());
+
+    if (stats) {
+        stats->productiveTriples = productiveCount;
+        stats->reachedTriples = variables.size() - 1;
+        stats->productions = productions.size();
+    }
+
+    CFG cfg;
+    cfg.setVariables(variables);
+    cfg.setTerminals(alphabet);
+    cfg.setStartSymbol(startSymbol);
+    cfg.setProductions(productions);
+    return cfg;
+}
@@ -15,10 +15,35 @@ struct transition {
     std::vector<std::string> stackPush;
 };
 
+// Sizes of one toReducedCFG() run
+struct PdaConversionStats {
+    size_t productiveTriples = 0;   // [p,A,q] that derive some input
+    size_t reachedTriples = 0;      // of those, reachable from S (= variables - 1)
+    size_t productions = 0;
+};
+
 class PDA {
 public:
     explicit PDA(std::string jsonFile);
+
+    // Textbook triple construction: every [p,A,q], every state tuple per
+    // push, built as JSON and re-read by CFG(json&); unsimplified
     CFG toCFG();
+
+    // Same language as toCFG() followed by CFG::simplify(), built on
+    // demand: productive triples first (worklist over the transitions),
+    // then only those reachable from S get productions, which go straight
+    // into the CFG. Push chains only run through productive triples, so the
+    // |Q|^(k-1) tuples of a k-symbol push are never enumerated.
+    CFG toReducedCFG(PdaConversionStats* stats = nullptr) const;
+
+    [[nodiscard]] const std::vector<std::string> &getStates() const { return states; }
+    [[nodiscard]] const std::vector<std::string> &getAlphabet() const { return alphabet; }
+    [[nodiscard]] const std::vector<std::string> &getStackAlphabet() const { return stackAlphabet; }
+    [[nodiscard]] const std::string &getStartState() const { return startState; }
+    [[nodiscard]] const std::string &getStartStack() const { return startStack; }
+    [[nodiscard]] const std::vector<transition> &getTransitions() const { return transitions; }
+
     ~PDA() = default;
 private:
     std::string filename;
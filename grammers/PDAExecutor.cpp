@@ -0,0 +1,263 @@
+#include "PDAExecutor.h"
+
+#include <stdexcept>
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+PDAExecutor::PDAExecutor(const PDA& pda, PdaExecutorOptions options) : opt(options) {
+    if (pda.getStartState().empty() || pda.getStartStack().empty())
+        throw std::invalid_argument("PDAExecutor: PDA has no start state or start stack symbol");
+
+    // Dense ids; transitions may name states or symbols the lists omit
+    std::map<std::string, int> stateIds, symbolIds;
+    auto intern = [](std::map<std::string, int>& ids, const std::string& name) {
+        return ids.emplace(name, (int)ids.size()).first->second;
+    };
+    for (const auto& s : pda.getStates()) intern(stateIds, s);
+    for (const auto& g : pda.getStackAlphabet()) intern(symbolIds, g);
+    for (const auto& a : pda.getAlphabet()) intern(terminalIds, a);
+    startState = intern(stateIds, pda.getStartState());
+    startSymbol = intern(symbolIds, pda.getStartStack());
+
+    struct Raw {
+        int from, top, column;
+        Move move;
+    };
+    std::vector<Raw> raw;
+    for (const transition& t : pda.getTransitions()) {
+        Raw r{};
+        r.from = intern(stateIds, t.fromState);
+        r.top = intern(symbolIds, t.stackTop);
+        r.move.to = intern(stateIds, t.toState);
+        r.move.input = t.inputSymbol.empty() ? -1 : intern(terminalIds, t.inputSymbol);
+        r.move.pushBegin = (uint32_t)pushes.size();
+        for (const auto& b : t.stackPush) pushes.push_back(intern(symbolIds, b));
+        r.move.pushEnd = (uint32_t)pushes.size();
+        raw.push_back(r);
+    }
+
+    numStates = (int)stateIds.size();
+    numSymbols = (int)symbolIds.size();
+    numTerminals = (int)terminalIds.size();
+    for (Raw& r : raw) r.column = r.move.input < 0 ? numTerminals : r.move.input;
+
+    // Counting sort of the moves by cell
+    const size_t cells = (size_t)numStates * numSymbols * (numTerminals + 1);
+    cellStart.assign(cells + 1, 0);
+    for (const Raw& r : raw) cellStart[cell(r.from, r.top, r.column) + 1]++;
+    for (size_t c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+    moves.resize(raw.size());
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (const Raw& r : raw) moves[fill[cell(r.from, r.top, r.column)]++] = r.move;
+}
+
+int PDAExecutor::terminalId(const std::string& name) const {
+    auto it = terminalIds.find(name);
+    return it == terminalIds.end() ? -1 : it->second;
+}
+
+// ---------------------------------------------------------------------------
+// Scratch table
+// ---------------------------------------------------------------------------
+
+int PdaScratch::Table::insert(uint64_t key, int value, bool& added) {
+    if ((count + 1) * 2 > keys.size()) grow();
+    const size_t mask = keys.size() - 1;
+    size_t i = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    while (stamps[i] == stamp) {
+        if (keys[i] == key) {
+            added = false;
+            return values[i];
+        }
+        i = (i + 1) & mask;
+    }
+    stamps[i] = stamp;
+    keys[i] = key;
+    values[i] = value;
+    count++;
+    added = true;
+    return value;
+}
+
+void PdaScratch::Table::grow() {
+    std::vector<uint64_t> oldKeys = std::move(keys);
+    std::vector<int> oldValues = std::move(values);
+    std::vector<uint32_t> oldStamps = std::move(stamps);
+    const uint32_t live = stamp;
+
+    const size_t size = std::max<size_t>(64, oldKeys.size() * 2);
+    keys.assign(size, 0);
+    values.assign(size, 0);
+    stamps.assign(size, 0);
+    stamp = 1;
+    count = 0;
+
+    bool added;
+    for (size_t i = 0; i < oldKeys.size(); ++i)
+        if (oldStamps[i] == live) insert(oldKeys[i], oldValues[i], added);
+}
+
+// ---------------------------------------------------------------------------
+// Execution
+// ---------------------------------------------------------------------------
+
+int PDAExecutor::apply(const Move& m, int below, PdaScratch& scratch, bool intern) const {
+    auto& nodes = scratch.nodes;
+    int node = below;
+    for (uint32_t i = m.pushEnd; i-- > m.pushBegin;) {
+        const int symbol = pushes[i];
+        const uint32_t depth = node < 0 ? 1 : nodes[node].depth + 1;
+        if (depth > opt.maxStackDepth) return -2;
+
+        if (intern) {
+            const uint64_t key = ((uint64_t)(uint32_t)symbol << 32) | (uint32_t)(node + 1);
+            bool added;
+            const int found = scratch.interned.insert(key, (int)nodes.size(), added);
+            if (added) nodes.push_back({symbol, node, depth});
+            node = found;
+        } else {
+            nodes.push_back({symbol, node, depth});
+            node = (int)nodes.size() - 1;
+        }
+    }
+    return node;
+}
+
+bool PDAExecutor::addConfig(PdaScratch& scratch, std::vector<PdaScratch::Config>& set,
+                            int state, int node) const {
+    const uint64_t key = ((uint64_t)(uint32_t)state << 32) | (uint32_t)(node + 1);
+    bool added;
+    scratch.seen.insert(key, 0, added);
+    if (!added) return true;
+    if (set.size() >= opt.maxConfigurations) {
+        scratch.limitHit = true;
+        return false;
+    }
+    set.push_back({state, node});
+    return true;
+}
+
+bool PDAExecutor::accepts(const std::vector<int>& terminals, PdaScratch& scratch, int* errorIndex) const {
+    auto& nodes = scratch.nodes;
+    auto& current = scratch.current;
+    auto& next = scratch.next;
+    nodes.clear();
+    scratch.interned.clear();
+    current.clear();
+    scratch.fastSteps = scratch.setSteps = 0;
+    scratch.limitHit = false;
+
+    const size_t n = terminals.size();
+    auto fail = [&](size_t at) {
+        if (errorIndex) *errorIndex = (int)at;
+        return false;
+    };
+
+    nodes.push_back({startSymbol, -1, 1});
+    current.push_back({startState, 0});
+
+    // A longer run of epsilon moves than there are (state, top) pairs is a
+    // loop; configuration sets deduplicate it
+    const size_t epsilonLimit = (size_t)numStates * numSymbols;
+    size_t epsilonRun = 0;
+    size_t ip = 0;
+
+    while (true) {
+        // ----- deterministic fast path -----
+        if (current.size() == 1 && epsilonRun <= epsilonLimit) {
+            const PdaScratch::Config c = current[0];
+            if (c.node < 0) return ip == n ? true : fail(ip);
+
+            const int a = ip < n ? terminals[ip] : -1;
+            if (ip < n && (a < 0 || a >= numTerminals)) return fail(ip);
+
+            const PdaScratch::Node top = nodes[c.node];
+            const size_t e = cell(c.state, top.symbol, numTerminals);
+            uint32_t first = cellStart[e];
+            uint32_t count = cellStart[e + 1] - first;
+            if (a >= 0) {
+                const size_t i = cell(c.state, top.symbol, a);
+                if (count == 0) first = cellStart[i];
+                count += cellStart[i + 1] - cellStart[i];
+            }
+            if (count == 0) return fail(ip);
+
+            if (count == 1) {
+                // One configuration: everything above its top is garbage
+                if (!scratch.interned.empty()) scratch.interned.clear();
+                nodes.resize(c.node);
+
+                const Move& m = moves[first];
+                const int node = apply(m, top.parent, scratch, false);
+                if (node == -2) {
+                    scratch.limitHit = true;
+                    return fail(ip);
+                }
+                current[0] = {m.to, node};
+                scratch.fastSteps++;
+                if (m.input >= 0) {
+                    ip++;
+                    epsilonRun = 0;
+                } else {
+                    epsilonRun++;
+                }
+                continue;
+            }
+        }
+
+        // ----- configuration sets -----
+        scratch.setSteps++;
+        epsilonRun = 0;
+
+        // Epsilon closure, in place
+        scratch.seen.clear();
+        bool added;
+        for (const PdaScratch::Config& c : current)
+            scratch.seen.insert(((uint64_t)(uint32_t)c.state << 32) | (uint32_t)(c.node + 1), 0, added);
+        for (size_t k = 0; k < current.size(); ++k) {
+            const PdaScratch::Config c = current[k];
+            if (c.node < 0) continue;
+            const PdaScratch::Node top = nodes[c.node];
+            const size_t e = cell(c.state, top.symbol, numTerminals);
+            for (uint32_t j = cellStart[e]; j < cellStart[e + 1]; ++j) {
+                const int node = apply(moves[j], top.parent, scratch, true);
+                if (node == -2) {
+                    scratch.limitHit = true;
+                    continue;
+                }
+                if (!addConfig(scratch, current, moves[j].to, node)) return fail(ip);
+            }
+        }
+
+        if (ip == n) {
+            for (const PdaScratch::Config& c : current)
+                if (c.node < 0) return true;
+            return fail(n);
+        }
+
+        const int a = terminals[ip];
+        if (a < 0 || a >= numTerminals) return fail(ip);
+
+        next.clear();
+        scratch.seen.clear();
+        for (const PdaScratch::Config& c : current) {
+            if (c.node < 0) continue;
+            const PdaScratch::Node top = nodes[c.node];
+            const size_t i = cell(c.state, top.symbol, a);
+            for (uint32_t j = cellStart[i]; j < cellStart[i + 1]; ++j) {
+                const int node = apply(moves[j], top.parent, scratch, true);
+                if (node == -2) {
+                    scratch.limitHit = true;
+                    continue;
+                }
+                if (!addConfig(scratch, next, moves[j].to, node)) return fail(ip);
+            }
+        }
+        if (next.empty()) return fail(ip);
+
+        current.swap(next);
+        ip++;
+    }
+}
@@ -0,0 +1,124 @@
+//
+// Runs a PDA directly on a terminal stream, accepting by empty stack (the
+// same acceptance toCFG() encodes with S -> [q0,Z0,q]).
+//
+
+#ifndef MB_PDAEXECUTOR_H
+#define MB_PDAEXECUTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PDA.h"
+
+struct PdaExecutorOptions {
+    // A configuration whose stack would grow past this is dropped, which
+    // bounds epsilon moves that push forever
+    uint32_t maxStackDepth = 1024;
+    // More live configurations than this at one input position: reject
+    size_t maxConfigurations = 1 << 16;
+};
+
+// Per-thread working memory, cleared (capacity kept) by every run
+struct PdaScratch {
+    struct Node {
+        int symbol;
+        int parent;             // -1: bottom of the stack
+        uint32_t depth;
+    };
+    struct Config {
+        int state;
+        int node;               // top of stack, -1 if empty
+    };
+
+    // Open-addressing uint64 -> int map; clear() bumps a stamp instead of
+    // touching the slots, so per-position resets cost nothing and steady
+    // state does not allocate
+    class Table {
+    public:
+        // Value stored under `key`, inserting `value` first if absent
+        int insert(uint64_t key, int value, bool& added);
+        void clear() { if (++stamp == 0) { std::fill(stamps.begin(), stamps.end(), 0); stamp = 1; } count = 0; }
+        [[nodiscard]] bool empty() const { return count == 0; }
+
+    private:
+        void grow();
+
+        std::vector<uint64_t> keys;
+        std::vector<int> values;
+        std::vector<uint32_t> stamps;   // slot is live iff stamps[i] == stamp
+        uint32_t stamp = 1;
+        size_t count = 0;
+    };
+
+    std::vector<Node> nodes;    // shared stack suffixes
+    Table interned;             // (symbol, parent) -> node, set mode only
+    std::vector<Config> current, next;
+    Table seen;                 // (state, node) per position
+
+    // Moves taken on the deterministic fast path / positions that needed
+    // configuration sets, for the last run
+    uint64_t fastSteps = 0;
+    uint64_t setSteps = 0;
+    bool limitHit = false;      // maxStackDepth or maxConfigurations cut the search
+};
+
+// Transitions are compiled into a table indexed by (state, stack top,
+// input or epsilon). While one configuration is alive and exactly one move
+// applies, the run is a plain loop over that table. Anywhere else it
+// switches to breadth-first configuration sets: stacks are shared suffix
+// nodes, hash-consed so equal stacks are one node, and (state, node) pairs
+// are deduplicated per input position. It drops back to the fast path as
+// soon as the set collapses to one configuration.
+class PDAExecutor {
+public:
+    // Throws std::invalid_argument if the PDA has no start state or start
+    // stack symbol
+    explicit PDAExecutor(const PDA& pda, PdaExecutorOptions options = {});
+
+    // `terminals` holds ids from terminalId(); -1 (unknown) is rejected.
+    // On rejection `errorIndex` is the input position no configuration
+    // could consume (terminals.size() if the input ran out first).
+    // const: threads can share one executor, each with its own scratch.
+    [[nodiscard]] bool accepts(const std::vector<int>& terminals, PdaScratch& scratch,
+                               int* errorIndex = nullptr) const;
+
+    // Input symbol name -> dense id, -1 if unknown
+    [[nodiscard]] int terminalId(const std::string& name) const;
+    [[nodiscard]] int terminalCount() const { return numTerminals; }
+
+private:
+    struct Move {
+        int to;
+        int input;              // -1: epsilon
+        uint32_t pushBegin;     // into pushes, top of stack first
+        uint32_t pushEnd;
+    };
+
+    // Moves for (state, top, column); column numTerminals is epsilon
+    [[nodiscard]] size_t cell(int state, int top, int column) const {
+        return ((size_t)state * numSymbols + top) * (numTerminals + 1) + column;
+    }
+
+    // Pushes m onto the stack below `node`, which has just been popped
+    int apply(const Move& m, int below, PdaScratch& scratch, bool intern) const;
+    bool addConfig(PdaScratch& scratch, std::vector<PdaScratch::Config>& set, int state, int node) const;
+
+    PdaExecutorOptions opt;
+    int numStates = 0;
+    int numSymbols = 0;
+    int numTerminals = 0;
+    int startState = -1;
+    int startSymbol = -1;
+    std::map<std::string, int> terminalIds;
+
+    std::vector<Move> moves;
+    std::vector<int> pushes;
+    std::vector<uint32_t> cellStart;    // cell -> first move; cellStart[cell + 1] ends it
+};
+
+#endif //MB_PDAEXECUTOR_H
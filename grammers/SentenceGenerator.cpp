@@ -0,0 +1,247 @@
+#include "SentenceGenerator.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+SentenceGenerator::SentenceGenerator(const CFG& cfg, SentenceOptions options) : opt(std::move(options)) {
+    const auto& productions = cfg.getProductions();
+
+    // Nonterminals: declared variables and every production head
+    std::set<std::string> heads(cfg.getVariables().begin(), cfg.getVariables().end());
+    for (const production& p : productions) heads.insert(p.lhs);
+
+    // Terminals: declared ones first (stable ids), then any other body symbol
+    auto addTerminal = [&](const std::string& name) {
+        if (heads.count(name) || ids.count(name)) return;
+        ids[name] = (int)terminalNames.size();
+        terminalNames.push_back(name);
+    };
+    for (const std::string& t : cfg.getTerminals()) addTerminal(t);
+    for (const production& p : productions)
+        for (const std::string& sym : p.body) addTerminal(sym);
+
+    const int T = (int)terminalNames.size();
+    for (const std::string& h : heads) {
+        ids[h] = T + (int)nonterminalNames.size();
+        nonterminalNames.push_back(h);
+    }
+
+    const size_t N = nonterminalNames.size();
+    rules.assign(N, {});
+    for (size_t i = 0; i < productions.size(); ++i) {
+        Rule r;
+        for (const std::string& sym : productions[i].body) r.body.push_back(ids.at(sym));
+        if (i < opt.weights.size()) r.weight = std::max(0.0, opt.weights[i]);
+        const int a = ids.at(productions[i].lhs) - T;
+        ruleOf.emplace_back(a, (int)rules[a].size());
+        rules[a].push_back(std::move(r));
+    }
+
+    // Shortest yield per nonterminal, finalising one nonterminal at a time
+    // (cheapest first). A closing rule only uses symbols finalised before
+    // its head, so following closing rules can never cycle.
+    shortestLength.assign(N, -1);
+    closingRule.assign(N, -1);
+    std::vector<int> closingDepth(N, -1);
+    while (true) {
+        int bestA = -1, bestRule = -1, bestLen = 0, bestDepth = 0;
+        for (size_t a = 0; a < N; ++a) {
+            if (shortestLength[a] >= 0) continue;
+            for (size_t k = 0; k < rules[a].size(); ++k) {
+                int len = 0, depth = 1;
+                bool ready = true;
+                for (int sym : rules[a][k].body) {
+                    if (isTerminal(sym)) { len++; continue; }
+                    const int b = sym - T;
+                    if (shortestLength[b] < 0) { ready = false; break; }
+                    len += shortestLength[b];
+                    depth = std::max(depth, closingDepth[b] + 1);
+                }
+                if (!ready) continue;
+                if (bestA < 0 || len < bestLen || (len == bestLen && depth < bestDepth)) {
+                    bestA = (int)a; bestRule = (int)k; bestLen = len; bestDepth = depth;
+                }
+            }
+        }
+        if (bestA < 0) break;
+        shortestLength[bestA] = bestLen;
+        closingRule[bestA] = bestRule;
+        closingDepth[bestA] = bestDepth;
+    }
+
+    for (auto& list : rules) {
+        for (Rule& r : list) {
+            int len = 0;
+            for (int sym : r.body) {
+                const int m = symbolMinLength(sym);
+                if (m < 0) { len = -1; break; }
+                len += m;
+            }
+            r.minLength = len;
+        }
+    }
+
+    // Minimum derivation depth, independent of length (plain fixpoint)
+    minimumDepth.assign(N, -1);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t a = 0; a < N; ++a) {
+            for (const Rule& r : rules[a]) {
+                int depth = 1;
+                for (int sym : r.body) {
+                    if (isTerminal(sym)) continue;
+                    const int d = minimumDepth[sym - T];
+                    if (d < 0) { depth = -1; break; }
+                    depth = std::max(depth, d + 1);
+                }
+                if (depth > 0 && (minimumDepth[a] < 0 || depth < minimumDepth[a])) {
+                    minimumDepth[a] = depth;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Surface forms
+    surface.assign(terminalNames.size(), {});
+    for (size_t t = 0; t < terminalNames.size(); ++t) {
+        auto it = opt.lexemes.find(terminalNames[t]);
+        if (it != opt.lexemes.end() && !it->second.empty()) surface[t] = it->second;
+        else surface[t] = {terminalNames[t]};
+    }
+
+    auto start = ids.find(cfg.getStartSymbol());
+    if (start == ids.end() || isTerminal(start->second))
+        throw std::invalid_argument("SentenceGenerator: start symbol '" + cfg.getStartSymbol() + "' has no productions");
+    startSymbol = start->second;
+
+    const int shortest = symbolMinLength(startSymbol);
+    if (shortest < 0)
+        throw std::invalid_argument("SentenceGenerator: start symbol derives no finite sentence");
+    if ((size_t)shortest > opt.maxLength)
+        throw std::invalid_argument("SentenceGenerator: shortest sentence has " + std::to_string(shortest) +
+                                    " terminals, above maxLength");
+}
+
+int SentenceGenerator::symbolMinLength(int symbol) const {
+    return isTerminal(symbol) ? 1 : shortestLength[symbol - (int)terminalNames.size()];
+}
+
+int SentenceGenerator::minLength(const std::string& nonterminal) const {
+    auto it = ids.find(nonterminal);
+    return it == ids.end() || isTerminal(it->second) ? -1 : symbolMinLength(it->second);
+}
+
+int SentenceGenerator::minDepth(const std::string& nonterminal) const {
+    auto it = ids.find(nonterminal);
+    return it == ids.end() || isTerminal(it->second) ? -1 : minimumDepth[it->second - (int)terminalNames.size()];
+}
+
+// ---------------------------------------------------------------------------
+// Generation
+// ---------------------------------------------------------------------------
+
+bool SentenceGenerator::expand(Xoshiro256& rng, SentenceScratch& scratch) const {
+    const int T = (int)terminalNames.size();
+    auto& stack = scratch.stack;
+    auto& out = scratch.terminals;
+    stack.clear();
+    out.clear();
+
+    // emitted + pending (shortest yield of everything still on the stack)
+    // never exceeds maxLength: only rules that keep it so are eligible, and
+    // the closing rule always is
+    stack.push_back({startSymbol, 0});
+    size_t pending = (size_t)symbolMinLength(startSymbol);
+
+    while (!stack.empty()) {
+        const SentenceScratch::Frame f = stack.back();
+        stack.pop_back();
+
+        if (f.symbol < T) {
+            out.push_back(f.symbol);
+            pending -= 1;
+            continue;
+        }
+
+        const int a = f.symbol - T;
+        pending -= (size_t)shortestLength[a];
+        const size_t used = out.size() + pending;
+        const auto& list = rules[a];
+
+        int chosen = closingRule[a];
+        if (f.depth < opt.maxDepth) {
+            double total = 0;
+            for (const Rule& r : list)
+                if (r.minLength >= 0 && used + (size_t)r.minLength <= opt.maxLength) total += r.weight;
+
+            if (total > 0) {
+                double x = rng.uniform() * total;
+                for (size_t k = 0; k < list.size(); ++k) {
+                    const Rule& r = list[k];
+                    if (r.minLength < 0 || used + (size_t)r.minLength > opt.maxLength || r.weight <= 0) continue;
+                    chosen = (int)k;
+                    x -= r.weight;
+                    if (x < 0) break;
+                }
+            }
+        }
+
+        const Rule& r = list[chosen];
+        pending += (size_t)r.minLength;
+        for (auto it = r.body.rbegin(); it != r.body.rend(); ++it)
+            stack.push_back({*it, f.depth + 1});
+    }
+    return out.size() >= opt.minLength;
+}
+
+bool SentenceGenerator::generate(Xoshiro256& rng, SentenceScratch& scratch, std::vector<int>& out) const {
+    bool ok = false;
+    for (size_t attempt = 0; attempt < std::max<size_t>(1, opt.maxAttempts) && !ok; ++attempt)
+        ok = expand(rng, scratch);
+    out = scratch.terminals;
+    return ok;
+}
+
+bool SentenceGenerator::generateText(Xoshiro256& rng, SentenceScratch& scratch, std::string& out) const {
+    bool ok = false;
+    for (size_t attempt = 0; attempt < std::max<size_t>(1, opt.maxAttempts) && !ok; ++attempt)
+        ok = expand(rng, scratch);
+    if (!ok) return false;
+
+    render(scratch.terminals, rng, out);
+    return true;
+}
+
+void SentenceGenerator::render(const std::vector<int>& sentence, Xoshiro256& rng, std::string& out) const {
+    for (size_t i = 0; i < sentence.size(); ++i) {
+        if (i) out += opt.separator;
+        const auto& forms = surface[sentence[i]];
+        out += forms.size() == 1 ? forms[0] : forms[rng.below(forms.size())];
+    }
+}
+
+void SentenceGenerator::setWeight(size_t production, double weight) {
+    if (production >= ruleOf.size()) return;
+    const auto [a, k] = ruleOf[production];
+    rules[a][k].weight = std::max(0.0, weight);
+}
+
+size_t SentenceGenerator::appendCorpus(std::string& out, uint64_t first, size_t count,
+                                       SentenceScratch& scratch) const {
+    size_t written = 0;
+    for (uint64_t i = first; i < first + count; ++i) {
+        uint64_t x = opt.seed ^ (i * 0xD1B54A32D192ED03ULL);
+        Xoshiro256 rng(Xoshiro256::splitmix64(x));
+        if (!generateText(rng, scratch, out)) continue;
+        out += opt.recordSeparator;
+        written++;
+    }
+    return written;
+}
@@ -0,0 +1,120 @@
+//
+// Random sentences for any loaded CFG: benchmark and stress corpora for
+// grammars that have no hand-written message generator.
+//
+
+#ifndef MB_SENTENCE_GENERATOR_H
+#define MB_SENTENCE_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CFG.h"
+#include "../utils/Xoshiro.h"
+
+struct SentenceOptions {
+    uint64_t seed = 1;
+
+    // Bounds on the number of terminals per sentence. The upper bound is
+    // never exceeded; sentences shorter than minLength are redrawn up to
+    // maxAttempts times.
+    size_t minLength = 0;
+    size_t maxLength = 64;
+    size_t maxAttempts = 100;
+
+    // Past this derivation depth every nonterminal takes its shortest
+    // completion, so expansion always terminates
+    size_t maxDepth = 32;
+
+    // Per-production weights, indexed like CFG::getProductions(); empty
+    // means uniform. A weight of 0 disables a production except where it
+    // is the only way left to finish within the bounds.
+    std::vector<double> weights;
+
+    // Surface form of each terminal for generateText(); one is chosen at
+    // random per occurrence. Terminals without an entry print their name.
+    std::map<std::string, std::vector<std::string>> lexemes;
+    std::string separator = " ";        // between terminals
+    std::string recordSeparator = "\n"; // between sentences in appendCorpus()
+};
+
+// Caller-owned working memory; reused between sentences so steady-state
+// generation does not allocate
+struct SentenceScratch {
+    struct Frame {
+        int symbol;
+        uint32_t depth;
+    };
+    std::vector<Frame> stack;
+    std::vector<int> terminals;
+};
+
+// Leftmost derivation over integer symbol ids. The constructor precomputes,
+// per nonterminal, the shortest yield and its minimum derivation depth
+// (Knuth's generalisation of Dijkstra to grammars); expansion only picks
+// productions that can still finish within maxLength, and falls back to
+// the shortest completion past maxDepth.
+class SentenceGenerator {
+public:
+    // Throws std::invalid_argument if the start symbol derives no finite
+    // sentence or cannot fit in maxLength
+    explicit SentenceGenerator(const CFG& cfg, SentenceOptions options = {});
+
+    // Terminal ids (indices into terminals()) of one sentence; false if no
+    // sentence met minLength within maxAttempts
+    bool generate(Xoshiro256& rng, SentenceScratch& scratch, std::vector<int>& out) const;
+
+    // Same sentence as surface text, appended to `out`
+    bool generateText(Xoshiro256& rng, SentenceScratch& scratch, std::string& out) const;
+
+    // Surface text of a sentence from generate(), appended to `out`
+    void render(const std::vector<int>& sentence, Xoshiro256& rng, std::string& out) const;
+
+    // Re-weights one production (index into CFG::getProductions()) between
+    // draws, e.g. to steer towards uncovered rules. Not thread-safe.
+    void setWeight(size_t production, double weight);
+
+    // Sentences [first, first + count), each drawn from its own (seed, index)
+    // stream so ranges can be produced on any thread; each followed by
+    // recordSeparator. Returns the number of sentences written.
+    size_t appendCorpus(std::string& out, uint64_t first, size_t count, SentenceScratch& scratch) const;
+
+    [[nodiscard]] const std::vector<std::string>& terminals() const { return terminalNames; }
+
+    // Shortest yield / minimum derivation depth of a nonterminal (-1 if it
+    // derives no finite sentence or is unknown)
+    [[nodiscard]] int minLength(const std::string& nonterminal) const;
+    [[nodiscard]] int minDepth(const std::string& nonterminal) const;
+
+private:
+    struct Rule {
+        std::vector<int> body;          // symbol ids
+        double weight = 1.0;
+        int minLength = -1;             // -1: uses a symbol with no finite yield
+    };
+
+    [[nodiscard]] bool isTerminal(int symbol) const { return symbol < (int)terminalNames.size(); }
+    [[nodiscard]] int symbolMinLength(int symbol) const;
+    bool expand(Xoshiro256& rng, SentenceScratch& scratch) const;
+
+    SentenceOptions opt;
+
+    // Terminals are ids [0, T), nonterminals [T, T + N)
+    std::vector<std::string> terminalNames;
+    std::vector<std::string> nonterminalNames;
+    std::map<std::string, int> ids;
+    int startSymbol = -1;
+
+    std::vector<std::vector<Rule>> rules;   // per nonterminal
+    std::vector<int> shortestLength;        // per nonterminal, -1 if none
+    std::vector<int> closingRule;           // rule index reaching shortestLength
+    std::vector<int> minimumDepth;
+    std::vector<std::pair<int, int>> ruleOf;    // production -> (nonterminal, rule)
+
+    std::vector<std::vector<std::string>> surface;  // per terminal
+};
+
+#endif //MB_SENTENCE_GENERATOR_H
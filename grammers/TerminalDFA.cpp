@@ -0,0 +1,691 @@
+#include "TerminalDFA.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Grammar analysis
+// ---------------------------------------------------------------------------
+
+// The grammar over ids: variables 0..V-1, terminal t as -(t + 1). Only
+// productive, reachable productions are kept, and variables that derive
+// nothing but the empty string are dropped from the bodies, so every
+// symbol left in a body derives some non-empty string.
+struct ReducedGrammar {
+    std::vector<std::string> varNames;
+    std::vector<std::vector<std::vector<int>>> rules;   // per variable
+    int start = -1;                                     // -1: empty language
+};
+
+ReducedGrammar reduce(const CFG& grammar) {
+    ReducedGrammar g;
+    std::map<std::string, int> termIds, varIds;
+    for (const auto& t : grammar.getTerminals()) termIds.emplace(t, (int)termIds.size());
+    auto var = [&](const std::string& name) {
+        auto [it, added] = varIds.emplace(name, (int)g.varNames.size());
+        if (added) {
+            g.varNames.push_back(name);
+            g.rules.emplace_back();
+        }
+        return it->second;
+    };
+    auto symbol = [&](const std::string& name) {
+        auto it = termIds.find(name);
+        return it != termIds.end() ? -(it->second + 1) : var(name);
+    };
+
+    for (const auto& v : grammar.getVariables()) var(v);
+    const int start = var(grammar.getStartSymbol());
+    std::vector<std::vector<std::vector<int>>> all(g.varNames.size());
+    for (const production& p : grammar.getProductions()) {
+        std::vector<int> body;
+        for (const auto& s : p.body) body.push_back(symbol(s));
+        const int head = var(p.lhs);
+        all.resize(g.varNames.size());
+        all[head].push_back(std::move(body));
+    }
+    const size_t V = g.varNames.size();
+    all.resize(V);
+
+    // Productive, then non-empty, both as fixpoints
+    std::vector<uint8_t> productive(V, 0), nonEmpty(V, 0);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t v = 0; v < V; ++v) {
+            if (productive[v]) continue;
+            for (const auto& body : all[v]) {
+                if (std::all_of(body.begin(), body.end(), [&](int s) { return s < 0 || productive[s]; })) {
+                    productive[v] = 1;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    for (size_t v = 0; v < V; ++v) {
+        auto& bodies = all[v];
+        bodies.erase(std::remove_if(bodies.begin(), bodies.end(), [&](const std::vector<int>& body) {
+            return !std::all_of(body.begin(), body.end(), [&](int s) { return s < 0 || productive[s]; });
+        }), bodies.end());
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t v = 0; v < V; ++v) {
+            if (nonEmpty[v]) continue;
+            for (const auto& body : all[v]) {
+                if (std::any_of(body.begin(), body.end(), [&](int s) { return s < 0 || nonEmpty[s]; })) {
+                    nonEmpty[v] = 1;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    for (auto& bodies : all)
+        for (auto& body : bodies)
+            body.erase(std::remove_if(body.begin(), body.end(), [&](int s) { return s >= 0 && !nonEmpty[s]; }),
+                       body.end());
+
+    if (!productive[start]) return g;
+    g.start = start;
+
+    // Reachable from the start symbol
+    std::vector<uint8_t> reached(V, 0);
+    std::vector<int> work{start};
+    reached[start] = 1;
+    while (!work.empty()) {
+        const int v = work.back();
+        work.pop_back();
+        for (const auto& body : all[v])
+            for (int s : body)
+                if (s >= 0 && !reached[s]) {
+                    reached[s] = 1;
+                    work.push_back(s);
+                }
+    }
+    for (size_t v = 0; v < V; ++v)
+        if (reached[v]) g.rules[v] = std::move(all[v]);
+    return g;
+}
+
+// Variable A with A =>* x A y, x and y non-empty; -1 if none. Every body
+// symbol derives something non-empty, so "x non-empty" is "not first".
+int selfEmbedded(const ReducedGrammar& g) {
+    const size_t V = g.varNames.size();
+    std::vector<uint8_t> seen(V * 4);
+    std::vector<std::pair<int, int>> work;
+    for (size_t a = 0; a < V; ++a) {
+        if (g.rules[a].empty()) continue;
+        std::fill(seen.begin(), seen.end(), 0);
+        work.assign(1, {(int)a, 0});
+        while (!work.empty()) {
+            const auto [v, flags] = work.back();
+            work.pop_back();
+            for (const auto& body : g.rules[v]) {
+                for (size_t i = 0; i < body.size(); ++i) {
+                    if (body[i] < 0) continue;
+                    const int f = flags | (i > 0 ? 1 : 0) | (i + 1 < body.size() ? 2 : 0);
+                    if (body[i] == (int)a && f == 3) return (int)a;
+                    if (!seen[(size_t)body[i] * 4 + f]) {
+                        seen[(size_t)body[i] * 4 + f] = 1;
+                        work.emplace_back(body[i], f);
+                    }
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+// Strongly connected components of "body uses variable" (Tarjan), in
+// reverse topological order: a group only uses groups before it
+struct Components {
+    std::vector<int> group;                 // variable -> component, -1 if unused
+    std::vector<std::vector<int>> members;  // component -> variables
+};
+
+Components components(const ReducedGrammar& g) {
+    const int V = (int)g.varNames.size();
+    Components out;
+    out.group.assign(V, -1);
+    std::vector<int> index(V, -1), low(V, 0), stack;
+    std::vector<uint8_t> onStack(V, 0);
+    int counter = 0;
+    std::function<void(int)> visit = [&](int v) {
+        index[v] = low[v] = counter++;
+        stack.push_back(v);
+        onStack[v] = 1;
+        for (const auto& body : g.rules[v]) {
+            for (int s : body) {
+                if (s < 0) continue;
+                if (index[s] < 0) {
+                    visit(s);
+                    low[v] = std::min(low[v], low[s]);
+                } else if (onStack[s]) {
+                    low[v] = std::min(low[v], index[s]);
+                }
+            }
+        }
+        if (low[v] != index[v]) return;
+        out.members.emplace_back();
+        int m;
+        do {
+            m = stack.back();
+            stack.pop_back();
+            onStack[m] = 0;
+            out.group[m] = (int)out.members.size() - 1;
+            out.members.back().push_back(m);
+        } while (m != v);
+    };
+    for (int v = 0; v < V; ++v)
+        if (index[v] < 0 && !g.rules[v].empty()) visit(v);
+    return out;
+}
+
+enum class Recursion { None, Right, Left, Mixed };
+
+// Where the bodies of group `c` use the group: nowhere, only as their last
+// symbol, only as their first, or otherwise
+Recursion recursion(const ReducedGrammar& g, const Components& comps, int c) {
+    bool recursive = comps.members[c].size() > 1, right = true, left = true;
+    auto inGroup = [&](int s) { return s >= 0 && comps.group[s] == c; };
+    for (int m : comps.members[c]) {
+        for (const auto& body : g.rules[m]) {
+            const size_t uses = (size_t)std::count_if(body.begin(), body.end(), inGroup);
+            recursive |= uses > 0;
+            right &= uses == 0 || (uses == 1 && inGroup(body.back()));
+            left &= uses == 0 || (uses == 1 && inGroup(body.front()));
+        }
+    }
+    if (!recursive) return Recursion::None;
+    return right ? Recursion::Right : left ? Recursion::Left : Recursion::Mixed;
+}
+
+// ---------------------------------------------------------------------------
+// NFA
+// ---------------------------------------------------------------------------
+
+struct Nfa {
+    struct Edge {
+        int label;              // terminal id, -1: epsilon
+        int to;
+    };
+    std::vector<std::vector<Edge>> out;
+    std::vector<uint8_t> accepting;
+    size_t limit;
+
+    explicit Nfa(size_t maxStates) : limit(maxStates) {}
+
+    int add() {
+        if (out.size() >= limit)
+            throw std::invalid_argument("TerminalDFA: more than " + std::to_string(limit) + " NFA states");
+        out.emplace_back();
+        accepting.push_back(0);
+        return (int)out.size() - 1;
+    }
+    void edge(int from, int label, int to) { out[from].push_back({label, to}); }
+};
+
+// Inlines every variable use as a fresh copy of its sub-automaton. A
+// recursive group is one loop per copy: right-recursive groups get a state
+// "about to read member m", left-recursive ones a state "just read m".
+class GrammarNfaBuilder {
+public:
+    GrammarNfaBuilder(const ReducedGrammar& grammar, Nfa& nfa)
+        : g(grammar), nfa(nfa), comps(components(grammar)) {
+        for (size_t c = 0; c < comps.members.size(); ++c) {
+            side.push_back(recursion(g, comps, (int)c));
+            if (side.back() == Recursion::Mixed)
+                throw std::invalid_argument("TerminalDFA: recursion through " + g.varNames[comps.members[c][0]] +
+                                            " is neither right- nor left-linear");
+        }
+    }
+
+    // Paths entry -> exit spelling L(v)
+    void variable(int v, int entry, int exit) {
+        const int c = comps.group[v];
+        if (side[c] == Recursion::None) {
+            for (const auto& body : g.rules[v]) chain(entry, body.data(), body.data() + body.size(), exit);
+            return;
+        }
+
+        auto inGroup = [&](int s) { return s >= 0 && comps.group[s] == c; };
+        std::map<int, int> at;      // member -> its state in this copy
+        for (int m : comps.members[c]) at[m] = nfa.add();
+        if (side[c] == Recursion::Right) {
+            nfa.edge(entry, -1, at[v]);
+            for (int m : comps.members[c]) {
+                for (const auto& body : g.rules[m]) {
+                    const int* b = body.data();
+                    if (!body.empty() && inGroup(body.back()))
+                        chain(at[m], b, b + body.size() - 1, at[body.back()]);
+                    else
+                        chain(at[m], b, b + body.size(), exit);
+                }
+            }
+        } else {
+            for (int m : comps.members[c]) {
+                for (const auto& body : g.rules[m]) {
+                    const int* b = body.data();
+                    if (!body.empty() && inGroup(body.front()))
+                        chain(at[body.front()], b + 1, b + body.size(), at[m]);
+                    else
+                        chain(entry, b, b + body.size(), at[m]);
+                }
+            }
+            nfa.edge(at[v], -1, exit);
+        }
+    }
+
+private:
+    void chain(int from, const int* begin, const int* end, int to) {
+        if (begin == end) {
+            nfa.edge(from, -1, to);
+            return;
+        }
+        for (const int* s = begin; s != end; ++s) {
+            const int next = s + 1 == end ? to : nfa.add();
+            if (*s < 0) nfa.edge(from, -*s - 1, next);
+            else variable(*s, from, next);
+            from = next;
+        }
+    }
+
+    const ReducedGrammar& g;
+    Nfa& nfa;
+    Components comps;
+    std::vector<Recursion> side;    // per component
+};
+
+// ---------------------------------------------------------------------------
+// Subset construction and minimization
+// ---------------------------------------------------------------------------
+
+// Writes the trimmed, minimized DFA of `nfa` from `start` (DFA state 0,
+// the rest in breadth-first order) and returns its state count
+int determinize(const Nfa& nfa, int start, int numTerminals, const DfaCompileOptions& opt,
+                DfaCompileStats* stats, std::vector<int32_t>& table, std::vector<uint8_t>& finals) {
+    const size_t T = (size_t)numTerminals;
+    std::vector<uint32_t> mark(nfa.out.size(), 0);
+    uint32_t generation = 0;
+
+    std::map<std::vector<int>, int> ids;
+    std::vector<std::vector<int>> subsets;
+    std::vector<uint8_t> acc;
+    auto intern = [&](std::vector<int> set) {
+        // Epsilon closure
+        ++generation;
+        for (int s : set) mark[s] = generation;
+        for (size_t k = 0; k < set.size(); ++k)
+            for (const Nfa::Edge& e : nfa.out[set[k]])
+                if (e.label < 0 && mark[e.to] != generation) {
+                    mark[e.to] = generation;
+                    set.push_back(e.to);
+                }
+        std::sort(set.begin(), set.end());
+
+        auto [it, added] = ids.emplace(set, (int)subsets.size());
+        if (added) {
+            if (subsets.size() >= opt.maxDfaStates)
+                throw std::invalid_argument("TerminalDFA: more than " + std::to_string(opt.maxDfaStates) +
+                                            " DFA states");
+            acc.push_back(std::any_of(set.begin(), set.end(), [&](int s) { return nfa.accepting[s] != 0; }));
+            subsets.push_back(std::move(set));
+        }
+        return it->second;
+    };
+
+    std::vector<int32_t> raw;
+    std::vector<std::vector<int>> moves(T);
+    intern({start});
+    for (size_t d = 0; d < subsets.size(); ++d) {
+        for (auto& m : moves) m.clear();
+        for (int s : subsets[d])
+            for (const Nfa::Edge& e : nfa.out[s])
+                if (e.label >= 0) moves[e.label].push_back(e.to);
+        raw.resize((d + 1) * T, -1);
+        for (size_t a = 0; a < T; ++a)
+            if (!moves[a].empty()) raw[d * T + a] = intern(moves[a]);
+    }
+    const size_t n = subsets.size();
+
+    // Trim: keep the states that can still reach acceptance
+    std::vector<std::vector<int>> back(n);
+    for (size_t d = 0; d < n; ++d)
+        for (size_t a = 0; a < T; ++a)
+            if (raw[d * T + a] >= 0) back[raw[d * T + a]].push_back((int)d);
+    std::vector<uint8_t> live(n, 0);
+    std::vector<int> work;
+    for (size_t d = 0; d < n; ++d)
+        if (acc[d]) {
+            live[d] = 1;
+            work.push_back((int)d);
+        }
+    while (!work.empty()) {
+        const int d = work.back();
+        work.pop_back();
+        for (int p : back[d])
+            if (!live[p]) {
+                live[p] = 1;
+                work.push_back(p);
+            }
+    }
+    for (int32_t& t : raw)
+        if (t >= 0 && !live[t]) t = -1;
+
+    // Moore refinement; -1 (dead) is its own class
+    std::vector<int> cls(n);
+    for (size_t d = 0; d < n; ++d) cls[d] = acc[d];
+    size_t classes = 0;
+    while (true) {
+        std::map<std::vector<int>, int> signatures;
+        std::vector<int> refined(n, -1);
+        std::vector<int> key(T + 1);
+        for (size_t d = 0; d < n; ++d) {
+            if (!live[d] && d != 0) continue;
+            key[0] = cls[d];
+            for (size_t a = 0; a < T; ++a) key[a + 1] = raw[d * T + a] < 0 ? -1 : cls[raw[d * T + a]];
+            refined[d] = signatures.emplace(key, (int)signatures.size()).first->second;
+        }
+        cls.swap(refined);
+        if (signatures.size() == classes) break;
+        classes = signatures.size();
+    }
+
+    // Renumber classes breadth-first from the start state
+    std::vector<int> order(classes, -1), representative(classes, -1);
+    for (size_t d = 0; d < n; ++d)
+        if (cls[d] >= 0 && representative[cls[d]] < 0) representative[cls[d]] = (int)d;
+    std::vector<int> queue{cls[0]};
+    order[cls[0]] = 0;
+    for (size_t k = 0; k < queue.size(); ++k) {
+        const int d = representative[queue[k]];
+        for (size_t a = 0; a < T; ++a) {
+            const int t = raw[(size_t)d * T + a];
+            if (t >= 0 && order[cls[t]] < 0) {
+                order[cls[t]] = (int)queue.size();
+                queue.push_back(cls[t]);
+            }
+        }
+    }
+
+    const size_t states = queue.size();
+    table.assign(states * T, -1);
+    finals.assign(states, 0);
+    for (size_t k = 0; k < states; ++k) {
+        const int d = representative[queue[k]];
+        finals[k] = acc[d];
+        for (size_t a = 0; a < T; ++a) {
+            const int t = raw[(size_t)d * T + a];
+            if (t >= 0) table[k * T + a] = order[cls[t]];
+        }
+    }
+
+    if (stats) {
+        stats->nfaStates = nfa.out.size();
+        stats->subsetStates = n;
+        stats->states = states;
+    }
+    return (int)states;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+std::string findSelfEmbedding(const CFG& grammar) {
+    const ReducedGrammar g = reduce(grammar);
+    const int v = selfEmbedded(g);
+    return v < 0 ? "" : g.varNames[v];
+}
+
+CFG regularApproximation(const CFG& grammar) {
+    const ReducedGrammar g = reduce(grammar);
+    const auto& terminals = grammar.getTerminals();
+    CFG out;
+    out.setTerminals(terminals);
+    out.setStartSymbol(grammar.getStartSymbol());
+    if (g.start < 0) {
+        out.setVariables({grammar.getStartSymbol()});
+        return out;
+    }
+
+    const Components comps = components(g);
+    std::vector<uint8_t> rewrite(comps.members.size(), 0);
+    for (size_t c = 0; c < comps.members.size(); ++c)
+        rewrite[c] = recursion(g, comps, (int)c) == Recursion::Mixed;
+
+    // A' = "the rest of a body that used A", named apart from every symbol
+    std::set<std::string> names(terminals.begin(), terminals.end());
+    names.insert(g.varNames.begin(), g.varNames.end());
+    std::vector<std::string> primed(g.varNames.size());
+    for (size_t v = 0; v < g.varNames.size(); ++v) {
+        if (g.rules[v].empty() || !rewrite[comps.group[v]]) continue;
+        primed[v] = g.varNames[v];
+        do primed[v] += "'"; while (!names.insert(primed[v]).second);
+    }
+
+    auto name = [&](int s) { return s < 0 ? terminals[-s - 1] : g.varNames[s]; };
+    std::vector<std::string> variables;
+    std::vector<production> prods;
+    for (size_t v = 0; v < g.varNames.size(); ++v) {
+        if (g.rules[v].empty()) continue;
+        variables.push_back(g.varNames[v]);
+        const int c = comps.group[v];
+        if (!rewrite[c]) {
+            for (const auto& body : g.rules[v]) {
+                std::vector<std::string> symbols;
+                for (int s : body) symbols.push_back(name(s));
+                prods.emplace_back(g.varNames[v], symbols);
+            }
+            continue;
+        }
+
+        // A -> a0 B1 a1 ... Bm am  becomes  A -> a0 B1, B1' -> a1 B2, ...,
+        // Bm' -> am A'; every use of the group is now a tail call
+        variables.push_back(primed[v]);
+        prods.emplace_back(primed[v], std::vector<std::string>{});
+        for (const auto& body : g.rules[v]) {
+            std::string head = g.varNames[v];
+            std::vector<std::string> symbols;
+            for (int s : body) {
+                symbols.push_back(name(s));
+                if (s >= 0 && comps.group[s] == c) {
+                    prods.emplace_back(head, symbols);
+                    head = primed[s];
+                    symbols.clear();
+                }
+            }
+            symbols.push_back(primed[v]);
+            prods.emplace_back(head, symbols);
+        }
+    }
+    out.setVariables(variables);
+    out.setProductions(prods);
+    return out;
+}
+
+void TerminalDFA::setAlphabet(std::vector<std::string> alphabet) {
+    terminals = std::move(alphabet);
+    for (const auto& t : terminals) terminalIds.emplace(t, (int)terminalIds.size());
+    numTerminals = (int)terminals.size();
+}
+
+TerminalDFA TerminalDFA::fromGrammar(const CFG& grammar, const DfaCompileOptions& options,
+                                     DfaCompileStats* stats) {
+    const ReducedGrammar g = reduce(grammar);
+    const int embedded = selfEmbedded(g);
+    if (embedded >= 0)
+        throw std::invalid_argument("TerminalDFA: grammar is self-embedding at " + g.varNames[embedded]);
+
+    Nfa nfa(options.maxNfaStates);
+    const int entry = nfa.add();
+    const int exit = nfa.add();
+    nfa.accepting[exit] = 1;
+    if (g.start >= 0) GrammarNfaBuilder(g, nfa).variable(g.start, entry, exit);
+
+    TerminalDFA dfa;
+    dfa.setAlphabet(grammar.getTerminals());
+    dfa.numStates = determinize(nfa, entry, dfa.numTerminals, options, stats, dfa.table, dfa.finals);
+    return dfa;
+}
+
+TerminalDFA TerminalDFA::fromPda(const PDA& pda, const DfaCompileOptions& options, DfaCompileStats* stats) {
+    if (pda.getStartState().empty() || pda.getStartStack().empty())
+        throw std::invalid_argument("TerminalDFA: PDA has no start state or start stack symbol");
+
+    TerminalDFA dfa;
+    std::vector<std::string> alphabet = pda.getAlphabet();
+    for (const transition& t : pda.getTransitions())
+        if (!t.inputSymbol.empty() && std::find(alphabet.begin(), alphabet.end(), t.inputSymbol) == alphabet.end())
+            alphabet.push_back(t.inputSymbol);
+    dfa.setAlphabet(std::move(alphabet));
+
+    std::map<std::string, int> stateIds, symbolIds;
+    std::vector<std::string> stateNames;
+    auto intern = [](std::map<std::string, int>& ids, const std::string& name) {
+        return ids.emplace(name, (int)ids.size()).first->second;
+    };
+    for (const auto& s : pda.getStates()) intern(stateIds, s);
+    for (const auto& g : pda.getStackAlphabet()) intern(symbolIds, g);
+    const int startState = intern(stateIds, pda.getStartState());
+    const int startSymbol = intern(symbolIds, pda.getStartStack());
+
+    struct Move {
+        int to;
+        int input;              // -1: epsilon
+        std::vector<int> push;  // bottom of the pushed block first
+    };
+    std::map<std::pair<int, int>, std::vector<Move>> moves;
+    for (const transition& t : pda.getTransitions()) {
+        Move m{intern(stateIds, t.toState), t.inputSymbol.empty() ? -1 : dfa.terminalId(t.inputSymbol), {}};
+        for (auto it = t.stackPush.rbegin(); it != t.stackPush.rend(); ++it) m.push.push_back(intern(symbolIds, *it));
+        moves[{intern(stateIds, t.fromState), intern(symbolIds, t.stackTop)}].push_back(std::move(m));
+    }
+    stateNames.resize(stateIds.size());
+    for (const auto& [name, id] : stateIds) stateNames[id] = name;
+
+    // One NFA state per configuration: state, then the stack bottom first
+    Nfa nfa(options.maxNfaStates);
+    std::map<std::vector<int>, int> configs;
+    std::vector<std::vector<int>> pending;
+    auto config = [&](std::vector<int> key) {
+        auto [it, added] = configs.emplace(key, 0);
+        if (added) {
+            it->second = nfa.add();
+            nfa.accepting[it->second] = key.size() == 1;
+            pending.push_back(std::move(key));
+        }
+        return it->second;
+    };
+    const int start = config({startState, startSymbol});
+    while (!pending.empty()) {
+        const std::vector<int> key = std::move(pending.back());
+        pending.pop_back();
+        if (key.size() == 1) continue;
+
+        const int from = configs.at(key);
+        auto found = moves.find({key[0], key.back()});
+        if (found == moves.end()) continue;
+        for (const Move& m : found->second) {
+            std::vector<int> next(key.begin(), key.end() - 1);
+            next[0] = m.to;
+            next.insert(next.end(), m.push.begin(), m.push.end());
+            if (next.size() - 1 > options.maxStackDepth)
+                throw std::invalid_argument("TerminalDFA: PDA stack grows past " +
+                                            std::to_string(options.maxStackDepth) + " in state " +
+                                            stateNames[m.to]);
+            const int to = config(std::move(next));
+            nfa.edge(from, m.input, to);
+        }
+    }
+
+    dfa.numStates = determinize(nfa, start, dfa.numTerminals, options, stats, dfa.table, dfa.finals);
+    return dfa;
+}
+
+int TerminalDFA::terminalId(const std::string& name) const {
+    auto it = terminalIds.find(name);
+    return it == terminalIds.end() ? -1 : it->second;
+}
+
+// ---------------------------------------------------------------------------
+// Execution
+// ---------------------------------------------------------------------------
+
+bool TerminalDFA::accepts(const std::vector<int>& input, int* errorIndex) const {
+    const int32_t* t = table.data();
+    const size_t n = input.size();
+    int32_t s = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int a = input[i];
+        if ((unsigned)a >= (unsigned)numTerminals ||
+            (s = t[(size_t)s * numTerminals + a]) < 0) {
+            if (errorIndex) *errorIndex = (int)i;
+            return false;
+        }
+    }
+    if (finals[s]) return true;
+    if (errorIndex) *errorIndex = (int)n;
+    return false;
+}
+
+void TerminalDFA::acceptsMany(const std::vector<int>* const* inputs, size_t count, uint8_t* accepted,
+                              int* errorIndex) const {
+    struct Lane {
+        const int* p;
+        const int* begin;
+        const int* end;
+        int32_t state;
+        size_t index;           // into inputs
+    };
+
+    const int32_t* t = table.data();
+    Lane lanes[LANES];
+    size_t active = 0;
+    size_t next = 0;
+    auto load = [&](Lane& lane) {
+        const std::vector<int>& in = *inputs[next];
+        lane = {in.data(), in.data(), in.data() + in.size(), 0, next};
+        next++;
+    };
+    for (; active < LANES && next < count; ++active) load(lanes[active]);
+
+    while (active > 0) {
+        for (size_t k = 0; k < active;) {
+            Lane& lane = lanes[k];
+            bool done = lane.p == lane.end;
+            if (!done) {
+                const int a = *lane.p;
+                const int32_t s = (unsigned)a < (unsigned)numTerminals ? t[(size_t)lane.state * numTerminals + a] : -1;
+                if (s >= 0) {
+                    lane.state = s;
+                    lane.p++;
+                } else {
+                    lane.state = -1;
+                    done = true;
+                }
+            }
+            if (!done) {
+                ++k;
+                continue;
+            }
+
+            const bool ok = lane.state >= 0 && finals[lane.state];
+            accepted[lane.index] = ok;
+            if (errorIndex) errorIndex[lane.index] = ok ? -1 : (int)(lane.p - lane.begin);
+            if (next < count) {
+                load(lane);
+                ++k;
+            } else {
+                lane = lanes[--active];     // the moved lane takes its turn now
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+// Exact compilation of regular grammars and bounded-stack PDAs into a
+// minimized DFA over terminal ids.
+//
+
+#ifndef MB_TERMINALDFA_H
+#define MB_TERMINALDFA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CFG.h"
+#include "PDA.h"
+
+struct DfaCompileOptions {
+    // Work limits; a compilation that would exceed one throws
+    // std::invalid_argument instead of running out of memory
+    size_t maxNfaStates = 1 << 16;
+    size_t maxDfaStates = 1 << 14;
+    // fromPda(): a reachable configuration whose stack would grow past
+    // this means the PDA is not bounded (or not within this depth)
+    uint32_t maxStackDepth = 64;
+};
+
+// Sizes of one compilation
+struct DfaCompileStats {
+    size_t nfaStates = 0;       // Thompson-style NFA, or PDA configurations
+    size_t subsetStates = 0;    // subset construction, before minimization
+    size_t states = 0;          // minimized, dead state dropped
+};
+
+// A variable A with A =>* x A y for non-empty x and y, i.e. where the
+// grammar is self-embedding (and, unless that can be rewritten away, not
+// regular). Only productive, reachable variables count; "" if none.
+std::string findSelfEmbedding(const CFG& grammar);
+
+// Regular superset of L(grammar) (Mohri and Nederhof): every recursive
+// group that fromGrammar() cannot take as it is gets its bodies split at
+// each use of the group, A -> a B b turning into A -> a B, B' -> b A',
+// with A' -> epsilon. Nested brackets lose their matching, nothing else
+// changes: a grammar fromGrammar() accepts comes back with its language.
+// Same terminals, in the same order.
+CFG regularApproximation(const CFG& grammar);
+
+// Table of numStates x numTerminals next states, -1 where no accepting
+// state is reachable any more. Since every remaining state can still reach
+// acceptance, the first -1 is the first terminal no completion explains,
+// the same index an LR parser reports. accepts() is one load per terminal.
+class TerminalDFA {
+public:
+    // Variables are inlined into a Thompson NFA; each strongly connected
+    // group of recursive variables becomes one loop, which needs the group
+    // to recurse only at the right end of its bodies or only at the left.
+    // Columns follow grammar.getTerminals(), so ids match SLR::terminalId().
+    // Throws std::invalid_argument naming the variable if the grammar is
+    // self-embedding or a recursive group mixes both sides.
+    static TerminalDFA fromGrammar(const CFG& grammar, const DfaCompileOptions& options = {},
+                                   DfaCompileStats* stats = nullptr);
+
+    // Explores every reachable (state, stack) configuration; the empty
+    // stack accepts, as in PDAExecutor. Columns follow pda.getAlphabet().
+    // Throws std::invalid_argument if a stack outgrows maxStackDepth.
+    static TerminalDFA fromPda(const PDA& pda, const DfaCompileOptions& options = {},
+                               DfaCompileStats* stats = nullptr);
+
+    // `input` holds ids from terminalId(); -1 (unknown) is rejected.
+    // On rejection `errorIndex` is the first position that cannot be
+    // extended to an accepted input (input.size() if it ran out).
+    [[nodiscard]] bool accepts(const std::vector<int>& input, int* errorIndex = nullptr) const;
+
+    // accepts() over `count` inputs at once: LANES of them are walked
+    // round-robin, one terminal per turn, and a lane that finishes takes
+    // the next input. One input's loads form a serial chain; interleaving
+    // independent chains lets them overlap. accepted[i] and errorIndex[i]
+    // (-1 when accepted; the array may be null) are what accepts() gives
+    // for *inputs[i].
+    static constexpr size_t LANES = 16;
+    void acceptsMany(const std::vector<int>* const* inputs, size_t count, uint8_t* accepted,
+                     int* errorIndex = nullptr) const;
+
+    [[nodiscard]] int terminalId(const std::string& name) const;
+    [[nodiscard]] const std::string& terminalName(int id) const { return terminals[id]; }
+    [[nodiscard]] int terminalCount() const { return numTerminals; }
+    [[nodiscard]] int stateCount() const { return numStates; }
+
+    // Raw table access for table walks outside accepts(); start state is 0
+    [[nodiscard]] int next(int state, int terminal) const {
+        return table[(size_t)state * numTerminals + terminal];
+    }
+    [[nodiscard]] bool accepting(int state) const { return finals[state] != 0; }
+
+private:
+    TerminalDFA() = default;
+    void setAlphabet(std::vector<std::string> alphabet);
+
+    std::vector<std::string> terminals;
+    std::map<std::string, int> terminalIds;
+    int numStates = 0;
+    int numTerminals = 0;
+    std::vector<int32_t> table;
+    std::vector<uint8_t> finals;
+};
+
+#endif //MB_TERMINALDFA_H
@@ -0,0 +1,172 @@
+#include "CoverageGenerator.h"
+
+#include <algorithm>
+
+double CoverageReport::ratio() const {
+    const size_t total = productions.total + states.total + cells.total;
+    const size_t covered = productions.covered + states.covered + cells.covered;
+    return total ? (double)covered / (double)total : 1.0;
+}
+
+CoverageGenerator::CoverageGenerator(const CFG& cfg, const SLR& slr, CoverageOptions options)
+    : cfg(cfg), slr(slr), opt(std::move(options)), generator(cfg, opt.sentences)
+{
+    numProductions = cfg.getProductions().size();
+    numStates = (size_t)slr.stateCount();
+    numCols = (size_t)slr.eosId() + 1;
+
+    cellItem.assign(numStates * numCols, -1);
+    for (size_t s = 0; s < numStates; ++s) {
+        for (size_t t = 0; t < numCols; ++t) {
+            if (!slr.hasAction((int)s, (int)t)) continue;
+            cellItem[s * numCols + t] = (int)(numProductions + numStates + cellProduction.size());
+            cellProduction.push_back(slr.reduceProduction((int)s, (int)t));
+            cellTerminal.push_back((int)t);
+        }
+    }
+
+    for (const std::string& name : generator.terminals())
+        slrTerminal.push_back(slr.terminalId(name));
+}
+
+bool CoverageGenerator::itemsOf(const std::vector<int>& sentence, std::vector<int>& items) {
+    std::vector<int> ids;
+    ids.reserve(sentence.size());
+    for (int t : sentence) ids.push_back(slrTerminal[t]);
+
+    cells.clear();
+    reductions.clear();
+    if (!slr.trace(ids, stack, cells, reductions)) return false;
+
+    items.clear();
+    for (int p : reductions) items.push_back(p);
+    for (int c : cells) {
+        items.push_back((int)numProductions + c / (int)numCols);
+        items.push_back(cellItem[c]);
+    }
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+    return true;
+}
+
+// Re-weights every production by how much uncovered ground it leads to:
+// uncovered itself, reduced by an uncovered cell, or carrying a terminal
+// that an uncovered shift still waits for
+void CoverageGenerator::steer(const std::vector<char>& covered) {
+    const size_t cellBase = numProductions + numStates;
+    std::vector<char> wantedTerminal(numCols, 0);
+    std::vector<char> wantedReduce(numProductions, 0);
+    for (size_t c = 0; c < cellProduction.size(); ++c) {
+        if (covered[cellBase + c]) continue;
+        if (cellProduction[c] >= 0) wantedReduce[cellProduction[c]] = 1;
+        else wantedTerminal[cellTerminal[c]] = 1;
+    }
+
+    const auto& prods = cfg.getProductions();
+    for (size_t p = 0; p < numProductions; ++p) {
+        double w = 1.0;
+        if (!covered[p]) w += opt.boost;
+        if (wantedReduce[p]) w += opt.boost / 2;
+        for (const std::string& sym : prods[p].body) {
+            const int t = slr.terminalId(sym);
+            if (t >= 0 && wantedTerminal[t]) {
+                w += opt.boost / 4;
+                break;
+            }
+        }
+        generator.setWeight(p, w);
+    }
+}
+
+CoverageCorpus CoverageGenerator::run() {
+    const size_t numItems = numProductions + numStates + cellProduction.size();
+    std::vector<char> covered(numItems, 0);
+    size_t coveredCount = 0;
+
+    std::vector<std::vector<int>> kept;
+    std::vector<std::vector<int>> keptItems;
+
+    Xoshiro256 rng(opt.sentences.seed);
+    SentenceScratch scratch;
+    std::vector<int> sentence, items, best, bestItems;
+
+    CoverageReport report;
+    size_t stall = 0;
+    for (; report.rounds < opt.maxRounds; ++report.rounds) {
+        if ((double)coveredCount >= opt.target * (double)numItems || stall >= opt.stallRounds) break;
+        steer(covered);
+
+        size_t bestGain = 0;
+        for (size_t c = 0; c < std::max<size_t>(1, opt.candidatesPerRound); ++c) {
+            report.candidates++;
+            if (!generator.generate(rng, scratch, sentence) || !itemsOf(sentence, items)) continue;
+
+            size_t gain = 0;
+            for (int it : items) gain += !covered[it];
+            // Ties go to the shorter sentence: a smaller corpus runs faster
+            if (gain > bestGain || (gain == bestGain && gain > 0 && sentence.size() < best.size())) {
+                bestGain = gain;
+                best.swap(sentence);
+                bestItems.swap(items);
+            }
+        }
+
+        if (bestGain == 0) {
+            stall++;
+            continue;
+        }
+        stall = 0;
+        for (int it : bestItems) {
+            coveredCount += !covered[it];
+            covered[it] = 1;
+        }
+        kept.push_back(best);
+        keptItems.push_back(bestItems);
+    }
+    report.kept = kept.size();
+
+    // Prune: drop sentences (latest, i.e. least valuable, first) whose items
+    // are all covered by another kept sentence
+    std::vector<int> count(numItems, 0);
+    for (const auto& list : keptItems)
+        for (int it : list) count[it]++;
+
+    std::vector<char> keep(kept.size(), 1);
+    for (size_t i = kept.size(); i-- > 0;) {
+        bool redundant = true;
+        for (int it : keptItems[i]) redundant &= count[it] >= 2;
+        if (!redundant) continue;
+        keep[i] = 0;
+        for (int it : keptItems[i]) count[it]--;
+    }
+
+    CoverageCorpus corpus;
+    for (size_t i = 0; i < kept.size(); ++i) {
+        if (!keep[i]) continue;
+        std::string text;
+        generator.render(kept[i], rng, text);
+        corpus.sentences.push_back(std::move(kept[i]));
+        corpus.texts.push_back(std::move(text));
+    }
+
+    // Report
+    const auto& prods = cfg.getProductions();
+    report.productions.total = numProductions;
+    report.states.total = numStates;
+    report.cells.total = cellProduction.size();
+    for (size_t i = 0; i < numItems; ++i) {
+        if (!covered[i]) {
+            if (i < numProductions) {
+                std::string line = prods[i].lhs + " ->";
+                for (const std::string& sym : prods[i].body) line += " " + sym;
+                report.uncoveredProductions.push_back(line);
+            }
+            continue;
+        }
+        if (i < numProductions) report.productions.covered++;
+        else if (i < numProductions + numStates) report.states.covered++;
+        else report.cells.covered++;
+    }
+    corpus.report = std::move(report);
+    return corpus;
+}
@@ -0,0 +1,88 @@
+//
+// Coverage-guided corpus generation: random sentences steered towards the
+// productions, SLR states and ACTION cells no earlier sentence reached,
+// kept only when they add coverage, then pruned to an irredundant set.
+//
+
+#ifndef MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_COVERAGEGENERATOR_H
+#define MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_COVERAGEGENERATOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "SLR.h"
+#include "../grammers/SentenceGenerator.h"
+
+struct CoverageOptions {
+    // Length bounds, lexemes and seed of the underlying sentences; weights
+    // are managed by the generator
+    SentenceOptions sentences;
+
+    // Stop once this fraction of all items (productions + states + non-empty
+    // ACTION cells) is covered, or after stallRounds rounds without progress.
+    // SLR lookaheads over-approximate, so some cells may be unreachable.
+    double target = 1.0;
+    size_t candidatesPerRound = 32;     // best candidate of each round is kept
+    size_t stallRounds = 200;
+    size_t maxRounds = 10000;
+
+    // Extra weight for productions that lead to uncovered items
+    double boost = 8.0;
+};
+
+struct CoverageCount {
+    size_t covered = 0;
+    size_t total = 0;
+
+    [[nodiscard]] double ratio() const { return total ? (double)covered / (double)total : 1.0; }
+};
+
+struct CoverageReport {
+    CoverageCount productions;
+    CoverageCount states;
+    CoverageCount cells;                // non-empty ACTION cells
+    size_t rounds = 0;
+    size_t candidates = 0;              // sentences generated in total
+    size_t kept = 0;                    // before pruning
+    std::vector<std::string> uncoveredProductions;  // "Head -> body"
+
+    [[nodiscard]] double ratio() const;
+};
+
+struct CoverageCorpus {
+    std::vector<std::vector<int>> sentences;    // SentenceGenerator::terminals() ids
+    std::vector<std::string> texts;             // surface form of each sentence
+    CoverageReport report;
+};
+
+class CoverageGenerator {
+public:
+    // `slr` must have been built from `cfg`
+    CoverageGenerator(const CFG& cfg, const SLR& slr, CoverageOptions options = {});
+
+    [[nodiscard]] CoverageCorpus run();
+
+private:
+    // Sorted, unique item ids a sentence covers; false if the SLR rejects it
+    bool itemsOf(const std::vector<int>& sentence, std::vector<int>& items);
+    void steer(const std::vector<char>& covered);
+
+    const CFG& cfg;
+    const SLR& slr;
+    CoverageOptions opt;
+    SentenceGenerator generator;
+
+    // Items: productions [0, P), states [P, P + S), cells [P + S, P + S + C)
+    size_t numProductions = 0;
+    size_t numStates = 0;
+    size_t numCols = 0;
+    std::vector<int> cellItem;          // state * numCols + terminal -> item, -1 if empty
+    std::vector<int> cellProduction;    // cell item - P - S -> reduced production, -1 if shift/accept
+    std::vector<int> cellTerminal;      // cell item - P - S -> terminal (SLR id)
+    std::vector<int> slrTerminal;       // generator terminal id -> SLR terminal id
+
+    std::vector<int> stack, cells, reductions;
+};
+
+#endif // MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_COVERAGEGENERATOR_H
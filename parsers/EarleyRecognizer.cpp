@@ -0,0 +1,131 @@
+#include "EarleyRecognizer.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+EarleyRecognizer::EarleyRecognizer(const CFG& cfg) {
+    const auto& productions = cfg.getProductions();
+
+    // Nonterminals: declared variables and every production head
+    std::set<std::string> heads(cfg.getVariables().begin(), cfg.getVariables().end());
+    for (const production& p : productions) heads.insert(p.lhs);
+
+    // Terminals: declared ones first, then any other body symbol
+    std::vector<std::string> order;
+    auto addTerminal = [&](const std::string& name) {
+        if (heads.count(name) || terminalIds.count(name)) return;
+        terminalIds[name] = (int)order.size();
+        order.push_back(name);
+    };
+    for (const std::string& t : cfg.getTerminals()) addTerminal(t);
+    for (const production& p : productions)
+        for (const std::string& sym : p.body) addTerminal(sym);
+    numTerminals = (int)order.size();
+
+    std::map<std::string, int> nonterminalIds;
+    for (const std::string& h : heads) nonterminalIds[h] = (int)nonterminalIds.size();
+
+    rulesOf.assign(nonterminalIds.size(), {});
+    for (const production& p : productions) {
+        Rule r;
+        r.lhs = nonterminalIds.at(p.lhs);
+        for (const std::string& sym : p.body) {
+            auto t = terminalIds.find(sym);
+            r.body.push_back(t != terminalIds.end() ? t->second : numTerminals + nonterminalIds.at(sym));
+        }
+        rulesOf[r.lhs].push_back((uint32_t)rules.size());
+        rules.push_back(std::move(r));
+    }
+
+    nullable.assign(nonterminalIds.size(), 0);
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (const Rule& r : rules) {
+            if (nullable[r.lhs]) continue;
+            const bool empty = std::all_of(r.body.begin(), r.body.end(), [&](int sym) {
+                return sym >= numTerminals && nullable[sym - numTerminals];
+            });
+            if (empty) nullable[r.lhs] = changed = true;
+        }
+    }
+
+    auto start = nonterminalIds.find(cfg.getStartSymbol());
+    if (start == nonterminalIds.end() || rulesOf[start->second].empty())
+        throw std::invalid_argument("EarleyRecognizer: start symbol '" + cfg.getStartSymbol() + "' has no productions");
+    startSymbol = start->second;
+}
+
+int EarleyRecognizer::terminalId(const std::string& name) const {
+    auto it = terminalIds.find(name);
+    return it == terminalIds.end() ? -1 : it->second;
+}
+
+// ---------------------------------------------------------------------------
+// Recognition
+// ---------------------------------------------------------------------------
+
+void EarleyRecognizer::add(std::vector<EarleyScratch::Item>& set, EarleyScratch::Item item) {
+    if (std::find(set.begin(), set.end(), item) == set.end())
+        set.push_back(item);
+}
+
+// Predict / scan / complete over one item set per position. Predicting a
+// nullable nonterminal also steps over it (Aycock & Horspool), so empty
+// completions never have to revisit a set that is still growing.
+bool EarleyRecognizer::accepts(const std::vector<int>& terminals, EarleyScratch& scratch) const {
+    const size_t n = terminals.size();
+    auto& sets = scratch.sets;
+    if (sets.size() < n + 1) sets.resize(n + 1);
+    for (size_t i = 0; i <= n; ++i) sets[i].clear();
+
+    for (uint32_t r : rulesOf[startSymbol]) sets[0].push_back({r, 0, 0});
+
+    for (size_t i = 0; i <= n; ++i) {
+        const int next = i < n ? terminals[i] : -1;
+        if (i < n && (next < 0 || next >= numTerminals)) return false;
+
+        for (size_t k = 0; k < sets[i].size(); ++k) {
+            const EarleyScratch::Item item = sets[i][k];
+            const Rule& rule = rules[item.rule];
+
+            // Complete
+            if (item.dot == rule.body.size()) {
+                const int lhs = numTerminals + rule.lhs;
+                for (size_t j = 0; j < sets[item.origin].size(); ++j) {
+                    const EarleyScratch::Item waiting = sets[item.origin][j];
+                    const Rule& w = rules[waiting.rule];
+                    if (waiting.dot < w.body.size() && w.body[waiting.dot] == lhs)
+                        add(sets[i], {waiting.rule, waiting.dot + 1, waiting.origin});
+                }
+                continue;
+            }
+
+            const int sym = rule.body[item.dot];
+
+            // Scan
+            if (sym < numTerminals) {
+                if (sym == next) add(sets[i + 1], {item.rule, item.dot + 1, item.origin});
+                continue;
+            }
+
+            // Predict
+            const int a = sym - numTerminals;
+            for (uint32_t r : rulesOf[a]) add(sets[i], {r, 0, (uint32_t)i});
+            if (nullable[a]) add(sets[i], {item.rule, item.dot + 1, item.origin});
+        }
+
+        if (i < n && sets[i + 1].empty()) return false;
+    }
+
+    for (const EarleyScratch::Item& item : sets[n]) {
+        const Rule& rule = rules[item.rule];
+        if (item.origin == 0 && rule.lhs == startSymbol && item.dot == rule.body.size())
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,62 @@
+//
+// Earley recognizer for any CFG (ambiguous, left-recursive, with empty
+// productions). Far slower than the SLR tables; it exists as an
+// independent oracle to check them against.
+//
+
+#ifndef MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_EARLEYRECOGNIZER_H
+#define MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_EARLEYRECOGNIZER_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../grammers/CFG.h"
+
+// Per-thread working memory: one item set per input position, cleared
+// (capacity kept) between calls
+struct EarleyScratch {
+    struct Item {
+        uint32_t rule;
+        uint32_t dot;
+        uint32_t origin;
+
+        bool operator==(const Item& o) const {
+            return rule == o.rule && dot == o.dot && origin == o.origin;
+        }
+    };
+    std::vector<std::vector<Item>> sets;
+};
+
+class EarleyRecognizer {
+public:
+    // Throws std::invalid_argument if the start symbol has no productions
+    explicit EarleyRecognizer(const CFG& cfg);
+
+    // `terminals` holds ids from terminalId(), without an end marker; an
+    // id outside [0, terminalCount()) is rejected like an unknown token.
+    // const: threads can share one recognizer, each with its own scratch.
+    [[nodiscard]] bool accepts(const std::vector<int>& terminals, EarleyScratch& scratch) const;
+
+    // Terminal name -> dense id, -1 if unknown
+    [[nodiscard]] int terminalId(const std::string& name) const;
+    [[nodiscard]] int terminalCount() const { return numTerminals; }
+
+private:
+    struct Rule {
+        int lhs;                    // nonterminal index
+        std::vector<int> body;      // < numTerminals: terminal, else numTerminals + nonterminal
+    };
+
+    static void add(std::vector<EarleyScratch::Item>& set, EarleyScratch::Item item);
+
+    int numTerminals = 0;
+    int startSymbol = -1;           // nonterminal index
+    std::map<std::string, int> terminalIds;
+    std::vector<Rule> rules;
+    std::vector<std::vector<uint32_t>> rulesOf;     // nonterminal -> rule indices
+    std::vector<char> nullable;                     // nonterminal -> derives ""
+};
+
+#endif // MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_EARLEYRECOGNIZER_H
@@ -4,14 +4,25 @@
 
 #include "SLR.h"
 
-SLR::SLR(CFG &cfg) : cfg_ref(cfg){
+#include <algorithm>
+#include <sstream>
+
+#include "../utils/Log.h"
+#include "../utils/Metrics.h"
+
+SLR::SLR(const CFG &cfg) : grammar(cfg){
+    ScopedTimer timer(Stage::SlrBuild);
+
     // Copy productions from CFG
-    prods = cfg_ref.getProductions();
-    vars = cfg_ref.getVariables();
-    terms = cfg_ref.getTerminals();
+    prods = grammar.getProductions();
+    vars = grammar.getVariables();
+    terms = grammar.getTerminals();
 
     // Build the parser
     build();
+
+    // Flatten ACTION/GOTO into integer tables for accepts()
+    compile();
 }
 
 void SLR::print_states() {
@@ -51,13 +62,13 @@ void SLR::print_parsing_table() {
 }
 void SLR::build() {
     // 0. Augment grammar
-    start_symbol = cfg_ref.getStartSymbol() + "'";
-    production augmented(start_symbol, { cfg_ref.getStartSymbol() });
+    start_symbol = grammar.getStartSymbol() + "'";
+    production augmented(start_symbol, { grammar.getStartSymbol() });
     prods.insert(prods.begin(), augmented);
     vars.insert(vars.begin(), start_symbol);
-    cfg_ref.setStartSymbol(start_symbol);
-    cfg_ref.setProductions(prods);
-    cfg_ref.setVariables(vars);
+    grammar.setStartSymbol(start_symbol);
+    grammar.setProductions(prods);
+    grammar.setVariables(vars);
 
 
     // 1. Canonical LR(0) Collection
@@ -85,7 +96,7 @@ void SLR::build() {
     std::map<std::string, std::set<std::string>> follow_sets;
 
     for (const auto &A : vars) {
-        auto f = cfg_ref.followSet(A);
+        auto f = grammar.followSet(A);
         follow_sets[A] = std::set<std::string>(f.begin(), f.end());
     }
 
@@ -152,6 +163,60 @@ void SLR::build() {
 
 
 
+void SLR::compile() {
+    num_states = static_cast<int>(C.size());
+    num_cols = static_cast<int>(terms.size()) + 1;
+
+    term_ids.clear();
+    for (int t = 0; t < static_cast<int>(terms.size()); ++t) {
+        term_ids[terms[t]] = t;
+    }
+    term_ids["<EOS>"] = eosId();
+
+    std::map<std::string, int> var_ids;
+    for (int v = 0; v < static_cast<int>(vars.size()); ++v) {
+        var_ids[vars[v]] = v;
+    }
+
+    prod_len.clear();
+    prod_lhs.clear();
+    for (const auto &p : prods) {
+        prod_len.push_back(static_cast<int>(p.body.size()));
+        prod_lhs.push_back(var_ids.count(p.lhs) ? var_ids[p.lhs] : -1);
+    }
+
+    action_table.assign(static_cast<size_t>(num_states) * num_cols, 0);
+    for (const auto &entry : ACTION) {
+        auto col = term_ids.find(entry.first.second);
+        if (col == term_ids.end()) continue;
+
+        const std::string &act = entry.second;
+        int code = 0;
+        if (act == "acc")       code = ACTION_ACCEPT;
+        else if (act[0] == 's') code = std::stoi(act.substr(1)) + 1;
+        else if (act[0] == 'r') code = -(std::stoi(act.substr(1)) + 1);
+
+        action_table[static_cast<size_t>(entry.first.first) * num_cols + col->second] = code;
+    }
+
+    goto_table.assign(static_cast<size_t>(num_states) * vars.size(), -1);
+    for (const auto &entry : GOTO) {
+        auto col = var_ids.find(entry.first.second);
+        if (col == var_ids.end()) continue;
+        goto_table[static_cast<size_t>(entry.first.first) * vars.size() + col->second] = entry.second;
+    }
+}
+
+int SLR::terminalId(const std::string &name) const {
+    auto it = term_ids.find(name);
+    return it == term_ids.end() ? -1 : it->second;
+}
+
+const std::string &SLR::terminalName(int id) const {
+    static const std::string eos = "<EOS>";
+    return id >= 0 && id < static_cast<int>(terms.size()) ? terms[id] : eos;
+}
+
 std::set<Item> SLR::closure(const std::set<Item> &I) {
     std::set<Item> J = I;
 
@@ -224,6 +289,9 @@ std::vector<std::string> SLR::expectedTerminals(int state)
 
 bool SLR::parse(const std::vector<std::string> &tokens)
 {
+    ScopedTimer timer(Stage::Parse);
+    lastErrorIndex = -1;
+
     // Stack contains state numbers
     std::vector<int> stack;
     stack.push_back(0);
@@ -248,35 +316,37 @@ bool SLR::parse(const std::vector<std::string> &tokens)
             auto expected = expectedTerminals(state);
 
             // Build detailed diagnostic for GUI and logs
-            auto diag = cfg_ref.buildDiagnostic(expected, a);
+            auto diag = grammar.buildDiagnostic(expected, a);
             lastDiagnostic = diag;
 
-            //
-            // ======= DEBUG OUTPUT =======
-            //
-            std::cout << "\n========================================\n";
-            std::cout << "           PARSE ERROR DEBUG            \n";
-            std::cout << "========================================\n";
-            std::cout << "Current parser state: " << state << "\n";
-            std::cout << "Current token: '" << a << "'\n";
-
-            std::cout << "\nExpected terminals:\n";
-            for (auto& e : expected)
-                std::cout << "  - " << e << "\n";
-
-            std::cout << "\nStack contents (states): ";
-            for (auto s : stack)
-                std::cout << s << " ";
-            std::cout << "\n";
-
-            std::cout << "\nRemaining input sequence:\n";
-            for (int i = ip; i < input.size(); i++)
-                std::cout << input[i] << " ";
-            std::cout << "\n========================================\n\n";
-
-            // OLD terminal printing (optional debugging)
-            std::cout << "Parse error at token '" << a << "'\n";
-            cfg_ref.printExpectedTerminals(expected, a);
+            if (Log::enabled(LogLevel::Debug)) {
+                //
+                // ======= DEBUG OUTPUT =======
+                //
+                std::ostringstream out;
+                out << "parse error at token '" << a << "' (index " << ip << ")\n";
+                out << "Current parser state: " << state << "\n";
+
+                out << "Expected terminals:";
+                for (auto& e : expected)
+                    out << " " << e;
+
+                out << "\nStack contents (states):";
+                for (auto s : stack)
+                    out << " " << s;
+
+                out << "\nRemaining input sequence:";
+                for (int i = ip; i < input.size(); i++)
+                    out << " " << input[i];
+                out << "\n";
+
+                if (!diag.message.empty())
+                    out << diag.message << "\n";
+                if (!diag.interpretation.empty())
+                    out << "Interpretation: " << diag.interpretation << "\n";
+
+                Log::write(LogLevel::Debug, "SLR", out.str());
+            }
 
             lastErrorIndex = ip;
             return false;
@@ -302,18 +372,25 @@ bool SLR::parse(const std::vector<std::string> &tokens)
             int prod_index = std::stoi(action.substr(1));
             const production &p = prods[prod_index];
 
-            // pop |body| symbols from stack
-            for (int i = 0; i < p.body.size(); i++) {
-                stack.pop_back();
+            // pop |body| symbols from stack; the start state must survive
+            // (a table built from a consistent grammar never violates this,
+            // but the stack is not trusted blindly on untrusted input)
+            if (stack.size() <= p.body.size()) {
+                LOG_DEBUG("SLR") << "parse error: reduce by production " << prod_index
+                                 << " with only " << stack.size() << " states on the stack";
+                lastErrorIndex = ip;
+                return false;
             }
+            stack.resize(stack.size() - p.body.size());
 
             int state_after_pop = stack.back();
 
             // goto(state_after_pop, A)
             auto goto_it = GOTO.find({state_after_pop, p.lhs});
             if (goto_it == GOTO.end()) {
-                std::cout << "Parse error: no GOTO["
-                          << state_after_pop << ", " << p.lhs << "]\n";
+                LOG_DEBUG("SLR") << "parse error: no GOTO["
+                                 << state_after_pop << ", " << p.lhs << "]";
+                lastErrorIndex = ip;
                 return false;
             }
 
@@ -330,11 +407,251 @@ bool SLR::parse(const std::vector<std::string> &tokens)
             // INVALID ACTION
         else
         {
-            std::cout << "Parse error: invalid action '"
-                      << action << "'\n";
+            LOG_DEBUG("SLR") << "parse error: invalid action '" << action << "'";
+            lastErrorIndex = ip;
             return false;
         }
     }
 }
 
+bool SLR::accepts(const std::vector<int> &terminals,
+                  std::vector<int> &stack,
+                  int *errorIndex) const
+{
+    const size_t n = terminals.size();
+    const size_t num_vars = vars.size();
+
+    stack.clear();
+    stack.push_back(0);
+
+    size_t ip = 0;
+    while (true) {
+        const int a = ip < n ? terminals[ip] : eosId();
+        if (a < 0 || a >= num_cols) break;   // unknown terminal
+
+        const int act = action_table[static_cast<size_t>(stack.back()) * num_cols + a];
+
+        if (act == ACTION_ACCEPT) return true;
+
+        // SHIFT
+        if (act > 0) {
+            stack.push_back(act - 1);
+            ip++;
+            continue;
+        }
+
+        // REDUCE
+        if (act < 0) {
+            const int p = -act - 1;
+            const int len = prod_len[p];
+            if (static_cast<int>(stack.size()) <= len) break;
+            stack.resize(stack.size() - len);
+
+            const int to = goto_table[static_cast<size_t>(stack.back()) * num_vars + prod_lhs[p]];
+            if (to < 0) break;
+            stack.push_back(to);
+            continue;
+        }
+
+        break;  // empty cell
+    }
+
+    if (errorIndex) *errorIndex = static_cast<int>(ip);
+    return false;
+}
+
+int SLR::advance(const int *terminals, size_t count, std::vector<int> &stack) const
+{
+    const size_t num_vars = vars.size();
 
+    size_t ip = 0;
+    while (ip < count) {
+        const int a = terminals[ip];
+        if (a < 0 || a >= eosId()) break;     // unknown terminal (or an early <EOS>)
+
+        const int act = action_table[static_cast<size_t>(stack.back()) * num_cols + a];
+
+        // SHIFT
+        if (act > 0 && act != ACTION_ACCEPT) {
+            stack.push_back(act - 1);
+            ip++;
+            continue;
+        }
+
+        // REDUCE
+        if (act < 0) {
+            const int p = -act - 1;
+            const int len = prod_len[p];
+            if (static_cast<int>(stack.size()) <= len) break;
+            stack.resize(stack.size() - len);
+
+            const int to = goto_table[static_cast<size_t>(stack.back()) * num_vars + prod_lhs[p]];
+            if (to < 0) break;
+            stack.push_back(to);
+            continue;
+        }
+
+        break;  // empty cell
+    }
+    return ip < count ? static_cast<int>(ip) : -1;
+}
+
+void SLR::acceptsMany(const std::vector<int> *const *inputs, size_t count,
+                      std::vector<std::vector<int>> &stacks,
+                      uint8_t *accepted, int *errorIndex) const
+{
+    // The top of the stack lives in the lane; the vector holds what is
+    // below it and only grows, so a push is a store plus a bounds check
+    struct Lane {
+        const int *in;
+        size_t n;
+        size_t ip;
+        size_t index;           // into inputs
+        std::vector<int> *stack;
+        size_t depth;           // entries of *stack in use
+        int top;
+    };
+
+    const size_t num_vars = vars.size();
+    const int eos = eosId();
+    if (stacks.size() < LANES) stacks.resize(LANES);
+
+    Lane lanes[LANES];
+    size_t active = 0;
+    size_t next = 0;
+    auto load = [&](Lane &lane, std::vector<int> *stack) {
+        lane = {inputs[next]->data(), inputs[next]->size(), 0, next, stack, 0, 0};
+        next++;
+        if (stack->size() < 64) stack->resize(64);
+    };
+    for (; active < LANES && next < count; ++active)
+        load(lanes[active], &stacks[active]);
+
+    while (active > 0) {
+        for (size_t k = 0; k < active;) {
+            Lane &lane = lanes[k];
+
+            // Same steps as accepts(), one per turn; -1 while running
+            int result = -1;
+            const int a = lane.ip < lane.n ? lane.in[lane.ip] : eos;
+            const int act = a >= 0 && a < num_cols
+                                ? action_table[static_cast<size_t>(lane.top) * num_cols + a]
+                                : 0;
+            if (act > 0 && act != ACTION_ACCEPT) {
+                std::vector<int> &stack = *lane.stack;
+                if (lane.depth == stack.size()) stack.resize(stack.size() * 2);
+                stack[lane.depth++] = lane.top;
+                lane.top = act - 1;
+                lane.ip++;
+            } else if (act < 0) {
+                // len entries go: the top and len - 1 below it
+                const int p = -act - 1;
+                const size_t len = static_cast<size_t>(prod_len[p]);
+                if (lane.depth < len) {
+                    result = 0;
+                } else {
+                    lane.depth -= len;
+                    const int below = len ? (*lane.stack)[lane.depth] : lane.top;
+                    if (len == 0) {
+                        std::vector<int> &stack = *lane.stack;
+                        if (lane.depth == stack.size()) stack.resize(stack.size() * 2);
+                        stack[lane.depth] = lane.top;
+                    }
+                    lane.depth++;
+                    const int to = goto_table[static_cast<size_t>(below) * num_vars + prod_lhs[p]];
+                    if (to < 0) result = 0;
+                    else lane.top = to;
+                }
+            } else {
+                result = act == ACTION_ACCEPT;
+            }
+            if (result < 0) {
+                ++k;
+                continue;
+            }
+
+            accepted[lane.index] = static_cast<uint8_t>(result);
+            if (errorIndex) errorIndex[lane.index] = result ? -1 : static_cast<int>(lane.ip);
+            if (next < count) {
+                load(lane, lane.stack);
+                ++k;
+            } else {
+                lane = lanes[--active];     // the moved lane takes its turn now
+            }
+        }
+    }
+}
+
+bool SLR::trace(const std::vector<int> &terminals,
+                std::vector<int> &stack,
+                std::vector<int> &cells,
+                std::vector<int> &reductions) const
+{
+    const size_t n = terminals.size();
+    const size_t num_vars = vars.size();
+
+    stack.clear();
+    stack.push_back(0);
+
+    size_t ip = 0;
+    while (true) {
+        const int a = ip < n ? terminals[ip] : eosId();
+        if (a < 0 || a >= num_cols) return false;
+
+        const int cell = stack.back() * num_cols + a;
+        const int act = action_table[static_cast<size_t>(cell)];
+        if (act != 0) cells.push_back(cell);
+
+        if (act == ACTION_ACCEPT) return true;
+
+        if (act > 0) {
+            stack.push_back(act - 1);
+            ip++;
+            continue;
+        }
+
+        if (act < 0) {
+            const int p = -act - 1;
+            const int len = prod_len[p];
+            if (static_cast<int>(stack.size()) <= len) return false;
+            stack.resize(stack.size() - len);
+            if (p > 0) reductions.push_back(p - 1);     // prods[0] is S' -> S
+
+            const int to = goto_table[static_cast<size_t>(stack.back()) * num_vars + prod_lhs[p]];
+            if (to < 0) return false;
+            stack.push_back(to);
+            continue;
+        }
+
+        return false;
+    }
+}
+
+bool SLR::diagnose(const std::vector<int> &terminals,
+                   std::vector<int> &stack,
+                   int &errorIndex,
+                   DiagnosticInfo &out) const
+{
+    if (accepts(terminals, stack, &errorIndex))
+        return false;
+
+    // accepts() stops with the stack as it was when no action applied
+    const int state = stack.back();
+
+    std::vector<std::string> expected;
+    for (int c = 0; c < static_cast<int>(terms.size()); ++c) {
+        if (action_table[static_cast<size_t>(state) * num_cols + c] != 0)
+            expected.push_back(terms[c]);
+    }
+    // parse() lists them in ACTION (map key) order
+    std::sort(expected.begin(), expected.end());
+
+    std::string got = "<EOS>";
+    if (errorIndex < static_cast<int>(terminals.size())) {
+        const int a = terminals[errorIndex];
+        got = (a >= 0 && a < static_cast<int>(terms.size())) ? terms[a] : "UNKNOWN";
+    }
+
+    out = grammar.buildDiagnostic(expected, got);
+    return true;
+}
@@ -5,10 +5,12 @@
 #ifndef MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_SLR_H
 #define MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_SLR_H
 
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <map>
 #include <string>
+#include <limits>
 #include "../utils/json.hpp"
 #include "../grammers/CFG.h"
 
@@ -38,12 +40,79 @@ using State = std::vector<Item>;
 class SLR {
 public:
     int lastErrorIndex = -1;
-    explicit SLR(CFG &cfg);
+    explicit SLR(const CFG &cfg);
     DiagnosticInfo lastDiagnostic;
 
     // parse a token sequence
     [[nodiscard]] bool parse(const std::vector<std::string> &tokens);
 
+    // Compiled-table recognizer: no logging, no diagnostics, no member writes.
+    // Safe to call from many threads on one shared SLR.
+    // `terminals` holds ids from terminalId() WITHOUT the trailing <EOS>;
+    // `stack` is caller-owned scratch so the hot loop does not allocate.
+    // Untimed: HTTP10Validator times its whole syntax step as Parse.
+    [[nodiscard]] bool accepts(const std::vector<int> &terminals,
+                               std::vector<int> &stack,
+                               int *errorIndex = nullptr) const;
+
+    // accepts() for input that is still arriving: runs `count` more
+    // terminals through the tables from `stack` (start it as {0}; it keeps
+    // the parse between calls). Returns the index of the first terminal no
+    // continuation can accept, -1 once all of them were taken. No timer.
+    [[nodiscard]] int advance(const int *terminals, size_t count, std::vector<int> &stack) const;
+
+    // accepts() over `count` inputs at once. LANES of them advance
+    // round-robin, one ACTION (with its GOTO) per turn, and a lane that
+    // finishes takes the next input. The lanes' table loads do not depend
+    // on each other, so they overlap in the memory pipeline instead of
+    // each waiting for the previous one. accepted[i] and errorIndex[i]
+    // (-1 when accepted; the array may be null) are what accepts() gives
+    // for *inputs[i]. `stacks` is caller-owned scratch, one per lane.
+    // Like accepts(), records no Parse sample: the caller times what it
+    // counts as one parse (see HTTP10Validator::validateMany).
+    static constexpr size_t LANES = 8;
+    void acceptsMany(const std::vector<int> *const *inputs, size_t count,
+                     std::vector<std::vector<int>> &stacks,
+                     uint8_t *accepted, int *errorIndex = nullptr) const;
+
+    // Diagnostic re-run for a sequence accepts() rejected: same result as
+    // parse() (lastDiagnostic / lastErrorIndex) but const and silent, so a
+    // bulk caller can pay for strings only on the failures it reports.
+    // Returns false if the sequence is in fact accepted.
+    bool diagnose(const std::vector<int> &terminals,
+                  std::vector<int> &stack,
+                  int &errorIndex,
+                  DiagnosticInfo &out) const;
+
+    // accepts() that also reports the path it took, for coverage tools:
+    // every ACTION cell consulted is appended to `cells` as
+    // state * (eosId() + 1) + terminal, every reduction to `reductions` as
+    // an index into the caller's CFG::getProductions() (the augmented
+    // start rule is not reported).
+    bool trace(const std::vector<int> &terminals,
+               std::vector<int> &stack,
+               std::vector<int> &cells,
+               std::vector<int> &reductions) const;
+
+    // Whether ACTION[state][terminal] holds a shift, reduce or accept
+    [[nodiscard]] bool hasAction(int state, int terminal) const {
+        return action_table[static_cast<size_t>(state) * num_cols + terminal] != 0;
+    }
+
+    // Production (index into the caller's CFG::getProductions()) that
+    // ACTION[state][terminal] reduces by; -1 for shift, accept and empty cells
+    [[nodiscard]] int reduceProduction(int state, int terminal) const {
+        const int act = action_table[static_cast<size_t>(state) * num_cols + terminal];
+        return act < 0 ? -act - 2 : -1;    // prods[0] is the augmented S' -> S
+    }
+
+    // Terminal name -> dense id used by accepts(), -1 if unknown
+    [[nodiscard]] int terminalId(const std::string &name) const;
+    // Dense id -> terminal name ("<EOS>" for eosId())
+    [[nodiscard]] const std::string &terminalName(int id) const;
+    [[nodiscard]] int eosId() const { return static_cast<int>(terms.size()); }
+    [[nodiscard]] int stateCount() const { return num_states; }
+
     // Debug printing of LR(0) item sets
     void print_states();
 
@@ -57,8 +126,11 @@ private:
     // Build complete SLR parsing tables
     void build();
 
-    // References
-    CFG &cfg_ref;
+    // Flatten ACTION/GOTO into the integer tables below
+    void compile();
+
+    // Own copy: build() augments the grammar, callers' CFG stays untouched
+    CFG grammar;
     std::string start_symbol;
     std::vector<production> prods;
     std::vector<std::string> vars;
@@ -68,6 +140,17 @@ private:
     std::map<std::pair<int, std::string>, std::string> ACTION;
     std::map<std::pair<int, std::string>, int> GOTO;
     std::set<std::set<Item>> C; // Canonical collection of LR(0) items
+
+    // Compiled tables (row-major, one row per state).
+    // action_table: 0 = error, >0 = shift to (v - 1), <0 = reduce prod (-v - 1)
+    static constexpr int ACTION_ACCEPT = std::numeric_limits<int>::max();
+    int num_states = 0;
+    int num_cols = 0;                  // terms.size() + 1 (<EOS>)
+    std::vector<int> action_table;
+    std::vector<int> goto_table;       // -1 = no entry
+    std::vector<int> prod_len;
+    std::vector<int> prod_lhs;         // index into vars
+    std::map<std::string, int> term_ids;
 };
 
 #endif // MACHINE_BEREKENBAARHEID_GROEPS_OPDRACHT_SLR_H
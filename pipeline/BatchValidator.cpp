@@ -0,0 +1,136 @@
+#include "BatchValidator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+WorkerCounters& WorkerCounters::operator+=(const WorkerCounters& o) {
+    messages       += o.messages;
+    bytes          += o.bytes;
+    accepted       += o.accepted;
+    syntaxErrors   += o.syntaxErrors;
+    semanticErrors += o.semanticErrors;
+    batches        += o.batches;
+    steals         += o.steals;
+    cacheHits      += o.cacheHits;
+    return *this;
+}
+
+// ----------------------------------------------------------
+// Work-stealing deque
+// ----------------------------------------------------------
+void WorkStealingDeque::push(Range r) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ranges.push_back(r);
+}
+
+std::optional<WorkStealingDeque::Range> WorkStealingDeque::pop() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (ranges.empty()) return std::nullopt;
+    Range r = ranges.back();
+    ranges.pop_back();
+    return r;
+}
+
+std::optional<WorkStealingDeque::Range> WorkStealingDeque::steal() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (ranges.empty()) return std::nullopt;
+    Range r = ranges.front();
+    ranges.pop_front();
+    return r;
+}
+
+// ----------------------------------------------------------
+// Batch validator
+// ----------------------------------------------------------
+BatchValidator::BatchValidator(const HTTP10Validator& validator, BatchOptions options)
+    : validator(validator),
+      workers(options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency())),
+      batchSize(std::max<size_t>(1, options.batchSize)),
+      cache(options.cache),
+      interleave(options.interleave && !options.cache)
+{
+}
+
+BatchReport BatchValidator::run(const std::vector<std::string_view>& messages) const {
+    BatchReport report;
+    report.verdicts.resize(messages.size());
+    report.perWorker.resize(workers);
+
+    // Deal contiguous batches round-robin so every worker starts with local work
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques;
+    for (unsigned w = 0; w < workers; ++w)
+        deques.push_back(std::make_unique<WorkStealingDeque>());
+
+    size_t batchIndex = 0;
+    for (size_t begin = 0; begin < messages.size(); begin += batchSize, ++batchIndex) {
+        size_t end = std::min(messages.size(), begin + batchSize);
+        deques[batchIndex % workers]->push({begin, end});
+    }
+
+    auto worker = [&](unsigned self) {
+        ValidatorScratch scratch;               // per-worker arena, reused for every message
+        WorkerCounters local;                   // written only by this thread
+
+        auto process = [&](WorkStealingDeque::Range r) {
+            if (interleave)
+                validator.validateMany(&messages[r.begin], r.end - r.begin, scratch, &report.verdicts[r.begin]);
+
+            for (size_t i = r.begin; i < r.end; ++i) {
+                if (!interleave) {
+                    bool hit = false;
+                    report.verdicts[i] = validator.validate(messages[i], scratch, cache, &hit);
+                    if (hit) local.cacheHits++;
+                }
+                const Verdict& v = report.verdicts[i];
+
+                local.messages++;
+                local.bytes += messages[i].size();
+                if (v.ok())             local.accepted++;
+                else if (!v.syntaxOk)   local.syntaxErrors++;
+                else                    local.semanticErrors++;
+            }
+            local.batches++;
+        };
+
+        while (true) {
+            if (auto r = deques[self]->pop()) {
+                process(*r);
+                continue;
+            }
+
+            // Own deque drained: try every victim once, starting next door
+            bool stole = false;
+            for (unsigned k = 1; k < workers && !stole; ++k) {
+                if (auto r = deques[(self + k) % workers]->steal()) {
+                    local.steals++;
+                    process(*r);
+                    stole = true;
+                }
+            }
+            // Nothing is ever pushed after start, so empty everywhere means done
+            if (!stole) break;
+        }
+
+        report.perWorker[self] = local;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned w = 1; w < workers; ++w)
+        threads.emplace_back(worker, w);
+    worker(0);                                  // calling thread is worker 0
+    for (auto& t : threads)
+        t.join();
+
+    auto stop = std::chrono::steady_clock::now();
+    report.seconds = std::chrono::duration<double>(stop - start).count();
+
+    for (const auto& c : report.perWorker)
+        report.total += c;
+
+    return report;
+}
@@ -0,0 +1,85 @@
+//
+// Multithreaded corpus validation over one shared HTTP10Validator.
+//
+
+#ifndef PIPELINE_BATCHVALIDATOR_H
+#define PIPELINE_BATCHVALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "HTTP10Validator.h"
+#include "Verdict.h"
+
+struct BatchOptions {
+    unsigned workers = 0;       // 0 = std::thread::hardware_concurrency()
+    size_t batchSize = 256;     // messages per stealable unit of work
+    VerdictCache* cache = nullptr;  // optional, shared by all workers
+    // Each batch through HTTP10Validator::validateMany(), several messages
+    // interleaved in the syntax tables; ignored when `cache` is set
+    bool interleave = false;
+};
+
+// One per worker, padded so workers never share a cache line
+struct alignas(64) WorkerCounters {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t accepted = 0;
+    uint64_t syntaxErrors = 0;
+    uint64_t semanticErrors = 0;
+    uint64_t batches = 0;
+    uint64_t steals = 0;        // batches taken from another worker's deque
+    uint64_t cacheHits = 0;     // verdicts answered by the VerdictCache
+
+    WorkerCounters& operator+=(const WorkerCounters& o);
+};
+
+struct BatchReport {
+    std::vector<Verdict> verdicts;              // same order as the input
+    std::vector<WorkerCounters> perWorker;
+    WorkerCounters total;
+    double seconds = 0.0;
+
+    [[nodiscard]] double messagesPerSecond() const {
+        return seconds > 0.0 ? (double)total.messages / seconds : 0.0;
+    }
+};
+
+// Double-ended queue of batch ranges. The owner pops from the back (LIFO,
+// cache-warm), thieves take from the front. One short critical section per
+// batch keeps contention negligible next to the work inside a batch.
+class WorkStealingDeque {
+public:
+    struct Range { size_t begin; size_t end; };
+
+    void push(Range r);
+    std::optional<Range> pop();     // owner side
+    std::optional<Range> steal();   // thief side
+
+private:
+    alignas(64) std::mutex mtx;
+    std::deque<Range> ranges;
+};
+
+class BatchValidator {
+public:
+    explicit BatchValidator(const HTTP10Validator& validator, BatchOptions options = {});
+
+    [[nodiscard]] BatchReport run(const std::vector<std::string_view>& messages) const;
+
+    [[nodiscard]] unsigned workerCount() const { return workers; }
+
+private:
+    const HTTP10Validator& validator;
+    unsigned workers;
+    size_t batchSize;
+    VerdictCache* cache;
+    bool interleave;
+};
+
+#endif // PIPELINE_BATCHVALIDATOR_H
@@ -0,0 +1,165 @@
+#include "HTTP10Framer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../protocols/HTTP10/HTTP10_semantics.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t npos = std::string_view::npos;
+
+// End of the blank line if the '\n' at `i` starts one
+inline size_t terminatorAt(std::string_view d, size_t i) {
+    if (i + 1 < d.size() && d[i + 1] == '\n') return i + 2;
+    if (i + 2 < d.size() && d[i + 1] == '\r' && d[i + 2] == '\n') return i + 3;
+    return npos;
+}
+
+} // namespace
+
+const char* frameStatusName(FrameStatus status) {
+    switch (status) {
+        case FrameStatus::Complete:         return "complete";
+        case FrameStatus::Incomplete:       return "incomplete";
+        case FrameStatus::BadContentLength: return "bad-content-length";
+        case FrameStatus::HeaderTooLarge:   return "header-too-large";
+        case FrameStatus::BodyTooLarge:     return "body-too-large";
+        default:                            return "unknown";
+    }
+}
+
+// ----------------------------------------------------------
+// Blank-line search
+// ----------------------------------------------------------
+size_t HTTP10Framer::findHeaderEnd(std::string_view data, size_t from) {
+    const char* p = data.data();
+    const size_t n = data.size();
+    size_t i = from;
+
+#if defined(__SSE2__)
+    // Bit k of the mask is set when p[i+k] is '\n' and is followed by
+    // "\n" or "\r\n": the terminator test for 16 positions at once, so
+    // ordinary line ends inside the header cost nothing extra.
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; i + 18 <= n; i += 16) {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 1));
+        __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 2));
+
+        __m128i next = _mm_or_si128(_mm_cmpeq_epi8(v1, lf),
+                                    _mm_and_si128(_mm_cmpeq_epi8(v1, cr), _mm_cmpeq_epi8(v2, lf)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v0, lf), next));
+        if (mask) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            return p[at + 1] == '\n' ? at + 2 : at + 3;
+        }
+    }
+#endif
+
+    // Tail (and the whole buffer without SSE2): memchr is vectorised by libc
+    while (i < n) {
+        const void* hit = std::memchr(p + i, '\n', n - i);
+        if (!hit) return npos;
+        size_t at = (size_t)(static_cast<const char*>(hit) - p);
+        size_t end = terminatorAt(data, at);
+        if (end != npos) return end;
+        i = at + 1;
+    }
+    return npos;
+}
+
+// ----------------------------------------------------------
+// Content-Length
+// ----------------------------------------------------------
+bool HTTP10Framer::contentLength(std::string_view head, uint64_t& length, bool& present) {
+    length = 0;
+    present = false;
+
+    // Skip the request line; headers follow one per line
+    size_t lineStart = head.find('\n');
+    while (lineStart != npos && lineStart + 1 < head.size()) {
+        lineStart++;
+        size_t lineEnd = head.find('\n', lineStart);
+        std::string_view line = head.substr(lineStart, (lineEnd == npos ? head.size() : lineEnd) - lineStart);
+        lineStart = lineEnd;
+
+        size_t colon = line.find(':');
+        if (colon == npos || !HTTP10_semantics::isContentLength(line.substr(0, colon)))
+            continue;
+
+        // Same parser as the semantic check that accepted this head
+        std::string_view value = line.substr(colon + 1);
+        if (!value.empty() && value.back() == '\r') value.remove_suffix(1);
+        uint64_t v = 0;
+        if (!HTTP10_semantics::parseContentLength(value, v)) return false;
+
+        if (present && v != length) return false;   // conflicting values
+        length = v;
+        present = true;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------
+// Framing
+// ----------------------------------------------------------
+FrameStatus HTTP10Framer::frame(std::string_view data, FramedMessage& out,
+                                const FramerLimits& limits, size_t scanFrom) {
+    out = FramedMessage{};
+
+    // Never look further than a head may legally extend
+    std::string_view window = data.substr(0, std::min(data.size(), limits.maxHeaderBytes));
+    size_t end = findHeaderEnd(window, std::min(scanFrom, window.size()));
+    if (end == npos)
+        return data.size() >= limits.maxHeaderBytes ? FrameStatus::HeaderTooLarge : FrameStatus::Incomplete;
+
+    out.head = data.substr(0, end);
+
+    // RFC 1945 only knows Content-Length for request bodies (no chunking);
+    // it is honoured for any method, POST being the one that carries it.
+    uint64_t length = 0;
+    bool present = false;
+    if (!contentLength(out.head, length, present))
+        return FrameStatus::BadContentLength;
+    if (length > limits.maxBodyBytes)
+        return FrameStatus::BodyTooLarge;
+
+    out.contentLength = length;
+    if (data.size() - end < length)
+        return FrameStatus::Incomplete;
+
+    out.body = data.substr(end, (size_t)length);
+    return FrameStatus::Complete;
+}
+
+FrameStatus HTTP10Framer::split(std::string_view stream, std::vector<FramedMessage>& out,
+                                size_t& consumed, const FramerLimits& limits) {
+    const size_t n = stream.size();
+    consumed = 0;
+
+    while (true) {
+        // Empty lines between requests are tolerated (RFC 1945, 4.1)
+        while (consumed < n) {
+            if (stream[consumed] == '\n') consumed += 1;
+            else if (stream[consumed] == '\r' && consumed + 1 < n && stream[consumed + 1] == '\n') consumed += 2;
+            else break;
+        }
+        if (consumed == n)
+            return FrameStatus::Incomplete;
+
+        FramedMessage m;
+        FrameStatus status = frame(stream.substr(consumed), m, limits);
+        if (status != FrameStatus::Complete)
+            return status;
+
+        m.offset = consumed;
+        consumed += m.size();
+        out.push_back(m);
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Splits a byte stream (keep-alive connection, capture, concatenated
+// corpus) into individual HTTP/1.0 requests.
+//
+
+#ifndef PIPELINE_HTTP10FRAMER_H
+#define PIPELINE_HTTP10FRAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// One request, as views into the caller's buffer (nothing is copied)
+struct FramedMessage {
+    size_t offset = 0;          // first byte of the request within the stream
+    std::string_view head;      // request line + headers + the blank line
+    std::string_view body;      // exactly Content-Length bytes, empty if none
+    uint64_t contentLength = 0; // declared body length, known once `head` is set
+
+    [[nodiscard]] size_t size() const { return head.size() + body.size(); }
+};
+
+enum class FrameStatus : uint8_t {
+    Complete,                   // `out` holds a whole request
+    Incomplete,                 // need more bytes (head may already be set)
+    BadContentLength,           // unparsable or conflicting Content-Length
+    HeaderTooLarge,             // no blank line within maxHeaderBytes
+    BodyTooLarge                // Content-Length above maxBodyBytes
+};
+
+struct FramerLimits {
+    size_t maxHeaderBytes = 64 * 1024;
+    uint64_t maxBodyBytes = 64ull << 20;
+};
+
+const char* frameStatusName(FrameStatus status);
+
+class HTTP10Framer {
+public:
+    // Offset just past the first blank line ("\r\n\r\n", or the bare-LF
+    // forms the tokenizer also accepts) whose first '\n' lies at or after
+    // `from`; npos if there is none yet. Scans 16 bytes per step with SSE2.
+    static size_t findHeaderEnd(std::string_view data, size_t from = 0);
+
+    // Content-Length of a header block. `present` is false when the header
+    // is absent (no body); returns false if a value is malformed or two
+    // values disagree.
+    static bool contentLength(std::string_view head, uint64_t& length, bool& present);
+
+    // Frames the request that starts at data[0]. A caller waiting for more
+    // bytes of the same head can pass `scanFrom` to skip what it searched.
+    static FrameStatus frame(std::string_view data, FramedMessage& out,
+                             const FramerLimits& limits = {}, size_t scanFrom = 0);
+
+    // Appends every complete request in `stream` to `out`; empty lines
+    // between requests are skipped. `consumed` is where the next call must
+    // resume. Returns Incomplete when the stream ends mid-request (or
+    // cleanly), otherwise the error that stopped framing at `consumed`.
+    static FrameStatus split(std::string_view stream, std::vector<FramedMessage>& out,
+                             size_t& consumed, const FramerLimits& limits = {});
+};
+
+#endif // PIPELINE_HTTP10FRAMER_H
@@ -0,0 +1,188 @@
+#include "HTTP10StreamValidator.h"
+
+#include <algorithm>
+
+namespace {
+
+// Length of the run of empty lines at the start of `s`
+size_t blankPrefix(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size()) {
+        if (s[i] == '\n') i += 1;
+        else if (s[i] == '\r' && i + 1 < s.size() && s[i + 1] == '\n') i += 2;
+        else break;
+    }
+    return i;
+}
+
+} // namespace
+
+HTTP10StreamValidator::HTTP10StreamValidator(const HTTP10Validator& validator, RequestSink sink,
+                                             FramerLimits limits, BodyOptions body)
+    : validator(validator), sink(std::move(sink)), limits(limits), bodyOptions(body)
+{
+}
+
+void HTTP10StreamValidator::feed(std::string_view chunk) {
+    while (!chunk.empty()) {
+        if (state == State::Failed) {
+            counters.discardedBytes += chunk.size();
+            streamOffset += chunk.size();
+            return;
+        }
+
+        if (state == State::Body) {
+            size_t n = consumeBody(chunk);
+            chunk.remove_prefix(n);
+            streamOffset += n;
+            continue;
+        }
+
+        // ----- State::Head -----
+        if (head == "\r" && chunk[0] == '\n') {
+            // Second half of an empty line split across chunks
+            head.clear();
+            chunk.remove_prefix(1);
+            streamOffset += 1;
+            continue;
+        }
+
+        if (head.empty()) {
+            size_t skip = blankPrefix(chunk);
+            chunk.remove_prefix(skip);
+            streamOffset += skip;
+            if (chunk.empty()) return;
+
+            // Common case: the whole head is in this chunk, validate it in place
+            std::string_view window = chunk.substr(0, std::min(chunk.size(), limits.maxHeaderBytes));
+            size_t end = HTTP10Framer::findHeaderEnd(window);
+            if (end != std::string_view::npos) {
+                startRequest(chunk.substr(0, end), streamOffset);
+                chunk.remove_prefix(end);
+                streamOffset += end;
+                continue;
+            }
+            headOffset = streamOffset;
+            scanned = 0;
+        }
+
+        // The head spans chunks: buffer it, never beyond maxHeaderBytes
+        size_t before = head.size();
+        size_t take = std::min(chunk.size(), limits.maxHeaderBytes - before);
+        head.append(chunk.data(), take);
+        counters.maxBuffered = std::max(counters.maxBuffered, head.size());
+
+        size_t end = HTTP10Framer::findHeaderEnd(head, scanned);
+        if (end == std::string::npos) {
+            chunk.remove_prefix(take);
+            streamOffset += take;
+            if (head.size() >= limits.maxHeaderBytes) {
+                failFraming(headOffset);
+                continue;
+            }
+            scanned = head.size() >= 2 ? head.size() - 2 : 0;
+            continue;
+        }
+
+        size_t used = end - before;     // bytes of this chunk that belong to the head
+        head.resize(end);
+        chunk.remove_prefix(used);
+        streamOffset += used;
+
+        startRequest(head, headOffset);
+        head.clear();                   // keeps its capacity for the next split head
+    }
+}
+
+void HTTP10StreamValidator::startRequest(std::string_view headBytes, uint64_t offset) {
+    current = StreamedRequest{};
+    current.offset = offset;
+    current.verdict = validator.validate(headBytes, scratch);
+    counters.headBytes += headBytes.size();
+
+    // The semantic layer already judged Content-Length; here it only
+    // decides where the next request starts
+    uint64_t length = 0;
+    bool present = false;
+    if (!HTTP10Framer::contentLength(headBytes, length, present) || length > limits.maxBodyBytes) {
+        current.verdict.code = VerdictCode::FramingError;
+        counters.requests++;
+        sink(current);
+        state = State::Failed;
+        return;
+    }
+
+    current.bodyLength = length;
+    bodyRemaining = length;
+    if (bodyOptions.hash) hasher.reset();
+    sample.clear();
+
+    if (length == 0)
+        completeRequest();
+    else
+        state = State::Body;
+}
+
+size_t HTTP10StreamValidator::consumeBody(std::string_view chunk) {
+    size_t n = (size_t)std::min<uint64_t>(bodyRemaining, chunk.size());
+
+    // Body bytes are never tokenized: without hashing or sampling they are
+    // skipped by arithmetic alone
+    if (bodyOptions.hash)
+        hasher.update(chunk.data(), n);
+    if (sample.size() < bodyOptions.sampleBytes)
+        sample.append(chunk.data(), std::min(n, bodyOptions.sampleBytes - sample.size()));
+
+    bodyRemaining -= n;
+    current.bodyReceived += n;
+    counters.bodyBytes += n;
+
+    if (bodyRemaining == 0)
+        completeRequest();
+    return n;
+}
+
+void HTTP10StreamValidator::completeRequest() {
+    if (bodyOptions.hash && current.bodyLength > 0)
+        current.bodyHash = hasher.digest();
+    current.sample = sample;
+
+    counters.requests++;
+    if (current.verdict.ok()) counters.accepted++;
+    sink(current);
+
+    state = State::Head;
+}
+
+void HTTP10StreamValidator::failFraming(uint64_t offset) {
+    current = StreamedRequest{};
+    current.offset = offset;
+    current.verdict.code = VerdictCode::FramingError;
+    counters.requests++;
+    sink(current);
+
+    head.clear();
+    state = State::Failed;
+}
+
+void HTTP10StreamValidator::finish() {
+    if (state == State::Body) {
+        if (current.verdict.ok())
+            current.verdict.code = VerdictCode::TruncatedBody;
+        completeRequest();
+    } else if (state == State::Head && !head.empty() && head != "\r") {
+        // Closed mid-head: report it for what it is (it cannot parse)
+        startRequest(head, headOffset);
+        if (state == State::Body) {
+            if (current.verdict.ok()) current.verdict.code = VerdictCode::TruncatedBody;
+            completeRequest();
+        }
+    }
+
+    // Ready for the next stream
+    state = State::Head;
+    head.clear();
+    scanned = 0;
+    streamOffset = 0;
+    bodyRemaining = 0;
+}
@@ -0,0 +1,92 @@
+//
+// Incremental validation of one HTTP/1.0 byte stream (a connection),
+// with request bodies consumed as they arrive instead of buffered.
+//
+
+#ifndef PIPELINE_HTTP10STREAMVALIDATOR_H
+#define PIPELINE_HTTP10STREAMVALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "HTTP10Validator.h"
+#include "HTTP10Framer.h"
+#include "Hash64.h"
+
+struct BodyOptions {
+    bool hash = false;              // XXH64 over every body
+    size_t sampleBytes = 0;         // keep the first N bytes of every body
+};
+
+struct StreamedRequest {
+    uint64_t offset = 0;            // first byte of the request within the stream
+    Verdict verdict;
+    uint64_t bodyLength = 0;        // declared by Content-Length
+    uint64_t bodyReceived = 0;      // < bodyLength only for a TruncatedBody verdict
+    uint64_t bodyHash = 0;          // XXH64 of the received body (BodyOptions::hash)
+    std::string_view sample;        // first sampleBytes of the body; valid during the callback
+};
+
+struct StreamStats {
+    uint64_t requests = 0;
+    uint64_t accepted = 0;
+    uint64_t headBytes = 0;
+    uint64_t bodyBytes = 0;
+    uint64_t discardedBytes = 0;    // after a framing error
+    size_t maxBuffered = 0;         // high-water mark of buffered head bytes
+};
+
+// Memory is bounded by FramerLimits::maxHeaderBytes plus the sample,
+// whatever the Content-Length: a head is validated as soon as its blank
+// line arrives, then body bytes are only counted (and hashed/sampled if
+// asked) before being dropped. Heads that fit in one feed() chunk are
+// validated in place without copying.
+class HTTP10StreamValidator {
+public:
+    using RequestSink = std::function<void(const StreamedRequest& request)>;
+
+    HTTP10StreamValidator(const HTTP10Validator& validator, RequestSink sink,
+                          FramerLimits limits = {}, BodyOptions body = {});
+
+    void feed(std::string_view chunk);
+
+    // End of stream: a body cut short becomes TruncatedBody, a partial
+    // head is validated as it stands.
+    void finish();
+
+    [[nodiscard]] const StreamStats& stats() const { return counters; }
+    [[nodiscard]] size_t bufferedBytes() const { return head.size(); }
+
+private:
+    enum class State { Head, Body, Failed };
+
+    // Validates a complete head; the body (if any) follows
+    void startRequest(std::string_view headBytes, uint64_t offset);
+    // Takes up to the rest of the current body from `chunk`
+    size_t consumeBody(std::string_view chunk);
+    void completeRequest();
+    // No way to find the next request boundary: report and drop the rest
+    void failFraming(uint64_t offset);
+
+    const HTTP10Validator& validator;
+    RequestSink sink;
+    FramerLimits limits;
+    BodyOptions bodyOptions;
+
+    ValidatorScratch scratch;
+    State state = State::Head;
+    uint64_t streamOffset = 0;      // stream position of the next unconsumed byte
+    std::string head;               // partial head spanning feed() calls
+    uint64_t headOffset = 0;        // stream position of head[0]
+    size_t scanned = 0;
+    uint64_t bodyRemaining = 0;
+    XXH64 hasher;
+    std::string sample;
+    StreamedRequest current;
+    StreamStats counters;
+};
+
+#endif // PIPELINE_HTTP10STREAMVALIDATOR_H
@@ -0,0 +1,361 @@
+#include "HTTP10Validator.h"
+
+#include <algorithm>
+
+#include "../protocols/HTTP10/HTTP10Protocol.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
+
+HTTP10Validator::HTTP10Validator(const std::string& grammarFile)
+    : slr(CFG(grammarFile))
+{
+    resolveTerminals();
+}
+
+HTTP10Validator::HTTP10Validator(const CFG& grammar, const ValidatorOptions& options)
+    : slr(grammar)
+{
+    if (options.engine == SyntaxEngine::Dfa)
+        dfa = TerminalDFA::fromGrammar(grammar);
+    else if (options.prefilter)
+        prefilter = TerminalDFA::fromGrammar(regularApproximation(grammar));
+    resolveTerminals();
+}
+
+void HTTP10Validator::resolveTerminals() {
+    // Names must match http10.json
+    idSP      = slr.terminalId("SP");
+    idCRLF    = slr.terminalId("CRLF");
+    idCOLON   = slr.terminalId("COLON");
+    idSLASH   = slr.terminalId("SLASH");
+    idDOT     = slr.terminalId("DOT");
+    idIDENT   = slr.terminalId("IDENT");
+    idGET     = slr.terminalId("METHOD_GET");
+    idPOST    = slr.terminalId("METHOD_POST");
+    idHEAD    = slr.terminalId("METHOD_HEAD");
+    idVERSION = slr.terminalId("HTTP_VERSION_1_0");
+}
+
+int HTTP10Validator::terminalFor(const Token& token) const {
+    switch (token.base) {
+        case BaseToken::SP:    return idSP;
+        case BaseToken::CRLF:  return idCRLF;
+        case BaseToken::COLON: return idCOLON;
+        case BaseToken::SLASH: return idSLASH;
+        case BaseToken::DOT:   return idDOT;
+        case BaseToken::IDENT:
+            // The tokenizer tags keywords with a subtype, no string compares needed
+            switch (token.subtype) {
+                case (int)HTTPToken::METHOD_GET:       return idGET;
+                case (int)HTTPToken::METHOD_POST:      return idPOST;
+                case (int)HTTPToken::METHOD_HEAD:      return idHEAD;
+                case (int)HTTPToken::HTTP_VERSION_1_0: return idVERSION;
+                default:                               return idIDENT;
+            }
+        default:
+            return -1;
+    }
+}
+
+Verdict HTTP10Validator::validate(std::string_view message, ValidatorScratch& scratch) const {
+    TraceSpan span("validate");
+    Verdict v;
+
+    if (tokenizeStage(message, scratch.tokenizer, scratch.tokens, scratch.terminals, v) &&
+        syntaxStage(scratch.tokens, scratch.terminals, scratch.stack, v))
+    {
+        semanticStage(scratch.tokens, v);
+    }
+
+    countVerdict(v);
+    return v;
+}
+
+// Messages tokenized ahead of one acceptsMany() call: enough to keep every
+// lane busy past the ramp-up, few enough that their tokens stay in cache
+static constexpr size_t MANY_GROUP = 64;
+
+void HTTP10Validator::validateMany(const std::string_view* messages, size_t count, ValidatorScratch& scratch,
+                                   Verdict* out) const
+{
+    TraceSpan span("validate_many");
+    auto& tokens = scratch.groupTokens;
+    auto& terminals = scratch.groupTerminals;
+    auto& inputs = scratch.groupInputs;
+    auto& slots = scratch.groupSlots;
+    auto& accepted = scratch.groupAccepted;
+    auto& errors = scratch.groupErrors;
+    if (tokens.size() < MANY_GROUP) {
+        tokens.resize(MANY_GROUP);
+        terminals.resize(MANY_GROUP);
+    }
+
+    for (size_t begin = 0; begin < count; begin += MANY_GROUP) {
+        const size_t n = std::min(MANY_GROUP, count - begin);
+        Verdict* verdicts = out + begin;
+
+        inputs.clear();
+        slots.clear();
+        for (size_t i = 0; i < n; ++i) {
+            verdicts[i] = Verdict();
+            if (tokenizeStage(messages[begin + i], scratch.tokenizer, tokens[i], terminals[i], verdicts[i])) {
+                inputs.push_back(&terminals[i]);
+                slots.push_back(i);
+            }
+        }
+        accepted.resize(inputs.size());
+        errors.resize(inputs.size());
+
+        // Interleaved messages have no time of their own: the group's syntax
+        // time (prefilter and engine) is split evenly, one Parse sample per
+        // message that reached it, as validate() records
+        const size_t parsed = inputs.size();
+        const bool timed = Metrics::enabled() && parsed > 0;
+        const uint64_t t0 = timed ? Trace::nowNanos() : 0;
+
+        // Prefilter first; the exact engine only sees what it passed
+        if (prefilter && !inputs.empty()) {
+            prefilter->acceptsMany(inputs.data(), inputs.size(), accepted.data(), errors.data());
+            size_t kept = 0;
+            for (size_t j = 0; j < inputs.size(); ++j) {
+                if (!accepted[j]) {
+                    syntaxError(tokens[slots[j]], errors[j], verdicts[slots[j]]);
+                    continue;
+                }
+                inputs[kept] = inputs[j];
+                slots[kept] = slots[j];
+                kept++;
+            }
+            Metrics::add(Counter::PrefilterRejects, inputs.size() - kept);
+            Metrics::add(Counter::PrefilterPasses, kept);
+            inputs.resize(kept);
+            slots.resize(kept);
+        }
+
+        if (dfa) dfa->acceptsMany(inputs.data(), inputs.size(), accepted.data(), errors.data());
+        else     slr.acceptsMany(inputs.data(), inputs.size(), scratch.laneStacks, accepted.data(), errors.data());
+
+        if (timed) {
+            const uint64_t share = (Trace::nowNanos() - t0) / parsed;
+            for (size_t j = 0; j < parsed; ++j) Metrics::record(Stage::Parse, share);
+        }
+
+        for (size_t j = 0; j < inputs.size(); ++j) {
+            Verdict& v = verdicts[slots[j]];
+            if (!accepted[j]) {
+                syntaxError(tokens[slots[j]], errors[j], v);
+                continue;
+            }
+            v.syntaxOk = true;
+            semanticStage(tokens[slots[j]], v);
+        }
+        for (size_t i = 0; i < n; ++i) countVerdict(verdicts[i]);
+    }
+}
+
+Verdict HTTP10Validator::validate(std::string_view message, ValidatorScratch& scratch,
+                                  VerdictCache* cache, bool* hit) const
+{
+    if (hit) *hit = false;
+    if (!cache) return validate(message, scratch);
+
+    CacheKey key = cache->key(message);
+    Verdict v;
+    if (cache->lookup(key, v)) {
+        if (hit) *hit = true;
+        Metrics::add(Counter::CacheHits);
+        countVerdict(v);
+        return v;
+    }
+    Metrics::add(Counter::CacheMisses);
+
+    v = validate(message, scratch);
+    cache->insert(key, v);
+    return v;
+}
+
+void HTTP10Validator::countVerdict(const Verdict& v) {
+    Metrics::add(Counter::Messages);
+    if (!v.ok()) {
+        Metrics::add(Counter::Rejected);
+        Metrics::countError((size_t)v.code);
+    }
+}
+
+Diagnosis HTTP10Validator::explain(std::string_view message) const {
+    MetricsPause pause;
+    Diagnosis d;
+    ValidatorScratch scratch;
+
+    if (!tokenizeStage(message, scratch.tokenizer, scratch.tokens, scratch.terminals, d.verdict))
+        return d;
+
+    int err = -1;
+    if (slr.diagnose(scratch.terminals, scratch.stack, err, d.syntax)) {
+        d.verdict.code = VerdictCode::SyntaxError;
+        if (err >= 0 && err < (int)scratch.tokens.size()) {
+            const Token& t = scratch.tokens[err];
+            d.verdict.errorOffset = t.position;
+            if (t.position >= 0 && t.line > 0) {
+                d.line = t.line;
+                d.column = t.col;
+
+                size_t pos = std::min((size_t)t.position, message.size());
+                size_t begin = pos == 0 ? std::string_view::npos : message.rfind('\n', pos - 1);
+                begin = begin == std::string_view::npos ? 0 : begin + 1;
+                size_t end = std::min(message.find('\n', begin), message.size());
+                if (end > begin && message[end - 1] == '\r') end--;
+                d.lineText = std::string(message.substr(begin, end - begin));
+            }
+        }
+        return d;
+    }
+    d.verdict.syntaxOk = true;
+
+    HTTP10Protocol protocol;
+    SemanticResult sem = protocol.validateSemantics(scratch.tokens);
+    if (!sem.ok) {
+        d.verdict.code = verdictCodeFromSemantic(sem.code);
+        d.semanticMessage = sem.message;
+        return d;
+    }
+
+    d.verdict.semanticsOk = true;
+    d.verdict.code = VerdictCode::Ok;
+    return d;
+}
+
+std::string Diagnosis::format() const {
+    std::string out = verdictCodeName(verdict.code);
+
+    if (verdict.code == VerdictCode::SyntaxError) {
+        if (line > 0) {
+            out += " at line " + std::to_string(line) + ", column " + std::to_string(column) + "\n";
+            out += "  " + lineText + "\n";
+            out += "  " + std::string((size_t)std::max(0, column - 1), ' ') + "^\n";
+        } else {
+            out += "\n";
+        }
+
+        out += "Expected:";
+        for (const auto& e : syntax.expected) out += " " + e;
+        out += "\nGot: " + syntax.got + "\n";
+        if (!syntax.message.empty()) out += syntax.message + "\n";
+        return out;
+    }
+
+    if (!semanticMessage.empty())
+        out += ": " + semanticMessage;
+    return out + "\n";
+}
+
+size_t HTTP10Validator::validateStream(std::string_view stream, ValidatorScratch& scratch,
+                                      std::vector<FramedMessage>& frames, std::vector<Verdict>& verdicts,
+                                      const FramerLimits& limits) const
+{
+    size_t first = frames.size();
+    size_t consumed = 0;
+    FrameStatus status = HTTP10Framer::split(stream, frames, consumed, limits);
+
+    for (size_t i = first; i < frames.size(); ++i)
+        verdicts.push_back(validate(frames[i].head, scratch));
+
+    if (status != FrameStatus::Incomplete) {
+        // Nothing after this point can be trusted to start a request
+        FramedMessage bad;
+        bad.offset = consumed;
+        bad.head = stream.substr(consumed);
+        frames.push_back(bad);
+
+        Verdict v;
+        v.code = VerdictCode::FramingError;
+        verdicts.push_back(v);
+        consumed = stream.size();
+    }
+    return consumed;
+}
+
+bool HTTP10Validator::checkPrefix(std::string_view buffered, PrefixCheck& state, HTTP10Tokenizer& tokenizer,
+                                  Verdict& v) const
+{
+    const size_t lineEnd = buffered.rfind('\n');
+    if (lineEnd == std::string_view::npos || lineEnd < state.checked) return true;
+
+    // Line ends are token boundaries, so the new lines tokenize on their own
+    MetricsPause pause;
+    const size_t base = state.checked;
+    tokenizer.tokenize(buffered.substr(base, lineEnd + 1 - base), state.tokens);
+    state.checked = lineEnd + 1;
+
+    state.terminals.clear();
+    for (const Token& t : state.tokens) {
+        if (t.base == BaseToken::END_OF_INPUT) continue;
+        state.terminals.push_back(terminalFor(t));
+    }
+
+    const int err = slr.advance(state.terminals.data(), state.terminals.size(), state.stack);
+    if (err < 0) return true;
+    v.code = VerdictCode::SyntaxError;
+    v.errorOffset = (int32_t)(base + state.tokens[err].position);
+    return false;
+}
+
+bool HTTP10Validator::tokenizeStage(std::string_view message, HTTP10Tokenizer& tokenizer,
+                                    std::vector<Token>& tokens, std::vector<int>& terminals,
+                                    Verdict& v) const
+{
+    if (message.empty()) {
+        v.code = VerdictCode::EmptyInput;
+        return false;
+    }
+
+    tokenizer.tokenize(message, tokens);
+
+    terminals.clear();
+    for (const Token& t : tokens) {
+        if (t.base == BaseToken::END_OF_INPUT) continue;
+        terminals.push_back(terminalFor(t));
+    }
+    return true;
+}
+
+bool HTTP10Validator::syntaxStage(const std::vector<Token>& tokens, const std::vector<int>& terminals,
+                                  std::vector<int>& stack, Verdict& v) const
+{
+    // Parse covers the whole syntax decision, whichever tables make it
+    ScopedTimer timer(Stage::Parse);
+    int err = -1;
+    bool ok;
+    if (prefilter && !prefilter->accepts(terminals, &err)) {
+        Metrics::add(Counter::PrefilterRejects);
+        ok = false;
+    } else {
+        if (prefilter) Metrics::add(Counter::PrefilterPasses);
+        ok = dfa ? dfa->accepts(terminals, &err) : slr.accepts(terminals, stack, &err);
+    }
+    if (!ok) {
+        syntaxError(tokens, err, v);
+        return false;
+    }
+    v.syntaxOk = true;
+    return true;
+}
+
+void HTTP10Validator::syntaxError(const std::vector<Token>& tokens, int err, Verdict& v) {
+    v.code = VerdictCode::SyntaxError;
+    // END_OF_INPUT is the last token, so parser index == token index
+    if (err >= 0 && err < (int)tokens.size())
+        v.errorOffset = tokens[err].position;
+}
+
+void HTTP10Validator::semanticStage(const std::vector<Token>& tokens, Verdict& v) const {
+    HTTP10Protocol protocol;
+    SemanticResult sem = protocol.validateSemantics(tokens);
+    if (!sem.ok) {
+        v.code = verdictCodeFromSemantic(sem.code);
+        return;
+    }
+
+    v.semanticsOk = true;
+    v.code = VerdictCode::Ok;
+}
@@ -0,0 +1,164 @@
+//
+// Shared, immutable HTTP/1.0 validator for bulk use.
+//
+
+#ifndef PIPELINE_HTTP10VALIDATOR_H
+#define PIPELINE_HTTP10VALIDATOR_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Verdict.h"
+#include "HTTP10Framer.h"
+#include "VerdictCache.h"
+#include "../grammers/TerminalDFA.h"
+#include "../parsers/SLR.h"
+#include "../protocols/HTTP10/HTTP10Tokenizer.h"
+
+// Per-thread working memory. Buffers are cleared, never freed, between
+// messages so a worker reaches a steady state with zero allocations in
+// the parser loop.
+struct ValidatorScratch {
+    HTTP10Tokenizer tokenizer;
+    std::vector<Token> tokens;
+    std::vector<int> terminals;
+    std::vector<int> stack;
+
+    // validateMany(): the messages of one group, tokenized side by side
+    std::vector<std::vector<Token>> groupTokens;
+    std::vector<std::vector<int>> groupTerminals;
+    std::vector<const std::vector<int>*> groupInputs;
+    std::vector<size_t> groupSlots;         // groupInputs[j] is message groupSlots[j]
+    std::vector<uint8_t> groupAccepted;
+    std::vector<int> groupErrors;
+    std::vector<std::vector<int>> laneStacks;
+};
+
+// A message arriving in pieces, as far as checkPrefix() has run it
+struct PrefixCheck {
+    size_t checked = 0;             // bytes of complete lines already parsed
+    std::vector<int> stack{0};      // SLR stack after them
+    std::vector<Token> tokens;      // scratch for the newest lines
+    std::vector<int> terminals;
+};
+
+// Which table decides syntaxStage(). Both accept the same language with
+// the same error index; Dfa needs a grammar without self-embedding.
+enum class SyntaxEngine {
+    Slr,
+    Dfa,
+};
+
+struct ValidatorOptions {
+    // Dfa compiles the grammar with TerminalDFA::fromGrammar() in the
+    // constructor, which throws std::invalid_argument if it is not regular
+    SyntaxEngine engine = SyntaxEngine::Slr;
+    // Run the DFA of regularApproximation(grammar) before the engine and
+    // reject what it rejects, counted in Counter::PrefilterRejects (passes
+    // in PrefilterPasses). Its error offset can lie after the exact one
+    // when the approximation is looser than the grammar. Ignored with
+    // SyntaxEngine::Dfa, which is already exact.
+    bool prefilter = false;
+};
+
+// Everything a person needs to fix one failed message. Only explain()
+// builds one; validate() never touches a string.
+struct Diagnosis {
+    Verdict verdict;
+    int line = 0;                   // 1-based position of the offending token, 0 if none
+    int column = 0;
+    std::string lineText;           // that line, without its line ending
+    DiagnosticInfo syntax;          // filled on syntax errors
+    std::string semanticMessage;    // filled on semantic errors
+
+    // Multi-line report: location with caret, expected/got or the semantic message
+    [[nodiscard]] std::string format() const;
+};
+
+// Grammar is loaded and the SLR tables (and the DFA, if selected) are
+// built once in the constructor.
+// After that every member is read-only: one instance can be shared by any
+// number of threads, each bringing its own ValidatorScratch.
+class HTTP10Validator {
+public:
+    explicit HTTP10Validator(const std::string& grammarFile = "protocols/HTTP10/http10.json");
+    explicit HTTP10Validator(const CFG& grammar, const ValidatorOptions& options = {});
+
+    // tokenize -> SLR or DFA (compiled tables) -> semantics
+    [[nodiscard]] Verdict validate(std::string_view message, ValidatorScratch& scratch) const;
+
+    // validate() for messages[0..count) into out[0..count), same verdicts
+    // and counters. Messages go through in groups: all of a group is
+    // tokenized, then its syntax runs through the engine's acceptsMany()
+    // (SLR::LANES or TerminalDFA::LANES messages interleaved), then the
+    // semantics of what passed. Parse gets one sample per message as in
+    // validate(), each the group's syntax time divided by its messages.
+    void validateMany(const std::string_view* messages, size_t count, ValidatorScratch& scratch,
+                      Verdict* out) const;
+
+    // Same, answered from `cache` when this exact message was seen before
+    // (a hit skips tokenizer, parser and semantics). `cache` may be null.
+    [[nodiscard]] Verdict validate(std::string_view message, ValidatorScratch& scratch,
+                                   VerdictCache* cache, bool* hit = nullptr) const;
+
+    // Slow path, run on demand for a message validate() rejected: same
+    // verdict, plus line/column, the SLR diagnostic and semantic message.
+    // Records no metrics; the message was counted by its validate().
+    [[nodiscard]] Diagnosis explain(std::string_view message) const;
+
+    // Frames `stream` into back-to-back requests and validates the head of
+    // each one; bodies are framed by Content-Length but not inspected.
+    // Appends one entry to `frames` and `verdicts` per request. A framing
+    // error ends the stream with a FramingError verdict for the request at
+    // `consumed`. Returns the number of bytes consumed; a trailing partial
+    // request is left for the caller to complete.
+    size_t validateStream(std::string_view stream, ValidatorScratch& scratch,
+                          std::vector<FramedMessage>& frames, std::vector<Verdict>& verdicts,
+                          const FramerLimits& limits = {}) const;
+
+    // Syntax of the complete lines in `buffered` (the message so far) that
+    // earlier calls with `state` have not seen; tokens on complete lines are
+    // final, so an error there cannot be fixed by more input. Each byte is
+    // tokenized and parsed once however the message is split. false with a
+    // SyntaxError in `v` at the offending byte. Always the SLR tables, and
+    // nothing is recorded: the message is counted once, by validate().
+    bool checkPrefix(std::string_view buffered, PrefixCheck& state, HTTP10Tokenizer& tokenizer,
+                     Verdict& v) const;
+
+    // The three steps of validate(), exposed so they can run on separate
+    // threads (see StagedPipeline). Each returns false once `v` is final.
+    bool tokenizeStage(std::string_view message, HTTP10Tokenizer& tokenizer,
+                       std::vector<Token>& tokens, std::vector<int>& terminals, Verdict& v) const;
+    bool syntaxStage(const std::vector<Token>& tokens, const std::vector<int>& terminals,
+                     std::vector<int>& stack, Verdict& v) const;
+    void semanticStage(const std::vector<Token>& tokens, Verdict& v) const;
+
+    // Message/rejection counters in Metrics; validate() calls it, callers
+    // driving the stages themselves call it once per finished verdict
+    static void countVerdict(const Verdict& v);
+
+    // Token -> SLR terminal id (same mapping as HTTPTreeBuilder::tokenToTerminal)
+    [[nodiscard]] int terminalFor(const Token& token) const;
+
+    [[nodiscard]] const SLR& parser() const { return slr; }
+    // The compiled DFA when SyntaxEngine::Dfa was selected, else null
+    [[nodiscard]] const TerminalDFA* syntaxDfa() const { return dfa ? &*dfa : nullptr; }
+    // The prefilter DFA when ValidatorOptions::prefilter applies, else null
+    [[nodiscard]] const TerminalDFA* prefilterDfa() const { return prefilter ? &*prefilter : nullptr; }
+
+private:
+    void resolveTerminals();
+    // Rejection at parser index `err` (== token index)
+    static void syntaxError(const std::vector<Token>& tokens, int err, Verdict& v);
+
+    SLR slr;
+    std::optional<TerminalDFA> dfa;         // same terminal ids as slr
+    std::optional<TerminalDFA> prefilter;   // likewise
+
+    int idSP = -1, idCRLF = -1, idCOLON = -1, idSLASH = -1, idDOT = -1, idIDENT = -1;
+    int idGET = -1, idPOST = -1, idHEAD = -1, idVERSION = -1;
+};
+
+#endif // PIPELINE_HTTP10VALIDATOR_H
@@ -0,0 +1,134 @@
+//
+// XXH64 (xxHash, 64-bit variant): one-shot and streaming.
+//
+
+#ifndef PIPELINE_HASH64_H
+#define PIPELINE_HASH64_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Matches the reference implementation's output on little-endian hosts
+// (inputs are read as little-endian words via memcpy).
+class XXH64 {
+public:
+    explicit XXH64(uint64_t seed = 0) { reset(seed); }
+
+    void reset(uint64_t seed = 0) {
+        v[0] = seed + P1 + P2;
+        v[1] = seed + P2;
+        v[2] = seed;
+        v[3] = seed - P1;
+        this->seed = seed;
+        total = 0;
+        buffered = 0;
+    }
+
+    void update(const void* data, size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        total += len;
+
+        if (buffered + len < 32) {
+            std::memcpy(buffer + buffered, p, len);
+            buffered += len;
+            return;
+        }
+
+        if (buffered > 0) {
+            size_t fill = 32 - buffered;
+            std::memcpy(buffer + buffered, p, fill);
+            stripe(buffer);
+            p += fill;
+            len -= fill;
+            buffered = 0;
+        }
+
+        for (; len >= 32; p += 32, len -= 32)
+            stripe(p);
+
+        std::memcpy(buffer, p, len);
+        buffered = len;
+    }
+
+    void update(std::string_view s) { update(s.data(), s.size()); }
+
+    [[nodiscard]] uint64_t digest() const {
+        uint64_t h;
+        if (total >= 32) {
+            h = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+            for (uint64_t lane : v)
+                h = (h ^ round(0, lane)) * P1 + P4;
+        } else {
+            h = seed + P5;
+        }
+        h += total;
+
+        const uint8_t* p = buffer;
+        size_t len = buffered;
+        for (; len >= 8; p += 8, len -= 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * P1 + P4;
+        }
+        if (len >= 4) {
+            h ^= (uint64_t)read32(p) * P1;
+            h = rotl(h, 23) * P2 + P3;
+            p += 4;
+            len -= 4;
+        }
+        for (; len > 0; ++p, --len) {
+            h ^= (*p) * P5;
+            h = rotl(h, 11) * P1;
+        }
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static uint64_t hash(const void* data, size_t len, uint64_t seed = 0) {
+        XXH64 h(seed);
+        h.update(data, len);
+        return h.digest();
+    }
+
+    static uint64_t hash(std::string_view s, uint64_t seed = 0) {
+        return hash(s.data(), s.size(), seed);
+    }
+
+private:
+    static constexpr uint64_t P1 = 11400714785074694791ULL;
+    static constexpr uint64_t P2 = 14029467366897019727ULL;
+    static constexpr uint64_t P3 = 1609587929392839161ULL;
+    static constexpr uint64_t P4 = 9650029242287828579ULL;
+    static constexpr uint64_t P5 = 2870177450012600261ULL;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * P2;
+        return rotl(acc, 31) * P1;
+    }
+
+    static uint64_t read64(const uint8_t* p) { uint64_t x; std::memcpy(&x, p, 8); return x; }
+    static uint32_t read32(const uint8_t* p) { uint32_t x; std::memcpy(&x, p, 4); return x; }
+
+    void stripe(const uint8_t* p) {
+        v[0] = round(v[0], read64(p));
+        v[1] = round(v[1], read64(p + 8));
+        v[2] = round(v[2], read64(p + 16));
+        v[3] = round(v[3], read64(p + 24));
+    }
+
+    uint64_t v[4];
+    uint64_t seed;
+    uint64_t total;
+    uint8_t buffer[32];
+    size_t buffered;
+};
+
+#endif // PIPELINE_HASH64_H
@@ -0,0 +1,70 @@
+//
+// Bounded lock-free single-producer / single-consumer ring buffer.
+//
+
+#ifndef PIPELINE_SPSCQUEUE_H
+#define PIPELINE_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Exactly one thread may call tryPush and exactly one (other) thread may
+// call tryPop. Head and tail live on their own cache lines; each side keeps
+// a cached copy of the other's index so the common case touches no shared
+// line at all.
+template <typename T>
+class SPSCQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SPSCQueue(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        slots.resize(cap);
+        mask = cap - 1;
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    bool tryPush(const T& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache == slots.size()) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache == slots.size()) return false;   // full
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& out) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return false;                   // empty
+        }
+        out = slots[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently; exact from either endpoint
+    [[nodiscard]] size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t capacity() const { return slots.size(); }
+
+private:
+    std::vector<T> slots;
+    size_t mask = 0;
+
+    alignas(64) std::atomic<size_t> head{0};    // consumer writes
+    size_t tailCache = 0;                       // consumer's view of tail
+
+    alignas(64) std::atomic<size_t> tail{0};    // producer writes
+    size_t headCache = 0;                       // producer's view of head
+};
+
+#endif // PIPELINE_SPSCQUEUE_H
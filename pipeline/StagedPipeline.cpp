@@ -0,0 +1,179 @@
+#include "StagedPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "SPSCQueue.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A batch owns all per-message buffers it needs on every stage. Batches are
+// allocated once and recycled through a return ring, so the pipeline holds
+// a fixed amount of memory however long the input is.
+struct MessageBatch {
+    size_t first = 0;
+    size_t count = 0;
+    std::vector<std::vector<Token>> tokens;
+    std::vector<std::vector<int>> terminals;
+    std::vector<Verdict> verdicts;
+    std::vector<uint8_t> pending;       // 1 while the verdict still needs later stages
+
+    explicit MessageBatch(size_t capacity)
+        : tokens(capacity), terminals(capacity), verdicts(capacity), pending(capacity) {}
+};
+
+// nullptr is the end-of-stream marker
+using BatchRing = SPSCQueue<MessageBatch*>;
+
+MessageBatch* popWait(BatchRing& q, StageStats& st) {
+    MessageBatch* b = nullptr;
+    while (!q.tryPop(b)) {
+        st.starved++;
+        std::this_thread::yield();
+    }
+    return b;
+}
+
+void pushWait(BatchRing& q, MessageBatch* b, StageStats& st, QueueStats* qs) {
+    while (!q.tryPush(b)) {
+        st.blocked++;
+        std::this_thread::yield();
+    }
+    if (qs) {
+        size_t depth = q.size();
+        qs->samples++;
+        qs->depthSum += depth;
+        qs->maxDepth = std::max(qs->maxDepth, depth);
+    }
+}
+
+double secondsSince(Clock::time_point t) {
+    return std::chrono::duration<double>(Clock::now() - t).count();
+}
+
+} // namespace
+
+const StageStats& PipelineReport::bottleneck() const {
+    return *std::max_element(std::begin(stages), std::end(stages),
+        [](const StageStats& a, const StageStats& b) { return a.busySeconds < b.busySeconds; });
+}
+
+StagedPipeline::StagedPipeline(const HTTP10Validator& validator, PipelineOptions options)
+    : validator(validator), options(options)
+{
+    this->options.batchSize = std::max<size_t>(1, options.batchSize);
+    this->options.queueCapacity = std::max<size_t>(2, options.queueCapacity);
+}
+
+PipelineReport StagedPipeline::run(const std::vector<std::string_view>& messages) const {
+    PipelineReport report;
+    report.verdicts.resize(messages.size());
+    report.stages[0].name = "tokenize";
+    report.stages[1].name = "syntax";
+    report.stages[2].name = "semantics";
+    report.queues[0].name = "tokenize->syntax";
+    report.queues[1].name = "syntax->semantics";
+
+    BatchRing toSyntax(options.queueCapacity);
+    BatchRing toSemantics(options.queueCapacity);
+    report.queues[0].capacity = toSyntax.capacity();
+    report.queues[1].capacity = toSemantics.capacity();
+
+    // Enough batches to fill both rings plus one in hand per stage
+    const size_t poolSize = toSyntax.capacity() + toSemantics.capacity() + 3;
+    BatchRing freeBatches(poolSize);
+
+    std::vector<std::unique_ptr<MessageBatch>> pool;
+    for (size_t i = 0; i < poolSize; ++i) {
+        pool.push_back(std::make_unique<MessageBatch>(options.batchSize));
+        freeBatches.tryPush(pool.back().get());
+    }
+
+    auto start = Clock::now();
+
+    // --- Stage 1: tokenize (producer of toSyntax, consumer of freeBatches) ---
+    std::thread tokenizeThread([&] {
+        StageStats& st = report.stages[0];
+        HTTP10Tokenizer tokenizer;
+
+        for (size_t first = 0; first < messages.size(); first += options.batchSize) {
+            MessageBatch* b = popWait(freeBatches, st);
+            auto t0 = Clock::now();
+
+            b->first = first;
+            b->count = std::min(options.batchSize, messages.size() - first);
+            for (size_t k = 0; k < b->count; ++k) {
+                b->verdicts[k] = Verdict{};
+                b->pending[k] = validator.tokenizeStage(messages[first + k], tokenizer,
+                                                        b->tokens[k], b->terminals[k], b->verdicts[k]);
+            }
+
+            st.busySeconds += secondsSince(t0);
+            st.batches++;
+            st.messages += b->count;
+            pushWait(toSyntax, b, st, &report.queues[0]);
+        }
+        pushWait(toSyntax, nullptr, st, nullptr);
+    });
+
+    // --- Stage 2: syntax ---
+    std::thread syntaxThread([&] {
+        StageStats& st = report.stages[1];
+        std::vector<int> stack;
+
+        while (MessageBatch* b = popWait(toSyntax, st)) {
+            auto t0 = Clock::now();
+
+            for (size_t k = 0; k < b->count; ++k) {
+                if (!b->pending[k]) continue;
+                b->pending[k] = validator.syntaxStage(b->tokens[k], b->terminals[k], stack, b->verdicts[k]);
+            }
+
+            st.busySeconds += secondsSince(t0);
+            st.batches++;
+            st.messages += b->count;
+            pushWait(toSemantics, b, st, &report.queues[1]);
+        }
+        pushWait(toSemantics, nullptr, st, nullptr);
+    });
+
+    // --- Stage 3: semantics + collection (runs on the calling thread) ---
+    {
+        StageStats& st = report.stages[2];
+        WorkerCounters& c = report.total;
+
+        while (MessageBatch* b = popWait(toSemantics, st)) {
+            auto t0 = Clock::now();
+
+            for (size_t k = 0; k < b->count; ++k) {
+                Verdict& v = b->verdicts[k];
+                if (b->pending[k])
+                    validator.semanticStage(b->tokens[k], v);
+
+                report.verdicts[b->first + k] = v;
+                HTTP10Validator::countVerdict(v);
+                c.messages++;
+                c.bytes += messages[b->first + k].size();
+                if (v.ok())           c.accepted++;
+                else if (!v.syntaxOk) c.syntaxErrors++;
+                else                  c.semanticErrors++;
+            }
+            c.batches++;
+
+            st.busySeconds += secondsSince(t0);
+            st.batches++;
+            st.messages += b->count;
+            pushWait(freeBatches, b, st, nullptr);
+        }
+    }
+
+    tokenizeThread.join();
+    syntaxThread.join();
+
+    report.seconds = secondsSince(start);
+    return report;
+}
@@ -0,0 +1,66 @@
+//
+// Stage-parallel validation: tokenizer, SLR and semantics each on their own
+// thread, connected by bounded SPSC rings of message batches.
+//
+
+#ifndef PIPELINE_STAGEDPIPELINE_H
+#define PIPELINE_STAGEDPIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "BatchValidator.h"
+#include "HTTP10Validator.h"
+#include "Verdict.h"
+
+struct PipelineOptions {
+    size_t batchSize = 64;          // messages per batch travelling between stages
+    size_t queueCapacity = 8;       // batches per ring (rounded up to a power of two)
+};
+
+struct StageStats {
+    const char* name = "";
+    uint64_t batches = 0;
+    uint64_t messages = 0;
+    uint64_t starved = 0;           // pops that found the input ring empty
+    uint64_t blocked = 0;           // pushes that found the output ring full (backpressure)
+    double busySeconds = 0.0;       // time spent doing work, excluding waits
+};
+
+struct QueueStats {
+    const char* name = "";
+    size_t capacity = 0;
+    uint64_t samples = 0;           // one per push
+    uint64_t depthSum = 0;
+    size_t maxDepth = 0;
+
+    [[nodiscard]] double meanDepth() const {
+        return samples ? (double)depthSum / (double)samples : 0.0;
+    }
+};
+
+struct PipelineReport {
+    std::vector<Verdict> verdicts;  // same order as the input
+    WorkerCounters total;
+    StageStats stages[3];           // tokenize, syntax, semantics
+    QueueStats queues[2];           // tokenize->syntax, syntax->semantics
+    double seconds = 0.0;
+
+    // Stage with the largest busy time: the one to optimise first
+    [[nodiscard]] const StageStats& bottleneck() const;
+};
+
+class StagedPipeline {
+public:
+    explicit StagedPipeline(const HTTP10Validator& validator, PipelineOptions options = {});
+
+    [[nodiscard]] PipelineReport run(const std::vector<std::string_view>& messages) const;
+
+private:
+    const HTTP10Validator& validator;
+    PipelineOptions options;
+};
+
+#endif // PIPELINE_STAGEDPIPELINE_H
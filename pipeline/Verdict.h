@@ -0,0 +1,78 @@
+//
+// Compact per-message validation result used by the bulk pipeline.
+//
+
+#ifndef PIPELINE_VERDICT_H
+#define PIPELINE_VERDICT_H
+
+#include <cstdint>
+#include <string>
+
+// One code per outcome; semantic codes mirror the strings in SemanticResult
+enum class VerdictCode : uint8_t {
+    Ok = 0,
+    EmptyInput,
+    SyntaxError,
+    ParserStructureError,   // "parser-structure-error"
+    InvalidMethod,          // "invalid-method"
+    MissingURI,             // "missing-uri"
+    InvalidURI,             // "invalid-uri"
+    InvalidVersion,         // "invalid-version"
+    EmptyHeaderName,        // "empty-header-name"
+    EmptyHeaderValue,       // "empty-header-value"
+    InvalidHeaderValue,     // "invalid-header-value"
+    InvalidContentLength,   // "invalid-content-length"
+    MissingContentLength,   // "missing-content-length"
+    OtherSemantic,          // any code not listed above
+    FramingError,           // request boundary could not be determined
+    TruncatedBody,          // stream ended before Content-Length bytes of body
+
+    Count
+};
+
+struct Verdict {
+    bool syntaxOk = false;
+    bool semanticsOk = false;
+    VerdictCode code = VerdictCode::EmptyInput;
+    int32_t errorOffset = -1;   // byte offset of the offending token, -1 if none
+
+    [[nodiscard]] bool ok() const { return code == VerdictCode::Ok; }
+};
+
+inline VerdictCode verdictCodeFromSemantic(const std::string& code) {
+    if (code == "parser-structure-error") return VerdictCode::ParserStructureError;
+    if (code == "invalid-method")         return VerdictCode::InvalidMethod;
+    if (code == "missing-uri")            return VerdictCode::MissingURI;
+    if (code == "invalid-uri")            return VerdictCode::InvalidURI;
+    if (code == "invalid-version")        return VerdictCode::InvalidVersion;
+    if (code == "empty-header-name")      return VerdictCode::EmptyHeaderName;
+    if (code == "empty-header-value")     return VerdictCode::EmptyHeaderValue;
+    if (code == "invalid-header-value")   return VerdictCode::InvalidHeaderValue;
+    if (code == "invalid-content-length") return VerdictCode::InvalidContentLength;
+    if (code == "missing-content-length") return VerdictCode::MissingContentLength;
+    return VerdictCode::OtherSemantic;
+}
+
+inline const char* verdictCodeName(VerdictCode code) {
+    switch (code) {
+        case VerdictCode::Ok:                   return "ok";
+        case VerdictCode::EmptyInput:           return "empty-input";
+        case VerdictCode::SyntaxError:          return "syntax-error";
+        case VerdictCode::ParserStructureError: return "parser-structure-error";
+        case VerdictCode::InvalidMethod:        return "invalid-method";
+        case VerdictCode::MissingURI:           return "missing-uri";
+        case VerdictCode::InvalidURI:           return "invalid-uri";
+        case VerdictCode::InvalidVersion:       return "invalid-version";
+        case VerdictCode::EmptyHeaderName:      return "empty-header-name";
+        case VerdictCode::EmptyHeaderValue:     return "empty-header-value";
+        case VerdictCode::InvalidHeaderValue:   return "invalid-header-value";
+        case VerdictCode::InvalidContentLength: return "invalid-content-length";
+        case VerdictCode::MissingContentLength: return "missing-content-length";
+        case VerdictCode::OtherSemantic:        return "semantic-error";
+        case VerdictCode::FramingError:         return "framing-error";
+        case VerdictCode::TruncatedBody:        return "truncated-body";
+        default:                                return "unknown";
+    }
+}
+
+#endif // PIPELINE_VERDICT_H
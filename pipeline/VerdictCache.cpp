@@ -0,0 +1,111 @@
+#include "VerdictCache.h"
+
+#include <algorithm>
+
+#include "Hash64.h"
+
+namespace {
+
+// Second, independent seed for the upper half of a wide key
+constexpr uint64_t WIDE_SEED = 0x9E3779B97F4A7C15ULL;
+
+} // namespace
+
+size_t VerdictCache::entryBytes() {
+    // std::list node: two links + payload; unordered_map node: next link,
+    // key, mapped iterator and cached hash; plus one bucket pointer
+    return (2 * sizeof(void*) + sizeof(Entry)) +
+           (sizeof(void*) + sizeof(CacheKey) + sizeof(void*) + sizeof(size_t)) +
+           sizeof(void*);
+}
+
+VerdictCache::VerdictCache(CacheOptions options)
+    : wideKeys(options.wideKeys)
+{
+    unsigned count = 1;
+    unsigned bits = 0;
+    while (count < std::max(1u, options.shards)) {
+        count <<= 1;
+        bits++;
+    }
+    shardShift = 64 - bits;
+
+    for (unsigned i = 0; i < count; ++i)
+        shards.push_back(std::make_unique<Shard>());
+
+    perShardCapacity = std::max<size_t>(1, options.maxBytes / count / entryBytes());
+    for (auto& s : shards)
+        s->index.reserve(perShardCapacity);
+}
+
+CacheKey VerdictCache::key(std::string_view message) const {
+    CacheKey k;
+    k.lo = XXH64::hash(message);
+    k.hi = wideKeys ? XXH64::hash(message, WIDE_SEED) : (uint64_t)message.size();
+    return k;
+}
+
+bool VerdictCache::lookup(const CacheKey& key, Verdict& out) {
+    Shard& s = shardFor(key);
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    auto it = s.index.find(key);
+    if (it == s.index.end()) {
+        s.misses++;
+        return false;
+    }
+
+    s.lru.splice(s.lru.begin(), s.lru, it->second);
+    out = it->second->verdict;
+    s.hits++;
+    return true;
+}
+
+void VerdictCache::insert(const CacheKey& key, const Verdict& verdict) {
+    Shard& s = shardFor(key);
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    auto it = s.index.find(key);
+    if (it != s.index.end()) {
+        // Another worker got there first: same message, same verdict
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+    }
+
+    if (s.lru.size() >= perShardCapacity) {
+        // Reuse the evicted node instead of freeing and allocating one
+        auto last = std::prev(s.lru.end());
+        s.index.erase(last->key);
+        last->key = key;
+        last->verdict = verdict;
+        s.lru.splice(s.lru.begin(), s.lru, last);
+        s.evictions++;
+    } else {
+        s.lru.push_front({key, verdict});
+    }
+
+    s.index.emplace(key, s.lru.begin());
+    s.inserts++;
+}
+
+void VerdictCache::clear() {
+    for (auto& s : shards) {
+        std::lock_guard<std::mutex> lock(s->mtx);
+        s->lru.clear();
+        s->index.clear();
+    }
+}
+
+CacheStats VerdictCache::stats() const {
+    CacheStats st;
+    for (const auto& s : shards) {
+        std::lock_guard<std::mutex> lock(s->mtx);
+        st.hits += s->hits;
+        st.misses += s->misses;
+        st.inserts += s->inserts;
+        st.evictions += s->evictions;
+        st.entries += s->lru.size();
+    }
+    st.bytes = st.entries * entryBytes();
+    return st;
+}
@@ -0,0 +1,99 @@
+//
+// Content-addressed verdict cache: raw message hash -> Verdict.
+//
+
+#ifndef PIPELINE_VERDICTCACHE_H
+#define PIPELINE_VERDICTCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Verdict.h"
+
+struct CacheOptions {
+    size_t maxBytes = 64u << 20;    // whole cache, entries and index included
+    unsigned shards = 16;           // rounded up to a power of two
+    bool wideKeys = true;           // 128-bit keys (two hashes) instead of hash + length
+};
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;               // estimated, compared against maxBytes
+
+    [[nodiscard]] double hitRate() const {
+        uint64_t lookups = hits + misses;
+        return lookups ? (double)hits / (double)lookups : 0.0;
+    }
+};
+
+struct CacheKey {
+    uint64_t lo = 0;                // XXH64 of the message
+    uint64_t hi = 0;                // second hash (wideKeys) or the length
+
+    bool operator==(const CacheKey& o) const { return lo == o.lo && hi == o.hi; }
+};
+
+// Identical messages always get identical verdicts, so the raw bytes are
+// the cache key; nothing about the message is kept but its hash. Each
+// shard is an LRU list plus index under its own mutex; the shard is picked
+// from the top hash bits, so concurrent workers rarely meet on a lock.
+// Thread-safe.
+class VerdictCache {
+public:
+    explicit VerdictCache(CacheOptions options = {});
+
+    [[nodiscard]] CacheKey key(std::string_view message) const;
+
+    // On a hit, copies the verdict and marks the entry most recently used
+    bool lookup(const CacheKey& key, Verdict& out);
+
+    // Inserts or refreshes; evicts least recently used entries of the shard
+    // to stay under its share of maxBytes
+    void insert(const CacheKey& key, const Verdict& verdict);
+
+    void clear();
+
+    [[nodiscard]] CacheStats stats() const;
+    [[nodiscard]] size_t capacity() const { return perShardCapacity * shards.size(); }
+
+    // Estimated footprint of one entry (list node + index node + bucket)
+    static size_t entryBytes();
+
+private:
+    struct KeyHash {
+        size_t operator()(const CacheKey& k) const { return (size_t)k.lo; }
+    };
+
+    struct Entry {
+        CacheKey key;
+        Verdict verdict;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mtx;
+        std::list<Entry> lru;       // front = most recently used
+        std::unordered_map<CacheKey, std::list<Entry>::iterator, KeyHash> index;
+        uint64_t hits = 0, misses = 0, inserts = 0, evictions = 0;
+    };
+
+    Shard& shardFor(const CacheKey& key) {
+        return *shards[shardShift >= 64 ? 0 : (size_t)(key.lo >> shardShift)];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    unsigned shardShift = 64;
+    size_t perShardCapacity = 0;
+    bool wideKeys = true;
+};
+
+#endif // PIPELINE_VERDICTCACHE_H
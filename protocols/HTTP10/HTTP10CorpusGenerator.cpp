@@ -0,0 +1,259 @@
+#include "HTTP10CorpusGenerator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Headers real clients send first; past these come X- extension headers
+const std::pair<std::string_view, std::string_view> COMMON_HEADERS[] = {
+    {"Host", "example.com"},
+    {"User-Agent", "TestClient/1.0"},
+    {"Accept", "text/html"},
+    {"Accept-Language", "en"},
+    {"Connection", "keep-alive"},
+    {"Referer", "example.org"},
+    {"Pragma", "no-cache"},
+    {"From", "bench"},
+};
+
+const std::string_view EXTENSIONS[] = {"html", "png", "txt", "css"};
+
+enum Defect : uint64_t {
+    BadMethod,
+    BadVersion,
+    BadURI,
+    BadHeader,
+    MissingBlankLine,
+    DefectCount
+};
+
+// Records per unit of work in writeFile(); large enough that the output
+// write, not the hand-off, dominates
+constexpr uint64_t FILE_CHUNK = 4096;
+
+void appendWord(std::string& out, Xoshiro256& rng, size_t minLen, size_t maxLen) {
+    const size_t len = minLen + rng.below(maxLen - minLen + 1);
+    for (size_t i = 0; i < len; ++i)
+        out.push_back((char)('a' + rng.below(26)));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+int HTTP10CorpusGenerator::Table::pick(Xoshiro256& rng) const {
+    const double x = rng.uniform() * cumulative.back();
+    const size_t i = std::upper_bound(cumulative.begin(), cumulative.end(), x) - cumulative.begin();
+    return values[std::min(i, values.size() - 1)];
+}
+
+HTTP10CorpusGenerator::HTTP10CorpusGenerator(HTTP10CorpusOptions options) : opt(std::move(options)) {
+    auto makeTable = [](Table& t, const std::vector<WeightedCount>& list, const char* what) {
+        double total = 0;
+        for (const WeightedCount& w : list) {
+            total += std::max(0.0, w.weight);
+            t.cumulative.push_back(total);
+            t.values.push_back(std::max(0, w.value));
+        }
+        if (total <= 0)
+            throw std::invalid_argument(std::string("HTTP10CorpusOptions: no positive weight in ") + what);
+    };
+
+    std::vector<WeightedCount> methodWeights;
+    for (size_t i = 0; i < opt.methods.size(); ++i)
+        methodWeights.push_back({(int)i, opt.methods[i].second});
+
+    makeTable(headerTable, opt.headerCounts, "headerCounts");
+    makeTable(depthTable, opt.uriDepths, "uriDepths");
+    makeTable(methodTable, methodWeights, "methods");
+    opt.invalidRatio = std::clamp(opt.invalidRatio, 0.0, 1.0);
+}
+
+Xoshiro256 HTTP10CorpusGenerator::recordRng(uint64_t index) const {
+    uint64_t x = opt.seed ^ (index * 0xD1B54A32D192ED03ULL);
+    return Xoshiro256(Xoshiro256::splitmix64(x));
+}
+
+// ---------------------------------------------------------------------------
+// One record
+// ---------------------------------------------------------------------------
+
+bool HTTP10CorpusGenerator::isInvalid(uint64_t index) const {
+    Xoshiro256 rng = recordRng(index);
+    return rng.chance(opt.invalidRatio);       // always the first draw in build()
+}
+
+bool HTTP10CorpusGenerator::build(uint64_t index, std::string& out) const {
+    Xoshiro256 rng = recordRng(index);
+    const bool invalid = rng.chance(opt.invalidRatio);
+    const uint64_t defect = invalid ? rng.below(DefectCount) : DefectCount;
+
+    const std::string& method = opt.methods[(size_t)methodTable.pick(rng)].first;
+    const int depth = depthTable.pick(rng);
+    int headers = headerTable.pick(rng);
+    if (defect == BadHeader && headers == 0) headers = 1;
+
+    // Request-Line
+    out += defect == BadMethod ? std::string_view("GEX") : std::string_view(method);
+    out += ' ';
+    if (defect == BadURI) {
+        switch (rng.below(3)) {
+            case 0:  out += "index..html"; break;       // no leading slash
+            case 1:  out += "/bad path/file"; break;    // space in the path
+            default: out += "noslash.html"; break;
+        }
+    } else {
+        out += '/';
+        for (int i = 0; i < depth; ++i) {
+            if (i) out += '/';
+            appendWord(out, rng, 3, 10);
+        }
+        if (depth == 0) out += "index";
+        out += '.';
+        out += EXTENSIONS[rng.below(std::size(EXTENSIONS))];
+    }
+    out += defect == BadVersion ? " HTTP/2.0\r\n" : " HTTP/1.0\r\n";
+
+    // Headers; a BadHeader record breaks exactly one of them
+    const int broken = defect == BadHeader ? (int)rng.below((uint64_t)headers) : -1;
+    for (int i = 0; i < headers; ++i) {
+        if ((size_t)i < std::size(COMMON_HEADERS)) {
+            out += COMMON_HEADERS[i].first;
+        } else {
+            out += "X-";
+            appendWord(out, rng, 4, 12);
+        }
+
+        if (i != broken) {
+            out += ": ";
+            if ((size_t)i < std::size(COMMON_HEADERS)) out += COMMON_HEADERS[i].second;
+            else appendWord(out, rng, 4, 28);
+        } else {
+            switch (rng.below(3)) {
+                case 0:  out += " value"; break;                    // missing colon
+                case 1:  out += ": "; break;                        // missing value
+                default: out += "@!: value"; break;                 // illegal chars
+            }
+        }
+        out += "\r\n";
+    }
+
+    // A POST is only valid with a declared (here: empty) body
+    if (method == "POST")
+        out += "Content-Length: 0\r\n";
+
+    if (defect != MissingBlankLine)
+        out += "\r\n";
+    return invalid;
+}
+
+std::string HTTP10CorpusGenerator::message(uint64_t index) const {
+    std::string out;
+    build(index, out);
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Bulk
+// ---------------------------------------------------------------------------
+
+HTTP10CorpusStats HTTP10CorpusGenerator::append(std::string& out, uint64_t first, size_t count) const {
+    HTTP10CorpusStats st;
+
+    for (uint64_t i = first; i < first + count; ++i) {
+        size_t start = out.size();
+        if (opt.format == RecordFormat::LengthPrefixed) {
+            out.append(4, '\0');                // patched once the length is known
+            start += 4;
+        }
+
+        st.invalid += build(i, out);
+        const size_t len = out.size() - start;
+
+        if (opt.format == RecordFormat::LengthPrefixed) {
+            for (int b = 0; b < 4; ++b)
+                out[start - 4 + b] = (char)((len >> (8 * b)) & 0xff);
+        } else {
+            out += '\n';
+        }
+        st.records++;
+        st.bytes += len;
+    }
+    return st;
+}
+
+HTTP10CorpusStats HTTP10CorpusGenerator::writeFile(const std::string& path, uint64_t count,
+                                                   unsigned threads) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Cannot open corpus file for writing: " + path);
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t chunks = (count + FILE_CHUNK - 1) / FILE_CHUNK;
+    threads = (unsigned)std::min<uint64_t>(threads, std::max<uint64_t>(1, chunks));
+
+    // Rounds of `threads` chunks: generate in parallel, write in order. Each
+    // worker keeps its buffer across rounds, so steady state never allocates.
+    std::vector<std::string> buffers(threads);
+    std::vector<HTTP10CorpusStats> stats(threads);
+    HTTP10CorpusStats total;
+
+    for (uint64_t round = 0; round < chunks; round += threads) {
+        auto work = [&](unsigned t) {
+            const uint64_t chunk = round + t;
+            buffers[t].clear();
+            stats[t] = {};
+            if (chunk >= chunks) return;
+            const uint64_t first = chunk * FILE_CHUNK;
+            stats[t] = append(buffers[t], first, (size_t)std::min(FILE_CHUNK, count - first));
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t)
+            pool.emplace_back(work, t);
+        work(0);
+        for (auto& th : pool) th.join();
+
+        for (unsigned t = 0; t < threads; ++t) {
+            file.write(buffers[t].data(), (std::streamsize)buffers[t].size());
+            total.records += stats[t].records;
+            total.bytes += stats[t].bytes;
+            total.invalid += stats[t].invalid;
+        }
+        if (!file)
+            throw std::runtime_error("Write failed: " + path);
+    }
+    return total;
+}
+
+std::vector<std::string_view> HTTP10CorpusGenerator::splitRecords(std::string_view data, RecordFormat format) {
+    std::vector<std::string_view> records;
+    size_t pos = 0;
+
+    if (format == RecordFormat::LengthPrefixed) {
+        while (pos + 4 <= data.size()) {
+            uint32_t len = 0;
+            for (int b = 0; b < 4; ++b)
+                len |= (uint32_t)(unsigned char)data[pos + b] << (8 * b);
+            if (len > data.size() - pos - 4) break;
+            records.push_back(data.substr(pos + 4, len));
+            pos += 4 + (size_t)len;
+        }
+        return records;
+    }
+
+    // A record ends at the first '\n' not preceded by '\r'
+    size_t start = 0;
+    for (pos = 0; pos < data.size(); ++pos) {
+        if (data[pos] == '\n' && (pos == 0 || data[pos - 1] != '\r')) {
+            records.push_back(data.substr(start, pos - start));
+            start = pos + 1;
+        }
+    }
+    return records;
+}
@@ -0,0 +1,97 @@
+//
+// Bulk HTTP/1.0 corpus generation: reproducible from one seed, safe to
+// call from any number of threads, and written straight into the output
+// buffer (no streams, no per-message options objects).
+//
+
+#ifndef HTTP10_CORPUS_GENERATOR_H
+#define HTTP10_CORPUS_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../../utils/Xoshiro.h"
+
+enum class RecordFormat : uint8_t {
+    // Message followed by '\n'. Generated messages only use CRLF line ends,
+    // so a '\n' directly after "\r\n" always ends a record.
+    NewlineDelimited,
+    // 4-byte little-endian length, then the message bytes
+    LengthPrefixed,
+};
+
+struct WeightedCount {
+    int value;
+    double weight;
+};
+
+struct HTTP10CorpusOptions {
+    uint64_t seed = 1;
+
+    // Fraction of records carrying exactly one defect (bad method, version,
+    // URI or header, or no terminating blank line); all others are valid
+    double invalidRatio = 0.1;
+
+    std::vector<WeightedCount> headerCounts = {{0, 5}, {2, 20}, {4, 35}, {8, 25}, {16, 10}, {32, 5}};
+    std::vector<WeightedCount> uriDepths = {{0, 10}, {1, 30}, {2, 30}, {3, 15}, {5, 10}, {8, 5}};
+    std::vector<std::pair<std::string, double>> methods = {{"GET", 80}, {"HEAD", 5}, {"POST", 15}};
+
+    RecordFormat format = RecordFormat::NewlineDelimited;
+};
+
+struct HTTP10CorpusStats {
+    uint64_t records = 0;
+    uint64_t bytes = 0;         // message bytes, without framing
+    uint64_t invalid = 0;
+};
+
+// Record i is a pure function of (seed, i): every record gets its own
+// xoshiro256** stream, so any range can be generated on any thread and the
+// output is byte-identical however the work is split.
+class HTTP10CorpusGenerator {
+public:
+    // Throws std::invalid_argument on empty or all-zero weight lists
+    explicit HTTP10CorpusGenerator(HTTP10CorpusOptions options);
+
+    // Appends records [first, first + count) to `out` in the configured format
+    HTTP10CorpusStats append(std::string& out, uint64_t first, size_t count) const;
+
+    // Single message without framing
+    [[nodiscard]] std::string message(uint64_t index) const;
+
+    // Whether record `index` is one of the invalidRatio defective ones
+    [[nodiscard]] bool isInvalid(uint64_t index) const;
+
+    // Writes `count` records with `threads` workers (0 = hardware threads).
+    // Throws std::runtime_error if the file cannot be written.
+    HTTP10CorpusStats writeFile(const std::string& path, uint64_t count, unsigned threads = 0) const;
+
+    // Splits a generated buffer back into messages; stops at a truncated
+    // trailing record
+    static std::vector<std::string_view> splitRecords(std::string_view data, RecordFormat format);
+
+    [[nodiscard]] const HTTP10CorpusOptions& options() const { return opt; }
+
+private:
+    // Cumulative weights for one draw from a WeightedCount list
+    struct Table {
+        std::vector<double> cumulative;
+        std::vector<int> values;
+
+        int pick(Xoshiro256& rng) const;
+    };
+
+    [[nodiscard]] Xoshiro256 recordRng(uint64_t index) const;
+    bool build(uint64_t index, std::string& out) const;   // returns true if invalid
+
+    HTTP10CorpusOptions opt;
+    Table headerTable;
+    Table depthTable;
+    Table methodTable;          // values index opt.methods
+};
+
+#endif
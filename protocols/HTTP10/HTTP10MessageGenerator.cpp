@@ -1,15 +1,13 @@
 #include "HTTP10MessageGenerator.h"
-#include <sstream>
-#include <cstdlib>
+#include <random>
 
 //
 // --- URI builder ---
 //
-std::string HTTP10MessageGenerator::buildURI(const HTTP10MessageOptions& opt, bool valid) {
-    std::stringstream ss;
-
+void HTTP10MessageGenerator::buildURI(const HTTP10MessageOptions& opt, bool valid,
+                                      Xoshiro256& rng, std::string& out) {
     if (valid) {
-        ss << "/";
+        out += "/";
 
         bool first = true;
 
@@ -20,126 +18,134 @@ std::string HTTP10MessageGenerator::buildURI(const HTTP10MessageOptions& opt, bo
             if (seg.find('/') != std::string::npos) continue;
 
             if (!first)
-                ss << "/";
+                out += "/";
 
-            ss << seg;
+            out += seg;
             first = false;
         }
 
         // Only add extension if we already have a filename
         if (!opt.extension.empty() && !first) {
-            ss << "." << opt.extension;
+            out += ".";
+            out += opt.extension;
         }
 
         // If no path segments were valid → default to "/index"
         if (first) {
-            ss.str("");
-            ss << "/";
-            if (!opt.extension.empty())
-                ss << "index." << opt.extension;
-            else
-                ss << "index";
+            out += "index";
+            if (!opt.extension.empty()) {
+                out += ".";
+                out += opt.extension;
+            }
         }
-
-        return ss.str();
+        return;
     }
 
     // INVALID CASES BELOW
-    int r = rand() % 4;
-    switch (r) {
-        case 0: return "index..html";
-        case 1: return "/bad path/file";
-        case 2: return "noslash.html";
-        case 3: return "/";
+    switch (rng.below(4)) {
+        case 0: out += "index..html"; return;
+        case 1: out += "/bad path/file"; return;
+        case 2: out += "noslash.html"; return;
+        case 3: out += "/"; return;
     }
-    return "/invalid";
+    out += "/invalid";
 }
 
 
 //
 // --- HEADER builder ---
 //
-std::string HTTP10MessageGenerator::buildHeader(const HeaderOption& h, bool overallInvalid) {
-    std::stringstream ss;
-
+void HTTP10MessageGenerator::buildHeader(const HeaderOption& h, bool overallInvalid,
+                                         Xoshiro256& rng, std::string& out) {
     bool breakHeader = h.forceInvalid || overallInvalid;
 
     if (!breakHeader) {
         // valid header
-        ss << h.name << ": " << h.value << "\r\n";
-        return ss.str();
+        out += h.name;
+        out += ": ";
+        out += h.value;
+        out += "\r\n";
+        return;
     }
 
     // INVALID HEADER cases
-    int r = rand() % 4;
-    switch (r) {
-        case 0: return h.name + " " + h.value + "\r\n";                // missing colon
-        case 1: return h.name + ":: " + h.value + "\r\n";              // double colon
-        case 2: return h.name + ": \r\n";                              // missing value
-        case 3: return h.name + "@!: " + h.value + "\r\n";             // illegal chars
+    out += h.name;
+    switch (rng.below(4)) {
+        case 0: out += " ";   out += h.value; break;    // missing colon
+        case 1: out += ":: "; out += h.value; break;    // double colon
+        case 2: out += ": ";                  break;    // missing value
+        case 3: out += "@!: "; out += h.value; break;   // illegal chars
     }
-
-    return h.name + ": broken\r\n";
+    out += "\r\n";
 }
 
 //
 // --- Build VALID message ---
 //
-std::string HTTP10MessageGenerator::buildValid(const HTTP10MessageOptions& opt) {
-    std::stringstream msg;
-
+void HTTP10MessageGenerator::buildValid(const HTTP10MessageOptions& opt, Xoshiro256& rng,
+                                        std::string& out) {
     // Request-Line
-    msg << opt.method << " "
-        << buildURI(opt, true) << " "
-        << "HTTP/1.0\r\n";
+    out += opt.method;
+    out += " ";
+    buildURI(opt, true, rng, out);
+    out += " HTTP/1.0\r\n";
 
     // Headers
+    bool hasContentLength = false;
     for (auto& h : opt.headers) {
         if (!h.enabled) continue;
-        msg << buildHeader(h, false);
+        buildHeader(h, false, rng, out);
+        if (h.name == "Content-Length") hasContentLength = true;
     }
 
-    msg << "\r\n";
-    return msg.str();
+    // A POST is only valid with a declared (here: empty) body
+    if (opt.method == "POST" && !hasContentLength)
+        out += "Content-Length: 0\r\n";
+
+    out += "\r\n";
 }
 
 //
 // --- Build INVALID message ---
 //
-std::string HTTP10MessageGenerator::buildInvalid(const HTTP10MessageOptions& opt) {
-    std::stringstream msg;
-
+void HTTP10MessageGenerator::buildInvalid(const HTTP10MessageOptions& opt, Xoshiro256& rng,
+                                          std::string& out) {
     // Randomly break method or version
-    int r = rand() % 5;
-
-    std::string method = opt.method;
-    std::string version = "HTTP/1.0";
+    uint64_t r = rng.below(5);
 
-    if (r == 0) method = "GEX";       // invalid method
-    if (r == 1) version = "HTTP/2.0"; // wrong version
-
-    msg << method << " "
-        << buildURI(opt, false) << " "
-        << version << "\r\n";
+    out += r == 0 ? "GEX" : opt.method;           // invalid method
+    out += " ";
+    buildURI(opt, false, rng, out);
+    out += r == 1 ? " HTTP/2.0\r\n" : " HTTP/1.0\r\n";  // wrong version
 
     // Headers (may also be broken)
     for (auto& h : opt.headers) {
         if (!h.enabled) continue;
-        msg << buildHeader(h, true);
+        buildHeader(h, true, rng, out);
     }
 
     // Sometimes miss the final CRLF
-    if (rand() % 2 == 0)
-        msg << "\r\n";
-
-    return msg.str();
+    if (rng.below(2) == 0)
+        out += "\r\n";
 }
 
 //
 // --- Main entry ---
 //
-std::string HTTP10MessageGenerator::generate(const HTTP10MessageOptions& opt) {
+void HTTP10MessageGenerator::append(const HTTP10MessageOptions& opt, Xoshiro256& rng, std::string& out) {
     if (opt.validity == HTTP10ExampleKind::Valid)
-        return buildValid(opt);
-    return buildInvalid(opt);
+        buildValid(opt, rng, out);
+    else
+        buildInvalid(opt, rng, out);
+}
+
+std::string HTTP10MessageGenerator::generate(const HTTP10MessageOptions& opt, Xoshiro256& rng) {
+    std::string out;
+    append(opt, rng, out);
+    return out;
+}
+
+std::string HTTP10MessageGenerator::generate(const HTTP10MessageOptions& opt) {
+    thread_local Xoshiro256 rng(((uint64_t)std::random_device{}() << 32) ^ std::random_device{}());
+    return generate(opt, rng);
 }
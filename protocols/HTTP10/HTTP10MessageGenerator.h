@@ -3,17 +3,24 @@
 
 #include <string>
 #include "HTTP10MessageOptions.h"
+#include "../../utils/Xoshiro.h"
 
 class HTTP10MessageGenerator {
 public:
+    // Random choices (which part of an invalid message breaks) come from a
+    // per-thread generator seeded from std::random_device
     static std::string generate(const HTTP10MessageOptions& opt);
 
+    // Reproducible: the same options and generator state give the same bytes
+    static std::string generate(const HTTP10MessageOptions& opt, Xoshiro256& rng);
+    static void append(const HTTP10MessageOptions& opt, Xoshiro256& rng, std::string& out);
+
 private:
-    static std::string buildValid(const HTTP10MessageOptions& opt);
-    static std::string buildInvalid(const HTTP10MessageOptions& opt);
+    static void buildValid(const HTTP10MessageOptions& opt, Xoshiro256& rng, std::string& out);
+    static void buildInvalid(const HTTP10MessageOptions& opt, Xoshiro256& rng, std::string& out);
 
-    static std::string buildURI(const HTTP10MessageOptions& opt, bool valid);
-    static std::string buildHeader(const HeaderOption& h, bool overallInvalid);
+    static void buildURI(const HTTP10MessageOptions& opt, bool valid, Xoshiro256& rng, std::string& out);
+    static void buildHeader(const HeaderOption& h, bool overallInvalid, Xoshiro256& rng, std::string& out);
 };
 
 #endif
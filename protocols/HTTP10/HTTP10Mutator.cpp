@@ -0,0 +1,181 @@
+#include "HTTP10Mutator.h"
+
+#include <algorithm>
+
+#include "HTTP10Protocol.h"
+#include "HTTP10Tokenizer.h"
+
+const char* mutationKindName(MutationKind kind) {
+    switch (kind) {
+        case MutationKind::DeleteToken:        return "delete-token";
+        case MutationKind::DuplicateToken:     return "duplicate-token";
+        case MutationKind::SubstituteTerminal: return "substitute-terminal";
+        case MutationKind::RemoveCRLF:         return "remove-crlf";
+        case MutationKind::FlipByte:           return "flip-byte";
+        case MutationKind::Count:              break;
+    }
+    return "?";
+}
+
+const char* mutationRegionName(MutationRegion region) {
+    switch (region) {
+        case MutationRegion::Method:      return "Method";
+        case MutationRegion::URI:         return "URI";
+        case MutationRegion::Version:     return "Version";
+        case MutationRegion::RequestLine: return "RequestLine";
+        case MutationRegion::HeaderName:  return "HeaderName";
+        case MutationRegion::HeaderValue: return "HeaderValue";
+        case MutationRegion::Header:      return "Header";
+        case MutationRegion::Request:     return "Request";
+        case MutationRegion::Count:       break;
+    }
+    return "?";
+}
+
+uint64_t MutationStats::byKind(MutationKind k) const {
+    uint64_t n = 0;
+    for (uint64_t c : counts[(size_t)k]) n += c;
+    return n;
+}
+
+uint64_t MutationStats::byRegion(MutationRegion r) const {
+    uint64_t n = 0;
+    for (const auto& row : counts) n += row[(size_t)r];
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+HTTP10Mutator::HTTP10Mutator(MutatorOptions options) : opt(std::move(options)) {
+    if (opt.lexemes.empty())
+        opt.lexemes = HTTP10Protocol::terminalLexemes();
+    for (const auto& [terminal, forms] : opt.lexemes)
+        if (!forms.empty()) terminalForms.push_back(forms);
+    if (terminalForms.empty())
+        opt.weights[(size_t)MutationKind::SubstituteTerminal] = 0;
+
+    double total = 0;
+    for (size_t k = 0; k < cumulative.size(); ++k) {
+        total += std::max(0.0, opt.weights[k]);
+        cumulative[k] = total;
+    }
+    if (total <= 0) {
+        // Nothing enabled: fall back to deletions only
+        for (double& c : cumulative) c = 1.0;
+    }
+}
+
+// Assigns every token to the grammar region it sits in, following the
+// shape of http10.json: request line, then "Name: value" lines, then the
+// blank line
+bool HTTP10Mutator::addSeed(std::string_view message) {
+    HTTP10Tokenizer tokenizer;
+    std::vector<Token> tokens;
+    tokenizer.tokenize(message, tokens);
+    if (tokens.size() < 2) return false;     // only END_OF_INPUT
+
+    Seed seed;
+    seed.message.assign(message);
+
+    size_t line = 0;
+    size_t field = 0;               // request line: 0 method, 1 URI, 2+ version
+    bool lineEmpty = true;
+    bool colon = false;
+    bool valueStarted = false;
+
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+        const Token& t = tokens[i];
+        const uint32_t begin = (uint32_t)t.position;
+        const uint32_t end = (uint32_t)tokens[i + 1].position;
+
+        MutationRegion region;
+        const bool crlf = t.base == BaseToken::CRLF;
+        if (crlf) {
+            region = line == 0 ? MutationRegion::RequestLine
+                   : lineEmpty ? MutationRegion::Request
+                               : MutationRegion::Header;
+            line++;
+            lineEmpty = true;
+            colon = valueStarted = false;
+            seed.crlfs.push_back((uint32_t)seed.tokens.size());
+        } else if (line == 0) {
+            if (t.base == BaseToken::SP) {
+                region = MutationRegion::RequestLine;
+                field++;
+            } else {
+                region = field == 0 ? MutationRegion::Method
+                       : field == 1 ? MutationRegion::URI
+                                    : MutationRegion::Version;
+            }
+            lineEmpty = false;
+        } else {
+            if (!colon) {
+                colon = t.base == BaseToken::COLON;
+                region = colon ? MutationRegion::Header : MutationRegion::HeaderName;
+            } else if (t.base == BaseToken::SP && !valueStarted) {
+                region = MutationRegion::Header;
+            } else {
+                region = MutationRegion::HeaderValue;
+                valueStarted = true;
+            }
+            lineEmpty = false;
+        }
+        seed.tokens.push_back({begin, end, region, crlf});
+    }
+
+    seeds.push_back(std::move(seed));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Mutation
+// ---------------------------------------------------------------------------
+
+Mutation HTTP10Mutator::mutate(Xoshiro256& rng, std::string& out) const {
+    return mutate((size_t)rng.below(seeds.size()), rng, out);
+}
+
+Mutation HTTP10Mutator::mutate(size_t index, Xoshiro256& rng, std::string& out) const {
+    const Seed& s = seeds[index];
+    const std::string_view msg = s.message;
+
+    const double x = rng.uniform() * cumulative.back();
+    auto kind = (MutationKind)(std::upper_bound(cumulative.begin(), cumulative.end(), x) - cumulative.begin());
+    if (kind >= MutationKind::Count) kind = MutationKind::DeleteToken;
+    if (kind == MutationKind::RemoveCRLF && s.crlfs.empty()) kind = MutationKind::DeleteToken;
+
+    const uint32_t token = kind == MutationKind::RemoveCRLF
+                         ? s.crlfs[rng.below(s.crlfs.size())]
+                         : (uint32_t)rng.below(s.tokens.size());
+    const Span& span = s.tokens[token];
+
+    out.clear();
+    out.append(msg.substr(0, span.begin));
+    switch (kind) {
+        case MutationKind::DeleteToken:
+        case MutationKind::RemoveCRLF:
+            break;
+        case MutationKind::DuplicateToken:
+            out.append(msg.substr(span.begin, span.end - span.begin));
+            out.append(msg.substr(span.begin, span.end - span.begin));
+            break;
+        case MutationKind::SubstituteTerminal: {
+            const auto& forms = terminalForms[rng.below(terminalForms.size())];
+            out.append(forms[rng.below(forms.size())]);
+            break;
+        }
+        case MutationKind::FlipByte: {
+            const size_t at = out.size() + rng.below(span.end - span.begin);
+            out.append(msg.substr(span.begin, span.end - span.begin));
+            out[at] = (char)(out[at] ^ (1u << rng.below(8)));
+            break;
+        }
+        case MutationKind::Count:
+            break;
+    }
+    out.append(msg.substr(span.end));
+
+    return {kind, span.region, (uint32_t)index, token, span.begin};
+}
@@ -0,0 +1,113 @@
+//
+// Grammar-aware mutation of valid HTTP/1.0 requests into invalid-message
+// corpora for load-testing the error paths.
+//
+
+#ifndef HTTP10_MUTATOR_H
+#define HTTP10_MUTATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../utils/Xoshiro.h"
+
+enum class MutationKind : uint8_t {
+    DeleteToken,
+    DuplicateToken,
+    SubstituteTerminal,     // token replaced by a lexeme of a random grammar terminal
+    RemoveCRLF,
+    FlipByte,               // one bit of one byte inside a token
+    Count
+};
+
+// Where a mutation landed, named after the http10.json nonterminal that
+// owns the token: separators belong to the enclosing rule (the SPs and
+// CRLF of the request line to RequestLine, ": " and CRLF to Header, the
+// closing blank line to Request)
+enum class MutationRegion : uint8_t {
+    Method,
+    URI,
+    Version,
+    RequestLine,
+    HeaderName,
+    HeaderValue,
+    Header,
+    Request,
+    Count
+};
+
+const char* mutationKindName(MutationKind kind);
+const char* mutationRegionName(MutationRegion region);
+
+struct Mutation {
+    MutationKind kind = MutationKind::DeleteToken;
+    MutationRegion region = MutationRegion::Request;
+    uint32_t seed = 0;          // index of the mutated seed message
+    uint32_t token = 0;         // index of the mutated token in the seed
+    uint32_t offset = 0;        // byte offset of that token in the seed
+};
+
+struct MutationStats {
+    std::array<std::array<uint64_t, (size_t)MutationRegion::Count>, (size_t)MutationKind::Count> counts{};
+    uint64_t total = 0;
+
+    void add(const Mutation& m) {
+        counts[(size_t)m.kind][(size_t)m.region]++;
+        total++;
+    }
+    [[nodiscard]] uint64_t byKind(MutationKind k) const;
+    [[nodiscard]] uint64_t byRegion(MutationRegion r) const;
+};
+
+struct MutatorOptions {
+    // Relative frequency of each MutationKind
+    std::array<double, (size_t)MutationKind::Count> weights{1, 1, 1, 1, 1};
+
+    // Surface forms per grammar terminal for SubstituteTerminal; empty
+    // means HTTP10Protocol::terminalLexemes()
+    std::map<std::string, std::vector<std::string>> lexemes;
+};
+
+// Seeds are tokenized once by addSeed(); mutate() is then a few spans
+// copied into the caller's buffer (cleared, capacity kept), so it neither
+// tokenizes nor allocates in steady state. mutate() is const: threads can
+// share one mutator, each with its own Xoshiro256 and buffer.
+class HTTP10Mutator {
+public:
+    explicit HTTP10Mutator(MutatorOptions options = {});
+
+    // Returns false (and keeps nothing) for a message with no tokens
+    bool addSeed(std::string_view message);
+    [[nodiscard]] size_t seedCount() const { return seeds.size(); }
+
+    // One mutant of a random seed / of seed `index`, written to `out`.
+    // At least one seed must have been added.
+    Mutation mutate(Xoshiro256& rng, std::string& out) const;
+    Mutation mutate(size_t index, Xoshiro256& rng, std::string& out) const;
+
+private:
+    struct Span {
+        uint32_t begin;
+        uint32_t end;
+        MutationRegion region;
+        bool crlf;
+    };
+
+    struct Seed {
+        std::string message;
+        std::vector<Span> tokens;
+        std::vector<uint32_t> crlfs;    // indices into tokens
+    };
+
+    MutatorOptions opt;
+    std::array<double, (size_t)MutationKind::Count> cumulative{};
+    std::vector<std::vector<std::string>> terminalForms;   // one entry per terminal
+    std::vector<Seed> seeds;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include "HTTP10Protocol.h"
 
+#include "../../utils/Metrics.h"
+
 
 // ----------------------------------------------------------
 // 1. Tokenize input using HTTP10Tokenizer
@@ -25,14 +27,9 @@ CFG HTTP10Protocol::getCFGFromPDA() {
     // Load PDA specification
     PDA pda("protocols/HTTP10/http10_pda.json");
 
-    // Convert PDA to CFG using standard algorithm
-    CFG cfg = pda.toCFG();
-
-    // Apply grammar simplification
-    cfg.removeUnreachableSymbols();
-    cfg.removeUselessProductions();
-
-    return cfg;
+    // Triple construction, built lazily from the start symbol: only
+    // productive, reachable [p,A,q] variables are ever created
+    return pda.toReducedCFG();
 }
 
 // ----------------------------------------------------------
@@ -40,15 +37,14 @@ CFG HTTP10Protocol::getCFGFromPDA() {
 // ----------------------------------------------------------
 SemanticResult HTTP10Protocol::validateSemantics(const std::vector<Token>& tokens)
 {
+    ScopedTimer timer(Stage::Semantics);
     HTTPRequest req;
+    std::string error;
 
-    try {
-        // Converts tokens → HTTPRequest (may throw on malformed structure)
-        req = HTTPRequest::fromTokens(tokens);
-    }
-    catch (const std::exception& ex) {
+    // Converts tokens → HTTPRequest (false on malformed structure)
+    if (!HTTPRequest::tryFromTokens(tokens, req, error)) {
         return SemanticResult::failure(
-            std::string("Malformed HTTP structure: ") + ex.what(),
+            "Malformed HTTP structure: " + error,
             "parser-structure-error"
         );
     }
@@ -60,4 +56,22 @@ SemanticResult HTTP10Protocol::validateSemantics(const std::vector<Token>& token
         return sem;
 
     return SemanticResult::success();
-}
\ No newline at end of file
+}
+
+// ----------------------------------------------------------
+// Surface forms of the grammar terminals
+// ----------------------------------------------------------
+std::map<std::string, std::vector<std::string>> HTTP10Protocol::terminalLexemes() {
+    return {
+        {"METHOD_GET", {"GET"}},
+        {"METHOD_POST", {"POST"}},
+        {"METHOD_HEAD", {"HEAD"}},
+        {"SLASH", {"/"}},
+        {"DOT", {"."}},
+        {"IDENT", {"index", "html", "img", "Host", "example", "abc123"}},
+        {"SP", {" "}},
+        {"COLON", {":"}},
+        {"HTTP_VERSION_1_0", {"HTTP/1.0"}},
+        {"CRLF", {"\r\n"}},
+    };
+}
@@ -6,6 +6,7 @@
 #define HTTP10PROTOCOL_H
 
 #include "../Protocol.h"
+#include <map>
 #include <vector>
 #include <string>
 #include "HTTP10Tokenizer.h"
@@ -27,6 +28,10 @@ public:
     CFG getCFGFromPDA();
 
     SemanticResult validateSemantics(const std::vector<Token>& tokens) override;
+
+    // Surface strings the tokenizer maps back onto each http10.json
+    // terminal, for grammar-driven generators (SentenceOptions::lexemes)
+    static std::map<std::string, std::vector<std::string>> terminalLexemes();
 };
 
 #endif
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include "HTTP10Tokenizer.h"
 #include <cctype>
 
-bool HTTP10Tokenizer::match(const std::string& text, const std::string& target) {
+#include "../../utils/Metrics.h"
+
+bool HTTP10Tokenizer::match(std::string_view text, std::string_view target) {
     if (text.compare(pos, target.size(), target) == 0) {
         return true;
     }
@@ -15,6 +17,14 @@ bool HTTP10Tokenizer::match(const std::string& text, const std::string& target)
 
 std::vector<Token> HTTP10Tokenizer::tokenize(const std::string& input) {
     std::vector<Token> tokens;
+    tokenize(std::string_view(input), tokens);
+    return tokens;
+}
+
+
+void HTTP10Tokenizer::tokenize(std::string_view input, std::vector<Token>& tokens) {
+    ScopedTimer timer(Stage::Tokenize);
+    tokens.clear();
     pos = 0;
 
     int line = 1;
@@ -127,14 +137,14 @@ std::vector<Token> HTTP10Tokenizer::tokenize(const std::string& input) {
     }
 
     tokens.emplace_back(BaseToken::END_OF_INPUT, "EOF", pos, line, col);
-    return tokens;
+    Metrics::add(Counter::Tokens, tokens.size());
 }
 
 
-Token HTTP10Tokenizer::readIdentifier(const std::string& input, int line, int col) {
+Token HTTP10Tokenizer::readIdentifier(std::string_view input, int line, int col) {
     size_t start = pos;
-    while (pos < input.size() && (std::isalnum(input[pos]) || input[pos] == '-' || input[pos] == '_')) {
+    while (pos < input.size() && (std::isalnum((unsigned char)input[pos]) || input[pos] == '-' || input[pos] == '_')) {
         pos++;
     }
-    return Token(BaseToken::IDENT, input.substr(start, pos - start), start);
+    return Token(BaseToken::IDENT, std::string(input.substr(start, pos - start)), start);
 }
@@ -6,6 +6,7 @@
 #define HTTP10TOKENIZER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include "../Token.h"
 #include "HTTPtoken.h"
@@ -14,14 +15,18 @@ class HTTP10Tokenizer {
 public:
     std::vector<Token> tokenize(const std::string& input);
 
+    // Same as above, but refills `tokens` in place so a caller that
+    // tokenizes many messages keeps one buffer (and its capacity).
+    void tokenize(std::string_view input, std::vector<Token>& tokens);
+
 private:
     size_t pos = 0;
 
-    bool match(const std::string& text, const std::string& target);
+    bool match(std::string_view text, std::string_view target);
     Token readCRLF(const std::string& input);
     Token readMethod(const std::string& input);
     Token readVersion(const std::string& input);
-    Token readIdentifier(const std::string& input , int line, int col);
+    Token readIdentifier(std::string_view input , int line, int col);
 };
 
 #endif
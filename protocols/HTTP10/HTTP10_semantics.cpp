@@ -1,4 +1,5 @@
 #include "HTTP10_semantics.h"
+#include <cctype>
 #include <regex>
 
 SemanticResult HTTP10_semantics::validateRequest(const HTTPRequest& req) {
@@ -16,6 +17,9 @@ SemanticResult HTTP10_semantics::validateRequest(const HTTPRequest& req) {
     r = validateHeaders(req);
     if (!r) return r;
 
+    r = validateBody(req);
+    if (!r) return r;
+
     return SemanticResult::success();
 }
 
@@ -81,6 +85,63 @@ SemanticResult HTTP10_semantics::validateHeaders(const HTTPRequest& req) {
     return SemanticResult::success();
 }
 
+bool HTTP10_semantics::contentLength(const HTTPRequest& req, uint64_t& length, bool& present) {
+    length = 0;
+    present = false;
+
+    for (const auto& h : req.headers) {
+        if (!isContentLength(h.name)) continue;
+
+        uint64_t v = 0;
+        if (!parseContentLength(h.value, v)) return false;
+        if (present && v != length) return false;
+        length = v;
+        present = true;
+    }
+    return true;
+}
+
+bool HTTP10_semantics::isContentLength(std::string_view headerName) {
+    if (headerName.size() != 14) return false;
+    for (size_t i = 0; i < 14; ++i)
+        if (std::tolower((unsigned char)headerName[i]) != "content-length"[i]) return false;
+    return true;
+}
+
+bool HTTP10_semantics::parseContentLength(std::string_view value, uint64_t& length) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+    if (value.empty() || value.size() > 19) return false;
+
+    uint64_t v = 0;
+    for (char c : value) {
+        if (c < '0' || c > '9') return false;
+        v = v * 10 + (uint64_t)(c - '0');
+    }
+    length = v;
+    return true;
+}
+
+SemanticResult HTTP10_semantics::validateBody(const HTTPRequest& req) {
+    uint64_t length = 0;
+    bool present = false;
+
+    if (!contentLength(req, length, present))
+        return SemanticResult::failure(
+            "Content-Length must be a single decimal number",
+            "invalid-content-length"
+        );
+
+    // RFC 1945, 7.2.2: a valid Content-Length is required on all POSTs
+    if (req.method == "POST" && !present)
+        return SemanticResult::failure(
+            "POST request without Content-Length",
+            "missing-content-length"
+        );
+
+    return SemanticResult::success();
+}
+
 bool HTTP10_semantics::isAscii(const std::string& s) {
     for (unsigned char c : s)
         if (c < 32 || c > 126)
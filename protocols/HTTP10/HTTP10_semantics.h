@@ -1,10 +1,12 @@
 #ifndef HTTP10_SEMANTICS_H
 #define HTTP10_SEMANTICS_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
-#include "HTTPRequest.h"
+#include "HTTPrequest.h"
 #include "../SemanticResult.h"
 
 class HTTP10_semantics {
@@ -12,12 +14,25 @@ public:
     // Validate entire request
     static SemanticResult validateRequest(const HTTPRequest& req);
 
+    // Declared body length. `present` is false without a Content-Length
+    // header; returns false if the value is not a decimal number or two
+    // Content-Length headers disagree.
+    static bool contentLength(const HTTPRequest& req, uint64_t& length, bool& present);
+
+    // The one Content-Length parser: semantics decides validity with it and
+    // HTTP10Framer the body boundary, so the two can never disagree.
+    // `value` is everything after the colon; surrounding spaces and tabs
+    // are ignored, the rest must be 1 to 19 decimal digits.
+    static bool isContentLength(std::string_view headerName);
+    static bool parseContentLength(std::string_view value, uint64_t& length);
+
 private:
     // Individual semantic checks
     static SemanticResult validateMethod(const HTTPRequest& req);
     static SemanticResult validateURI(const HTTPRequest& req);
     static SemanticResult validateVersion(const HTTPRequest& req);
     static SemanticResult validateHeaders(const HTTPRequest& req);
+    static SemanticResult validateBody(const HTTPRequest& req);
 
     // Helper utility
     static bool isAscii(const std::string& s);
@@ -1,10 +1,21 @@
-#include "HTTPRequest.h"
+#include "HTTPrequest.h"
 #include "../Token.h"
 #include <stdexcept>
 
 HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
 {
     HTTPRequest req;
+    std::string error;
+    if (!tryFromTokens(tokens, req, error))
+        throw std::runtime_error(error);
+    return req;
+}
+
+// Every token access is bounds-checked and every failure is a return, so
+// arbitrary token streams (see fuzz/) cost no exception unwinding
+bool HTTPRequest::tryFromTokens(const std::vector<Token>& tokens, HTTPRequest& req, std::string& error)
+{
+    req = HTTPRequest{};
     size_t i = 0;
 
     // -------------------------------
@@ -14,7 +25,8 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
         req.method = tokens[i].lexeme;   // "GET", "POST", ...
         i++;
     } else {
-        throw std::runtime_error("Missing HTTP method");
+        error = "Missing HTTP method";
+        return false;
     }
 
     // Skip spaces
@@ -41,7 +53,8 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
 
         req.uri = uri;
     } else {
-        throw std::runtime_error("Expected URI after method");
+        error = "Expected URI after method";
+        return false;
     }
 
     // Skip spaces
@@ -59,14 +72,16 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
         i++;
     }
     else {
-        throw std::runtime_error("Missing or invalid HTTP version");
+        error = "Missing or invalid HTTP version";
+        return false;
     }
 
     // Expect CRLF
-    if (i < tokens.size() && tokens[i].base == BaseToken::CRLF)
-        i++;
-    else
-        throw std::runtime_error("Expected CRLF after request line");
+    if (i >= tokens.size() || tokens[i].base != BaseToken::CRLF) {
+        error = "Expected CRLF after request line";
+        return false;
+    }
+    i++;
 
     // -------------------------------
     // HEADERS
@@ -78,8 +93,10 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
         i++;
 
         // Expect colon
-        if (i >= tokens.size() || tokens[i].base != BaseToken::COLON)
-            throw std::runtime_error("Expected ':' after header name");
+        if (i >= tokens.size() || tokens[i].base != BaseToken::COLON) {
+            error = "Expected ':' after header name";
+            return false;
+        }
         i++;
 
         // Optional space
@@ -88,7 +105,8 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
 
         // Header value
         std::string value;
-        while (i < tokens.size() && tokens[i].base != BaseToken::CRLF) {
+        while (i < tokens.size() && tokens[i].base != BaseToken::CRLF &&
+               tokens[i].base != BaseToken::END_OF_INPUT) {
             value += tokens[i].lexeme;
             i++;
         }
@@ -97,13 +115,28 @@ HTTPRequest HTTPRequest::fromTokens(const std::vector<Token>& tokens)
         h.value = value;
 
         // End-of-header CRLF
-        if (i < tokens.size() && tokens[i].base == BaseToken::CRLF)
-            i++;
-        else
-            throw std::runtime_error("Expected CRLF after header value");
+        if (i >= tokens.size() || tokens[i].base != BaseToken::CRLF) {
+            error = "Expected CRLF after header value";
+            return false;
+        }
+        i++;
 
         req.headers.push_back(std::move(h));
     }
 
-    return req;
+    // -------------------------------
+    // END OF HEADERS
+    // One token stream is one request: anything after the blank line is
+    // either a body or the next request, and must be split off first
+    // (see HTTP10Framer)
+    // -------------------------------
+    if (i < tokens.size() && tokens[i].base == BaseToken::CRLF)
+        i++;
+
+    if (i < tokens.size() && tokens[i].base != BaseToken::END_OF_INPUT) {
+        error = "Unexpected '" + tokens[i].lexeme + "' after end of headers";
+        return false;
+    }
+
+    return true;
 }
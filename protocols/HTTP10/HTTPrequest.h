@@ -17,7 +17,12 @@ struct HTTPRequest {
 
     std::vector<HTTPHeader> headers;
 
+    // Throws std::runtime_error on malformed structure
     static HTTPRequest fromTokens(const std::vector<Token>& tokens);
+
+    // Same, without exceptions: false and a message in `error` on
+    // malformed structure (`out` is then partially filled)
+    static bool tryFromTokens(const std::vector<Token>& tokens, HTTPRequest& out, std::string& error);
 };
 
 #endif
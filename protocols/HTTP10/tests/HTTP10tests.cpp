@@ -1,7 +1,45 @@
 #include "HTTP10tests.h"
 #include "../protocols/HTTP10/HTTP10Protocol.h"
+#include "../protocols/HTTP10/HTTP10_semantics.h"
+#include "../protocols/HTTP10/HTTP10CorpusGenerator.h"
+#include "../protocols/HTTP10/HTTP10MessageGenerator.h"
+#include "../protocols/HTTP10/HTTP10Mutator.h"
+#include "../grammers/PDA.h"
+#include "../grammers/PDAExecutor.h"
+#include "../grammers/DPDA.h"
+#include "../grammers/TerminalDFA.h"
+#include "../grammers/SentenceGenerator.h"
+#include "../parsers/CoverageGenerator.h"
+#include "../parsers/EarleyRecognizer.h"
+#include "../pipeline/BatchValidator.h"
+#include "../pipeline/StagedPipeline.h"
+#include "../pipeline/HTTP10StreamValidator.h"
+#include "../capture/CaptureValidator.h"
+#include "../fuzz/FuzzTargets.h"
+#include "../utils/Log.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
+#include "../utils/json.hpp"
+#ifdef HAVE_VALIDATION_SERVER
+#include "../server/ValidationServer.h"
+#include "../server/ValidationClient.h"
+#include "../server/ValidatingProxy.h"
+#include "../server/WireFormat.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <chrono>
+#include <random>
 #include <fstream>
 #include <iostream>
+#include <set>
+#include <sstream>
 #include <filesystem>
 
 std::string loadFile(const std::string& path) {
@@ -45,8 +83,7 @@ bool HTTP10Tests::runSingle(const std::string& filename) {
     return true;
 }
 
-void HTTP10Tests::runAll() {
-    static const char* cases[] = {
+static const char* cases[] = {
         "protocols/HTTP10/cases/valid_request_1.txt",
         "protocols/HTTP10/cases/valid_request_2.txt",
         "protocols/HTTP10/cases/invalid_header_format.txt",
@@ -55,11 +92,2060 @@ void HTTP10Tests::runAll() {
         "protocols/HTTP10/cases/invalid_version.txt",
         "protocols/HTTP10/cases/missing_crlf.txt",
         "protocols/HTTP10/cases/empty_header_value.txt",
+};
+
+// Every case file repeated: enough messages that all workers / stages
+// see many batches. Returns the sequential verdicts as the reference.
+static std::vector<Verdict> buildCorpus(const HTTP10Validator& validator,
+                                        std::vector<std::string>& storage,
+                                        std::vector<std::string_view>& corpus)
+{
+    for (auto f : cases)
+        storage.push_back(loadFile(f));
+
+    for (int rep = 0; rep < 200; ++rep)
+        for (const auto& in : storage)
+            corpus.emplace_back(in);
+
+    ValidatorScratch scratch;
+    std::vector<Verdict> expected;
+    for (auto msg : corpus)
+        expected.push_back(validator.validate(msg, scratch));
+    return expected;
+}
+
+static bool sameVerdicts(const std::vector<Verdict>& a, const std::vector<Verdict>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].code != b[i].code || a[i].errorOffset != b[i].errorOffset)
+            return false;
+    }
+    return true;
+}
+
+bool HTTP10Tests::runFraming() {
+    std::cout << "\n=== TEST: message framing ===\n";
+    bool ok = true;
+
+    // 1. Vectorised blank-line search against a byte-by-byte reference,
+    //    from every start offset (covers the 16-byte blocks and the tail)
+    auto reference = [](std::string_view d, size_t from) -> size_t {
+        for (size_t i = from; i < d.size(); ++i) {
+            if (d[i] != '\n') continue;
+            if (i + 1 < d.size() && d[i + 1] == '\n') return i + 2;
+            if (i + 2 < d.size() && d[i + 1] == '\r' && d[i + 2] == '\n') return i + 3;
+        }
+        return std::string_view::npos;
     };
+    std::mt19937 rng(31);
+    const char alphabet[] = {'\r', '\n', 'a', 'a', 'a', 'a'};
+    bool searchOk = true;
+    for (int round = 0; round < 400 && searchOk; ++round) {
+        std::string data(rng() % 80, 'a');
+        for (char& c : data) c = alphabet[rng() % sizeof(alphabet)];
+        for (size_t from = 0; from <= data.size(); ++from)
+            searchOk &= HTTP10Framer::findHeaderEnd(data, from) == reference(data, from);
+    }
+    std::cout << (searchOk ? "[PASS]" : "[FAIL]") << " header terminator search\n";
+    ok &= searchOk;
+
+    // 2. Back-to-back requests, an empty line between two of them, a POST
+    //    body that itself contains a blank line, and a partial request
+    const std::string get = "GET /index.html HTTP/1.0\r\nUser-Agent: Test\r\n\r\n";
+    const std::string post = "POST /api/data HTTP/1.0\r\nContent-Length: 9\r\n\r\nab\r\n\r\ncd\n";
+    const std::string head = "HEAD /a.txt HTTP/1.0\n\n";
+    const std::string partial = "GET /b HTTP/1.0\r\nUser-";
+    const std::string stream = get + "\r\n" + post + head + get + partial;
+
+    std::vector<FramedMessage> frames;
+    size_t consumed = 0;
+    FrameStatus status = HTTP10Framer::split(stream, frames, consumed);
+    bool splitOk = status == FrameStatus::Incomplete &&
+                   frames.size() == 4 &&
+                   frames[1].offset == get.size() + 2 &&
+                   frames[1].body == "ab\r\n\r\ncd\n" &&
+                   frames[2].head == head && frames[2].body.empty() &&
+                   consumed == stream.size() - partial.size();
+    std::cout << (splitOk ? "[PASS]" : "[FAIL]") << " stream split into " << frames.size()
+              << " requests, " << (stream.size() - consumed) << " bytes pending\n";
+    ok &= splitOk;
+
+    // 3. One call validates the whole stream; same verdicts as one by one
+    HTTP10Validator validator;
+    ValidatorScratch scratch;
+    std::vector<FramedMessage> streamFrames;
+    std::vector<Verdict> streamVerdicts;
+    size_t used = validator.validateStream(stream, scratch, streamFrames, streamVerdicts);
+
+    bool streamOk = used == consumed && streamVerdicts.size() == frames.size();
+    for (size_t i = 0; streamOk && i < frames.size(); ++i) {
+        Verdict single = validator.validate(frames[i].head, scratch);
+        streamOk = single.code == streamVerdicts[i].code && streamVerdicts[i].ok();
+    }
+
+    // A conflicting Content-Length ends the stream with a framing error
+    const std::string smuggled = "POST /x HTTP/1.0\r\nContent-Length: 3\r\nContent-Length: 4\r\n\r\nabcd";
+    streamFrames.clear();
+    streamVerdicts.clear();
+    used = validator.validateStream(get + smuggled, scratch, streamFrames, streamVerdicts);
+    streamOk &= used == get.size() + smuggled.size() &&
+                streamVerdicts.size() == 2 &&
+                streamVerdicts[0].ok() &&
+                streamVerdicts[1].code == VerdictCode::FramingError;
+    std::cout << (streamOk ? "[PASS]" : "[FAIL]") << " stream validation matches per-request validation\n";
+    ok &= streamOk;
 
+    // 4. The semantic layer no longer ignores a second request glued to the first
+    HTTP10Protocol protocol;
+    SemanticResult glued = protocol.validateSemantics(protocol.tokenize(get + get));
+    SemanticResult single = protocol.validateSemantics(protocol.tokenize(get));
+    bool semOk = !glued.ok && glued.code == "parser-structure-error" && single.ok;
+    std::cout << (semOk ? "[PASS]" : "[FAIL]") << " data after the blank line is reported\n";
+    ok &= semOk;
+
+    return ok;
+}
 
+bool HTTP10Tests::runBody() {
+    std::cout << "\n=== TEST: request bodies ===\n";
+    bool ok = true;
+
+    // 1. Reference XXH64 values, and streaming == one-shot
+    std::string text(100, 'x');
+    for (size_t i = 0; i < text.size(); ++i) text[i] = (char)('a' + i % 26);
+    XXH64 bytewise;
+    for (char c : text) bytewise.update(&c, 1);
+    bool hashOk = XXH64::hash("", 0) == 0xef46db3751d8e999ULL &&
+                  XXH64::hash("abc") == 0x44bc2cf5ad770999ULL &&
+                  bytewise.digest() == XXH64::hash(text);
+    std::cout << (hashOk ? "[PASS]" : "[FAIL]") << " XXH64\n";
+    ok &= hashOk;
+
+    // 2. Content-Length is part of header semantics
+    HTTP10Validator validator;
+    ValidatorScratch scratch;
+    Verdict noLength = validator.validate("POST /form HTTP/1.0\r\nUser-Agent: Test\r\n\r\n", scratch);
+    Verdict badLength = validator.validate("POST /form HTTP/1.0\r\nContent-Length: 12x\r\n\r\n", scratch);
+    Verdict withLength = validator.validate("POST /form HTTP/1.0\r\nContent-Length: 12\r\n\r\n", scratch);
+    bool semOk = noLength.code == VerdictCode::MissingContentLength &&
+                 badLength.code == VerdictCode::InvalidContentLength &&
+                 withLength.ok();
+
+    // Validity and the body boundary come from one parser: a head the
+    // validator accepts frames with exactly its declared length
+    for (const char* value : {"12", " 12", "12 ", "  12  ", "012", "1 2", "", " ", "12x", "-1",
+                              "9999999999999999999", "99999999999999999999"}) {
+        const std::string head = std::string("POST /form HTTP/1.0\r\nContent-Length:") + value + "\r\n\r\n";
+        uint64_t framed = 0, parsed = 0;
+        bool present = false;
+        const bool framerOk = HTTP10Framer::contentLength(head, framed, present);
+        const bool valid = validator.validate(head, scratch).ok();
+        semOk &= framerOk == HTTP10_semantics::parseContentLength(value, parsed) &&
+                 (!valid || (framerOk && present && framed == parsed));
+    }
+    std::cout << (semOk ? "[PASS]" : "[FAIL]") << " Content-Length semantics\n";
+    ok &= semOk;
+
+    // 3. A 4 MiB upload between two GETs, fed in packet-sized chunks (heads
+    //    split across chunks too), then a POST cut off mid-body
+    const size_t bodySize = 4u << 20;
+    const std::string get = "GET /index.html HTTP/1.0\r\nUser-Agent: Test\r\n\r\n";
+    const std::string upload = "POST /upload HTTP/1.0\r\nContent-Length: " + std::to_string(bodySize) + "\r\n\r\n";
+    const std::string cut = "POST /upload HTTP/1.0\r\nContent-Length: 100\r\n\r\n0123456789";
+
+    std::vector<StreamedRequest> seen;
+    std::vector<std::string> samples;
+    BodyOptions body;
+    body.hash = true;
+    body.sampleBytes = 16;
+    HTTP10StreamValidator stream(validator, [&](const StreamedRequest& r) {
+        seen.push_back(r);
+        samples.emplace_back(r.sample);
+    }, {}, body);
+
+    auto feedIn = [&](std::string_view data, size_t step) {
+        for (size_t i = 0; i < data.size(); i += step)
+            stream.feed(data.substr(i, std::min(step, data.size() - i)));
+    };
+
+    feedIn(get, 7);
+    feedIn(upload, 1500);
+    XXH64 expectedHash;
+    std::string expectedSample;
+    std::string block(1500, '\0');
+    for (size_t done = 0; done < bodySize; done += block.size()) {
+        size_t n = std::min(block.size(), bodySize - done);
+        for (size_t i = 0; i < n; ++i) block[i] = (char)((done + i) * 131 % 251);
+        if (done == 0) expectedSample = block.substr(0, 16);
+        expectedHash.update(block.data(), n);
+        // The next GET rides in the same chunk as the end of the body
+        if (done + n == bodySize) stream.feed(std::string(block.data(), n) + get);
+        else stream.feed(std::string_view(block.data(), n));
+    }
+    feedIn(cut, 9);
+    stream.finish();
+
+    const StreamStats& st = stream.stats();
+    bool streamOk = seen.size() == 4 &&
+                    seen[0].verdict.ok() && seen[0].bodyLength == 0 &&
+                    seen[1].verdict.ok() && seen[1].bodyReceived == bodySize &&
+                    seen[1].bodyHash == expectedHash.digest() && samples[1] == expectedSample &&
+                    seen[2].verdict.ok() && seen[2].offset == get.size() + upload.size() + bodySize &&
+                    seen[3].verdict.code == VerdictCode::TruncatedBody && seen[3].bodyReceived == 10 &&
+                    st.bodyBytes == bodySize + 10 &&
+                    st.maxBuffered < 4096;      // a head plus one chunk, not O(body)
+    std::cout << "requests=" << st.requests << " body bytes=" << st.bodyBytes
+              << " max buffered=" << st.maxBuffered << "\n";
+    std::cout << (streamOk ? "[PASS]" : "[FAIL]") << " bodies streamed with bounded memory\n";
+    ok &= streamOk;
+
+    return ok;
+}
+
+bool HTTP10Tests::runBatch() {
+    std::cout << "\n=== TEST: batch validation ===\n";
+
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+
+    BatchValidator batch(validator, {4, 16});
+    BatchReport report = batch.run(corpus);
+
+    bool ok = report.total.messages == corpus.size() &&
+              sameVerdicts(report.verdicts, expected) &&
+              expected[0].ok();     // valid_request_1
+
+    std::cout << "messages=" << report.total.messages
+              << " accepted=" << report.total.accepted
+              << " syntax=" << report.total.syntaxErrors
+              << " semantic=" << report.total.semanticErrors
+              << " steals=" << report.total.steals << "\n";
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " batch verdicts match sequential run\n";
+    return ok;
+}
 
+bool HTTP10Tests::runCache() {
+    std::cout << "\n=== TEST: verdict cache ===\n";
+    bool ok = true;
+
+    // 1. LRU order within a shard: a lookup protects an entry from eviction
+    CacheOptions tiny;
+    tiny.shards = 1;
+    tiny.maxBytes = 4 * VerdictCache::entryBytes();
+    VerdictCache lru(tiny);
+    Verdict v;
+    v.code = VerdictCode::Ok;
+    const char* keys[] = {"a", "b", "c", "d", "e", "f"};
+    for (int i = 0; i < 4; ++i) lru.insert(lru.key(keys[i]), v);
+    Verdict out;
+    lru.lookup(lru.key("a"), out);                  // a is now most recent
+    lru.insert(lru.key("e"), v);                    // evicts b
+    lru.insert(lru.key("f"), v);                    // evicts c
+    bool lruOk = lru.capacity() == 4 &&
+                 lru.lookup(lru.key("a"), out) && out.ok() &&
+                 !lru.lookup(lru.key("b"), out) && !lru.lookup(lru.key("c"), out) &&
+                 lru.lookup(lru.key("d"), out) && lru.stats().evictions == 2;
+    std::cout << (lruOk ? "[PASS]" : "[FAIL]") << " least recently used entry is evicted first\n";
+    ok &= lruOk;
+
+    // 2. Memory cap holds under many distinct messages
+    CacheOptions capped;
+    capped.maxBytes = 1u << 20;
+    VerdictCache bounded(capped);
+    for (int i = 0; i < 100000; ++i)
+        bounded.insert(bounded.key("GET /" + std::to_string(i) + " HTTP/1.0\r\n\r\n"), v);
+    CacheStats bs = bounded.stats();
+    bool capOk = bs.bytes <= capped.maxBytes && bs.evictions > 0 && bs.entries == bounded.capacity();
+    std::cout << "entries=" << bs.entries << " bytes=" << bs.bytes << " evictions=" << bs.evictions << "\n";
+    std::cout << (capOk ? "[PASS]" : "[FAIL]") << " cache stays under its memory cap\n";
+    ok &= capOk;
+
+    // 3. Repetitive corpus through the batch validator: same verdicts,
+    //    nearly everything answered from the cache
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+
+    VerdictCache cache;
+    BatchOptions options{4, 16};
+    options.cache = &cache;
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    Metrics::setEnabled(true);
+    BatchReport report = BatchValidator(validator, options).run(corpus);
+    Metrics::setEnabled(false);
+    const MetricsSnapshot m = Metrics::snapshot();
+    Metrics::reset();
+    CacheStats cs = cache.stats();
+
+    // Hits count as traffic like misses do
+    uint64_t rejected = 0;
+    for (const Verdict& e : expected) rejected += !e.ok();
+
+    size_t unique = sizeof(cases) / sizeof(cases[0]);
+    bool batchOk = sameVerdicts(report.verdicts, expected) &&
+                   cs.hits + cs.misses == corpus.size() &&
+                   report.total.cacheHits == cs.hits &&
+                   cs.entries == unique &&
+                   cs.misses <= unique * options.workers &&  // racing first lookups
+                   m.counter(Counter::Messages) == corpus.size() &&
+                   m.counter(Counter::Rejected) == rejected &&
+                   m.counter(Counter::CacheHits) == cs.hits;
+    std::cout << "hits=" << cs.hits << " misses=" << cs.misses
+              << " hit rate=" << cs.hitRate() * 100.0 << "%\n";
+    std::cout << (batchOk ? "[PASS]" : "[FAIL]") << " cached verdicts match sequential run\n";
+    ok &= batchOk;
+
+    return ok;
+}
+
+bool HTTP10Tests::runDiagnostics() {
+    std::cout << "\n=== TEST: on-demand diagnostics ===\n";
+
+    HTTP10Validator validator;
+    ValidatorScratch scratch;
+    SLR reference(CFG("protocols/HTTP10/http10.json"));
+
+    bool sameVerdicts = true;
+    bool sameDiagnostics = true;
+    bool silent = true;
+    std::string example;
+
+    uint64_t explainSamples = 0;
+    for (auto f : cases) {
+        std::string input = loadFile(f);
+        Verdict v = validator.validate(input, scratch);
+
+        // explain() leaves no trace in the metrics
+        Metrics::setEnabled(false);
+        Metrics::reset();
+        Metrics::setEnabled(true);
+        Diagnosis d = validator.explain(input);
+        Metrics::setEnabled(false);
+        const MetricsSnapshot m = Metrics::snapshot();
+        Metrics::reset();
+        for (size_t s = 0; s < (size_t)Stage::Count; ++s) explainSamples += m.stages[s].count;
+        explainSamples += m.counter(Counter::Tokens) + m.counter(Counter::Messages);
+
+        sameVerdicts &= d.verdict.code == v.code && d.verdict.errorOffset == v.errorOffset;
+        if (v.code != VerdictCode::SyntaxError) continue;
+
+        // Reference: the string-based parse(), with std::cout captured
+        std::vector<std::string> names;
+        for (int t : scratch.terminals)
+            names.push_back(t < 0 ? "UNKNOWN" : validator.parser().terminalName(t));
+
+        std::ostringstream captured;
+        std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+        bool accepted = reference.parse(names);
+        std::cout.rdbuf(old);
+        silent &= captured.str().empty();
+
+        const DiagnosticInfo& ref = reference.lastDiagnostic;
+        sameDiagnostics &= !accepted &&
+                           d.syntax.expected == ref.expected &&
+                           d.syntax.got == ref.got &&
+                           d.syntax.message == ref.message &&
+                           scratch.tokens[reference.lastErrorIndex].position == v.errorOffset &&
+                           d.line > 0;
+        if (example.empty()) example = d.format();
+    }
+
+    std::cout << example;
+    std::cout << (sameVerdicts ? "[PASS]" : "[FAIL]") << " explain() verdicts match validate()\n";
+    std::cout << (sameDiagnostics ? "[PASS]" : "[FAIL]") << " explain() diagnostics match SLR::parse()\n";
+    std::cout << (silent ? "[PASS]" : "[FAIL]") << " SLR::parse() writes nothing to std::cout\n";
+    std::cout << (explainSamples == 0 ? "[PASS]" : "[FAIL]") << " explain() records no metrics\n";
+    return sameVerdicts && sameDiagnostics && silent && explainSamples == 0;
+}
+
+bool HTTP10Tests::runLogging() {
+    std::cout << "\n=== TEST: logging ===\n";
+
+    struct Record { LogLevel level; std::string component, message; };
+    std::vector<Record> records;
+    Log::setSink([&](LogLevel level, std::string_view component, std::string_view message) {
+        records.push_back({level, std::string(component), std::string(message)});
+    });
+    LogLevel saved = Log::level();
+
+    SLR slr(CFG("protocols/HTTP10/http10.json"));
+    const std::vector<std::string> bad = {"METHOD_GET", "METHOD_GET"};
+
+    // 1. Default threshold: parse errors are silent, operands never evaluated
+    Log::setLevel(LogLevel::Warn);
+    int evaluated = 0;
+    LOG_DEBUG("test") << ++evaluated;
+    bool rejected = !slr.parse(bad);
+    bool quietOk = rejected && records.empty() && evaluated == 0;
+    std::cout << (quietOk ? "[PASS]" : "[FAIL]") << " records below the threshold cost nothing\n";
+
+    // 2. Debug threshold: the parser dump reaches the sink
+    Log::setLevel(LogLevel::Debug);
+    rejected = !slr.parse(bad);
+    bool dumpOk = !Log::compiled(LogLevel::Debug) ||
+                  (rejected && records.size() == 1 &&
+                   records[0].level == LogLevel::Debug && records[0].component == "SLR" &&
+                   records[0].message.find("METHOD_GET") != std::string::npos);
+    std::cout << (dumpOk ? "[PASS]" : "[FAIL]") << " parser diagnostics go to the sink\n";
+
+    // 3. Engine warnings use the same path
+    records.clear();
+    Log::setLevel(LogLevel::Warn);
+    CFG missing("protocols/HTTP10/does_not_exist.json");
+    bool errorOk = records.size() == 1 && records[0].level == LogLevel::Error &&
+                   records[0].component == "CFG";
+    std::cout << (errorOk ? "[PASS]" : "[FAIL]") << " engine errors go to the sink\n";
+
+    Log::setLevel(saved);
+    Log::setSink(Log::streamSink(std::cerr));
+    return quietOk && dumpOk && errorOk;
+}
+
+bool HTTP10Tests::runMetrics() {
+    std::cout << "\n=== TEST: stage metrics ===\n";
+
+    // 1. Bucket layout: each value lands in a bucket whose upper bound is
+    //    within 1/16 of it, and the previous bucket ends below it
+    bool bucketsOk = true;
+    for (uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 100ull, 1000ull, 123456ull, 1ull << 40, ~0ull}) {
+        int b = LatencyHistogram::bucketOf(v);
+        uint64_t upper = LatencyHistogram::bucketUpper(b);
+        bucketsOk &= b >= 0 && b < LatencyHistogram::BUCKETS && upper >= v && upper - v <= v / 16;
+        if (b > 0) bucketsOk &= LatencyHistogram::bucketUpper(b - 1) < v;
+    }
+    std::cout << (bucketsOk ? "[PASS]" : "[FAIL]") << " histogram buckets stay within 6.25%\n";
+
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+
+    // 2. Disabled (the default): nothing is recorded
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    ValidatorScratch scratch;
+    for (auto msg : corpus)
+        (void)validator.validate(msg, scratch);
+    MetricsSnapshot idle = Metrics::snapshot();
+    bool idleOk = idle.counter(Counter::Messages) == 0 && idle.stage(Stage::Parse).count == 0;
+    std::cout << (idleOk ? "[PASS]" : "[FAIL]") << " disabled metrics record nothing\n";
+
+    // 3. Enabled: one sequential pass plus a 4-worker batch
+    Metrics::setEnabled(true);
+    for (auto msg : corpus)
+        (void)validator.validate(msg, scratch);
+    BatchReport report = BatchValidator(validator, {4, 16}).run(corpus);
+    Metrics::setEnabled(false);
+    MetricsSnapshot m = Metrics::snapshot();
+
+    uint64_t messages = 2 * corpus.size();
+    uint64_t rejected = 0, syntax = 0, semanticRuns = 0;
+    for (const Verdict& v : expected) {
+        rejected += v.ok() ? 0 : 2;
+        syntax += v.code == VerdictCode::SyntaxError ? 2 : 0;
+        semanticRuns += v.syntaxOk ? 2 : 0;
+    }
+    uint64_t errorSum = 0;
+    for (uint64_t e : m.errors) errorSum += e;
+
+    const HistogramSnapshot& parse = m.stage(Stage::Parse);
+    bool countsOk = sameVerdicts(report.verdicts, expected) &&
+                    m.counter(Counter::Messages) == messages &&
+                    m.counter(Counter::Rejected) == rejected && errorSum == rejected &&
+                    m.errors[(size_t)VerdictCode::SyntaxError] == syntax &&
+                    m.stage(Stage::Tokenize).count == messages &&
+                    parse.count == messages &&
+                    m.stage(Stage::Semantics).count == semanticRuns &&
+                    m.counter(Counter::Tokens) > messages &&
+                    m.threads >= 2;
+    bool orderOk = parse.percentileNanos(0.5) <= parse.percentileNanos(0.99) &&
+                   parse.percentileNanos(0.99) <= parse.maxNanos && parse.maxNanos > 0;
+    std::cout << "parse: p50=" << parse.percentileNanos(0.5) << "ns p99=" << parse.percentileNanos(0.99)
+              << "ns max=" << parse.maxNanos << "ns over " << m.threads << " threads\n";
+    std::cout << (countsOk ? "[PASS]" : "[FAIL]") << " per-thread counters add up across workers\n";
+    std::cout << (orderOk ? "[PASS]" : "[FAIL]") << " percentiles are ordered\n";
+
+    // 4. Exports carry the same numbers
+    auto errorName = [](size_t code) -> const char* {
+        return code < (size_t)VerdictCode::Count ? verdictCodeName((VerdictCode)code) : nullptr;
+    };
+    nlohmann::json j = nlohmann::json::parse(m.toJson(errorName));
+    std::string prom = m.toPrometheus(errorName);
+    bool exportOk = j["stages"]["tokenize"]["count"] == messages &&
+                    j["errors"]["syntax-error"] == syntax &&
+                    prom.find("pv_messages_total " + std::to_string(messages) + "\n") != std::string::npos &&
+                    prom.find("pv_stage_seconds_count{stage=\"parse\"} " + std::to_string(messages)) != std::string::npos;
+    std::cout << (exportOk ? "[PASS]" : "[FAIL]") << " JSON and Prometheus exports match the snapshot\n";
+
+    Metrics::reset();
+    return bucketsOk && idleOk && countsOk && orderOk && exportOk;
+}
+
+bool HTTP10Tests::runTrace() {
+    std::cout << "\n=== TEST: trace recording ===\n";
+
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+    ValidatorScratch scratch;
+
+    // 1. Stopped: nothing is written
+    Trace::start(256);
+    Trace::stop();
+    for (auto msg : corpus)
+        (void)validator.validate(msg, scratch);
+    bool idleOk = Trace::stats().recorded == 0;
+    std::cout << (idleOk ? "[PASS]" : "[FAIL]") << " stopped trace records nothing\n";
+
+    // 2. A small ring keeps only the newest events
+    const size_t ring = 256;
+    Trace::start(ring);
+    for (auto msg : corpus)
+        (void)validator.validate(msg, scratch);
+    Trace::stop();
+
+    uint64_t spans = 0;     // validate + tokenize + parse (+ semantics)
+    for (const Verdict& v : expected)
+        spans += v.syntaxOk ? 4 : 3;
+    TraceStats small = Trace::stats();
+    nlohmann::json j = nlohmann::json::parse(Trace::toChromeJson());
+
+    size_t complete = 0;
+    bool eventsOk = true;
+    for (const auto& e : j["traceEvents"]) {
+        if (e["ph"] != "X") continue;
+        complete++;
+        eventsOk &= e["ts"].get<double>() >= 0.0 && e["dur"].get<double>() >= 0.0;
+    }
+    bool ringOk = small.threads == 1 && small.recorded == spans &&
+                  small.dropped == spans - ring && complete == ring && eventsOk;
+    std::cout << "recorded=" << small.recorded << " dropped=" << small.dropped
+              << " exported=" << complete << "\n";
+    std::cout << (ringOk ? "[PASS]" : "[FAIL]") << " ring stays bounded and exports the newest events\n";
+
+    // 3. Workers each get their own track
+    Trace::start();
+    BatchReport report = BatchValidator(validator, {4, 16}).run(corpus);
+    Trace::stop();
+    TraceStats batch = Trace::stats();
+    j = nlohmann::json::parse(Trace::toChromeJson());
+
+    std::set<int> tids;
+    for (const auto& e : j["traceEvents"])
+        if (e["ph"] == "X") tids.insert(e["tid"].get<int>());
+    bool threadsOk = sameVerdicts(report.verdicts, expected) &&
+                     batch.dropped == 0 && batch.recorded == spans &&
+                     tids.size() == batch.threads && batch.threads >= 1;
+    std::cout << (threadsOk ? "[PASS]" : "[FAIL]") << " per-thread tracks cover every span\n";
+
+    return idleOk && ringOk && threadsOk;
+}
+
+bool HTTP10Tests::runCorpus() {
+    std::cout << "\n=== TEST: corpus generator ===\n";
+
+    HTTP10CorpusOptions opt;
+    opt.seed = 42;
+    opt.invalidRatio = 0.25;
+    HTTP10CorpusGenerator gen(opt);
+
+    // 1. Same seed, same bytes, however the range is split
+    std::string whole, parts;
+    HTTP10CorpusStats st = gen.append(whole, 0, 3000);
+    gen.append(parts, 0, 1234);
+    gen.append(parts, 1234, 1766);
+    HTTP10CorpusOptions other = opt;
+    other.seed = 43;
+    std::string reseeded;
+    HTTP10CorpusGenerator(other).append(reseeded, 0, 3000);
+    bool seedOk = whole == parts && whole != reseeded && st.records == 3000;
+    std::cout << (seedOk ? "[PASS]" : "[FAIL]") << " records depend only on seed and index\n";
+
+    // 2. Both record formats split back into the same messages
+    auto records = HTTP10CorpusGenerator::splitRecords(whole, RecordFormat::NewlineDelimited);
+    HTTP10CorpusOptions prefixed = opt;
+    prefixed.format = RecordFormat::LengthPrefixed;
+    std::string binary;
+    HTTP10CorpusGenerator(prefixed).append(binary, 0, 3000);
+    auto binaryRecords = HTTP10CorpusGenerator::splitRecords(binary, RecordFormat::LengthPrefixed);
+    bool formatOk = records.size() == 3000 && records == binaryRecords;
+    for (size_t i = 0; formatOk && i < records.size(); i += 97)
+        formatOk = records[i] == gen.message(i);
+    std::cout << (formatOk ? "[PASS]" : "[FAIL]") << " newline-delimited and length-prefixed records round-trip\n";
+
+    // 3. Valid records pass, every invalid one is rejected
+    HTTP10Validator validator;
+    ValidatorScratch scratch;
+    size_t wrong = 0, invalid = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        bool expectInvalid = gen.isInvalid(i);
+        invalid += expectInvalid;
+        if (validator.validate(records[i], scratch).ok() == expectInvalid) {
+            if (wrong++ == 0)
+                std::cout << "unexpected verdict for record " << i << ":\n" << records[i] << "\n";
+        }
+    }
+    double ratio = (double)invalid / (double)records.size();
+    bool verdictOk = wrong == 0 && invalid == st.invalid && ratio > 0.2 && ratio < 0.3;
+    std::cout << "invalid=" << invalid << " mismatched=" << wrong << "\n";
+    std::cout << (verdictOk ? "[PASS]" : "[FAIL]") << " generated validity matches the validator\n";
+
+    // 4. Parallel file output is identical to the sequential buffer
+    std::string path = (std::filesystem::temp_directory_path() / "pv_corpus_test.txt").string();
+    HTTP10CorpusStats fileStats = gen.writeFile(path, 10000, 4);
+    std::string expected;
+    gen.append(expected, 0, 10000);
+    bool fileOk = loadFile(path) == expected && fileStats.records == 10000;
+    std::filesystem::remove(path);
+    std::cout << (fileOk ? "[PASS]" : "[FAIL]") << " multithreaded file output is byte-identical\n";
+
+    // 5. The single-message generator is reproducible with an explicit PRNG
+    HTTP10MessageOptions single;
+    single.path = {"a", "b"};
+    single.headers = {{"Host", "example.com", true, false}};
+    single.validity = HTTP10ExampleKind::Invalid;
+    Xoshiro256 r1(7), r2(7);
+    bool singleOk = true;
+    for (int i = 0; i < 50; ++i)
+        singleOk &= HTTP10MessageGenerator::generate(single, r1) == HTTP10MessageGenerator::generate(single, r2);
+    std::cout << (singleOk ? "[PASS]" : "[FAIL]") << " seeded single-message generation repeats\n";
+
+    return seedOk && formatOk && verdictOk && fileOk && singleOk;
+}
+
+bool HTTP10Tests::runSentences() {
+    std::cout << "\n=== TEST: sentence generator ===\n";
+
+    CFG grammar("protocols/HTTP10/http10.json");
+    SLR slr(grammar);
+    SentenceOptions opt;
+    opt.minLength = 12;
+    opt.maxLength = 60;
+    opt.lexemes = HTTP10Protocol::terminalLexemes();
+    opt.separator = "";
+    SentenceGenerator gen(grammar, opt);
+
+    // 1. Shortest yields and depths: "GET /x HTTP/1.0" CRLF CRLF
+    bool boundsOk = gen.minLength("Request") == 8 && gen.minLength("Headers") == 0 &&
+                    gen.minLength("Header") == 5 && gen.minDepth("Method") == 1 &&
+                    gen.minDepth("Request") == 4 && gen.minLength("Nope") == -1;
+    std::cout << (boundsOk ? "[PASS]" : "[FAIL]") << " minimum yields and derivation depths\n";
+
+    // 2. Every sentence is in the language and within the length bounds
+    Xoshiro256 rng(5);
+    SentenceScratch scratch;
+    std::vector<int> sentence, ids, stack;
+    size_t accepted = 0, inBounds = 0, longest = 0;
+    const int runs = 2000;
+    for (int i = 0; i < runs; ++i) {
+        bool ok = gen.generate(rng, scratch, sentence);
+        ids.clear();
+        for (int t : sentence) ids.push_back(slr.terminalId(gen.terminals()[t]));
+        accepted += ok && slr.accepts(ids, stack);
+        inBounds += sentence.size() >= opt.minLength && sentence.size() <= opt.maxLength;
+        longest = std::max(longest, sentence.size());
+    }
+    bool languageOk = accepted == (size_t)runs && inBounds == (size_t)runs;
+    std::cout << "accepted=" << accepted << " inBounds=" << inBounds << " longest=" << longest << "\n";
+    std::cout << (languageOk ? "[PASS]" : "[FAIL]") << " sentences parse and respect length bounds\n";
+
+    // 3. Surface text tokenizes back into a syntactically valid request,
+    //    and the corpus depends only on the seed
+    std::string corpus, again;
+    gen.appendCorpus(corpus, 0, 500, scratch);
+    gen.appendCorpus(again, 0, 200, scratch);
+    gen.appendCorpus(again, 200, 300, scratch);
+    HTTP10Validator validator;
+    ValidatorScratch vs;
+    size_t syntaxOk = 0, total = 0;
+    size_t start = 0;
+    for (size_t pos = 0; pos < corpus.size(); ++pos) {
+        if (corpus[pos] != '\n' || corpus[pos - 1] == '\r') continue;
+        std::string_view msg(corpus.data() + start, pos - start);
+        syntaxOk += validator.validate(msg, vs).syntaxOk;
+        total++;
+        start = pos + 1;
+    }
+    bool textOk = total == 500 && syntaxOk == total && corpus == again;
+    std::cout << "syntaxOk=" << syntaxOk << "/" << total << "\n";
+    std::cout << (textOk ? "[PASS]" : "[FAIL]") << " surface strings pass the HTTP/1.0 parser\n";
+
+    // 4. Weights steer the choice; left recursion with a tight bound still ends
+    SentenceOptions weighted;
+    weighted.weights.assign(grammar.getProductions().size(), 1.0);
+    for (size_t i = 0; i < grammar.getProductions().size(); ++i) {
+        const production& p = grammar.getProductions()[i];
+        if (p.lhs == "Method" && p.body[0] != "METHOD_HEAD") weighted.weights[i] = 0.0;
+    }
+    SentenceGenerator headOnly(grammar, weighted);
+    bool weightsOk = true;
+    for (int i = 0; i < 200 && weightsOk; ++i) {
+        weightsOk = headOnly.generate(rng, scratch, sentence) &&
+                    headOnly.terminals()[sentence[0]] == "METHOD_HEAD";
+    }
+
+    CFG loop;
+    loop.setVariables({"S"});
+    loop.setTerminals({"a"});
+    loop.setStartSymbol("S");
+    loop.setProductions({production("S", {"S", "S"}), production("S", {"S"}), production("S", {"a"})});
+    SentenceOptions tight;
+    tight.maxLength = 5;
+    tight.maxDepth = 1000;
+    SentenceGenerator loopGen(loop, tight);
+    for (int i = 0; i < 500 && weightsOk; ++i)
+        weightsOk = loopGen.generate(rng, scratch, sentence) && !sentence.empty() && sentence.size() <= 5;
+
+    bool threw = false;
+    try {
+        CFG empty;
+        empty.setStartSymbol("S");
+        empty.setProductions({production("S", {"S", "x"})});
+        SentenceGenerator never(empty);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    weightsOk &= threw;
+    std::cout << (weightsOk ? "[PASS]" : "[FAIL]") << " weights, recursive grammars and unproductive starts\n";
+
+    return boundsOk && languageOk && textOk && weightsOk;
+}
+
+bool HTTP10Tests::runCoverage() {
+    std::cout << "\n=== TEST: coverage-guided corpus ===\n";
+
+    CFG grammar("protocols/HTTP10/http10.json");
+    SLR slr(grammar);
+    CoverageOptions opt;
+    opt.sentences.maxLength = 40;
+    opt.sentences.lexemes = HTTP10Protocol::terminalLexemes();
+    opt.sentences.separator = "";
+    opt.sentences.seed = 11;
+    CoverageCorpus corpus = CoverageGenerator(grammar, slr, opt).run();
+    const CoverageReport& r = corpus.report;
+
+    std::cout << "productions " << r.productions.covered << "/" << r.productions.total
+              << ", states " << r.states.covered << "/" << r.states.total
+              << ", cells " << r.cells.covered << "/" << r.cells.total
+              << ", corpus " << corpus.sentences.size() << " of " << r.kept << " kept, "
+              << r.candidates << " candidates\n";
+    for (const auto& p : r.uncoveredProductions)
+        std::cout << "  uncovered: " << p << "\n";
+
+    // 1. Every production and state is reached (cells may include SLR
+    //    lookaheads no sentence can produce)
+    bool fullOk = r.productions.covered == r.productions.total &&
+                  r.states.covered == r.states.total && r.cells.ratio() > 0.9 &&
+                  corpus.texts.size() == corpus.sentences.size();
+    std::cout << (fullOk ? "[PASS]" : "[FAIL]") << " all productions and states covered\n";
+
+    // 2. Irredundant: each sentence covers something no other one does
+    std::vector<std::set<int>> itemSets;
+    std::vector<int> stack, cells, reductions, ids;
+    SentenceGenerator names(grammar);
+    for (const auto& sentence : corpus.sentences) {
+        ids.clear();
+        cells.clear();
+        reductions.clear();
+        for (int t : sentence) ids.push_back(slr.terminalId(names.terminals()[t]));
+        (void)slr.trace(ids, stack, cells, reductions);
+        std::set<int> items(cells.begin(), cells.end());
+        for (int p : reductions) items.insert(-1 - p);
+        itemSets.push_back(std::move(items));
+    }
+    bool minimalOk = !itemSets.empty();
+    for (size_t i = 0; i < itemSets.size() && minimalOk; ++i) {
+        std::set<int> others;
+        for (size_t j = 0; j < itemSets.size(); ++j)
+            if (j != i) others.insert(itemSets[j].begin(), itemSets[j].end());
+        bool unique = false;
+        for (int it : itemSets[i]) unique |= !others.count(it);
+        minimalOk = unique;
+    }
+    std::cout << (minimalOk ? "[PASS]" : "[FAIL]") << " every corpus sentence adds coverage\n";
+
+    // 3. The texts are real requests for the HTTP/1.0 parser
+    HTTP10Validator validator;
+    ValidatorScratch vs;
+    bool textOk = true;
+    for (const auto& text : corpus.texts)
+        textOk &= validator.validate(text, vs).syntaxOk;
+    std::cout << (textOk ? "[PASS]" : "[FAIL]") << " corpus texts pass the HTTP/1.0 parser\n";
+
+    return fullOk && minimalOk && textOk;
+}
+
+bool HTTP10Tests::runMutation() {
+    std::cout << "\n=== TEST: mutation engine ===\n";
+
+    HTTP10CorpusOptions copt;
+    copt.seed = 3;
+    copt.invalidRatio = 0.0;
+    HTTP10CorpusGenerator corpus(copt);
+    HTTP10Mutator mutator;
+    for (uint64_t i = 0; i < 200; ++i)
+        mutator.addSeed(corpus.message(i));
+
+    // 1. Regions follow the grammar: "GET /a.html HTTP/1.0\r\nHost: x\r\n\r\n"
+    MutatorOptions deleteOnly;
+    deleteOnly.weights = {1, 0, 0, 0, 0};
+    HTTP10Mutator deleter(deleteOnly);
+    deleter.addSeed("GET /a.html HTTP/1.0\r\nHost: x\r\n\r\n");
+    Xoshiro256 rng(1);
+    std::string out;
+    std::map<uint32_t, std::pair<MutationRegion, std::string>> seen;
+    for (int i = 0; i < 400; ++i) {
+        Mutation m = deleter.mutate(rng, out);
+        seen[m.token] = {m.region, out};
+    }
+    using R = MutationRegion;
+    const R expected[] = {R::Method, R::RequestLine, R::URI, R::URI, R::URI, R::URI, R::RequestLine,
+                          R::Version, R::RequestLine, R::HeaderName, R::Header, R::Header,
+                          R::HeaderValue, R::Header, R::Request};
+    bool regionOk = seen.size() == std::size(expected);
+    for (const auto& [token, entry] : seen)
+        regionOk &= token < std::size(expected) && entry.first == expected[token];
+    regionOk &= seen[0].second == " /a.html HTTP/1.0\r\nHost: x\r\n\r\n";
+    std::cout << (regionOk ? "[PASS]" : "[FAIL]") << " tokens map onto grammar regions\n";
+
+    // 2. Every kind fires, mutants are reproducible and mostly rejected
+    Xoshiro256 a(9), b(9);
+    std::string ma, mb;
+    MutationStats stats;
+    HTTP10Validator validator;
+    ValidatorScratch scratch;
+    size_t rejected = 0, same = 0;
+    const int runs = 20000;
+    for (int i = 0; i < runs; ++i) {
+        Mutation m = mutator.mutate(a, ma);
+        Mutation n = mutator.mutate(b, mb);
+        same += ma == mb && m.kind == n.kind && m.token == n.token;
+        stats.add(m);
+        rejected += !validator.validate(ma, scratch).ok();
+    }
+    bool kindsOk = stats.total == (uint64_t)runs && same == (size_t)runs;
+    for (size_t k = 0; k < (size_t)MutationKind::Count; ++k) {
+        std::cout << mutationKindName((MutationKind)k) << "=" << stats.byKind((MutationKind)k) << " ";
+        kindsOk &= stats.byKind((MutationKind)k) > runs / 10;
+    }
+    std::cout << "\nrejected=" << rejected << "/" << runs << "\n";
+    kindsOk &= rejected > runs / 2 && stats.byRegion(MutationRegion::HeaderValue) > 0;
+    std::cout << (kindsOk ? "[PASS]" : "[FAIL]") << " all mutation kinds fire, reproducibly, and break requests\n";
+
+    return regionOk && kindsOk;
+}
+
+bool HTTP10Tests::runPdaConversion() {
+    std::cout << "\n=== TEST: lazy PDA -> CFG ===\n";
+
+    auto productionSet = [](const CFG& g) {
+        std::vector<std::string> out;
+        for (const production& p : g.getProductions()) {
+            std::string line = p.lhs + " ->";
+            for (const std::string& sym : p.body) line += " " + sym;
+            out.push_back(line);
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    };
+
+    // 1. Identical to the eager construction followed by simplify()
+    PDA pda("protocols/HTTP10/http10_pda.json");
+    CFG eager = pda.toCFG();
+    const size_t eagerProductions = eager.getProductions().size();
+    eager.simplify();
+    PdaConversionStats stats;
+    CFG lazy = pda.toReducedCFG(&stats);
+
+    std::vector<std::string> eagerVars = eager.getVariables();
+    std::sort(eagerVars.begin(), eagerVars.end());
+    std::cout << "eager: " << eagerProductions << " productions, " << eager.getProductions().size()
+              << " after simplify; lazy: " << stats.productions << " productions, "
+              << stats.reachedTriples << "/" << stats.productiveTriples << " productive triples reached\n";
+    bool sameOk = productionSet(lazy) == productionSet(eager) && lazy.getVariables() == eagerVars &&
+                  lazy.getStartSymbol() == eager.getStartSymbol() && lazy.getTerminals() == eager.getTerminals() &&
+                  stats.productions == lazy.getProductions().size() && stats.productions > 0;
+    std::cout << (sameOk ? "[PASS]" : "[FAIL]") << " lazy conversion equals eager conversion + simplify\n";
+
+    // 2. Same language as the unsimplified grammar: sentences of the lazy
+    //    grammar (all must be accepted) and their one-token mutants
+    EarleyRecognizer full(pda.toCFG());
+    EarleyRecognizer reduced(lazy);
+    SentenceGenerator sentences(lazy);
+    SentenceScratch scratch;
+    EarleyScratch es;
+    Xoshiro256 rng(45);
+    const std::vector<std::string>& alphabet = lazy.getTerminals();
+    std::vector<int> sentence, a, b;
+    bool languageOk = true;
+    size_t accepted = 0;
+    for (int i = 0; i < 300; ++i) {
+        if (!sentences.generate(rng, scratch, sentence)) continue;
+        a.clear();
+        b.clear();
+        for (int t : sentence) {
+            a.push_back(full.terminalId(sentences.terminals()[t]));
+            b.push_back(reduced.terminalId(sentences.terminals()[t]));
+        }
+        if (i & 1) {
+            const size_t at = rng.below(a.size());
+            const std::string& t = alphabet[rng.below(alphabet.size())];
+            a[at] = full.terminalId(t);
+            b[at] = reduced.terminalId(t);
+        }
+        const bool ok = full.accepts(a, es);
+        languageOk &= reduced.accepts(b, es) == ok;
+        languageOk &= ok || (i & 1);
+        accepted += ok;
+    }
+    std::cout << "accepted " << accepted << "/300\n";
+    std::cout << (languageOk ? "[PASS]" : "[FAIL]") << " reduced grammar accepts the same sentences\n";
+
+    return sameOk && languageOk;
+}
+
+// Writes `spec` to a temporary file and loads it: PDA only reads files
+static PDA loadPda(const std::string& name, const std::string& spec) {
+    const std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path) << spec;
+    PDA pda(path);
+    std::filesystem::remove(path);
+    return pda;
+}
+
+bool HTTP10Tests::runPdaExecutor() {
+    std::cout << "\n=== TEST: PDA executor ===\n";
+
+    // 1. http10_pda.json agrees with Earley over its own grammar, on
+    //    sentences of that grammar and on one-token mutants of them
+    PDA pda("protocols/HTTP10/http10_pda.json");
+    PDAExecutor executor(pda);
+    CFG grammar = pda.toReducedCFG();
+    EarleyRecognizer earley(grammar);
+    SentenceGenerator sentences(grammar);
+    SentenceScratch sscratch;
+    EarleyScratch es;
+    PdaScratch ps;
+    Xoshiro256 rng(46);
+    const std::vector<std::string>& alphabet = grammar.getTerminals();
+    std::vector<int> sentence, a, b;
+    bool agreeOk = true;
+    size_t accepted = 0;
+    uint64_t fast = 0, sets = 0;
+    for (int i = 0; i < 400; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        a.clear();
+        b.clear();
+        for (int t : sentence) {
+            a.push_back(executor.terminalId(sentences.terminals()[t]));
+            b.push_back(earley.terminalId(sentences.terminals()[t]));
+        }
+        if (i & 1) {
+            const size_t at = rng.below(a.size());
+            const std::string& t = alphabet[rng.below(alphabet.size())];
+            a[at] = executor.terminalId(t);
+            b[at] = earley.terminalId(t);
+        }
+        const bool ok = executor.accepts(a, ps);
+        agreeOk &= ok == earley.accepts(b, es) && (ok || (i & 1)) && !ps.limitHit;
+        accepted += ok;
+        fast += ps.fastSteps;
+        sets += ps.setSteps;
+    }
+
+    // Request with headers from the test cases, via the tokenizer
+    HTTP10Validator validator;
+    ValidatorScratch vs;
+    Verdict v;
+    int err = -1;
+    (void)validator.tokenizeStage(loadFile("protocols/HTTP10/cases/valid_request_1.txt"),
+                                  vs.tokenizer, vs.tokens, vs.terminals, v);
+    a.clear();
+    for (int t : vs.terminals) a.push_back(executor.terminalId(validator.parser().terminalName(t)));
+    agreeOk &= executor.accepts(a, ps);
+    a.pop_back();                   // drop the closing blank line
+    agreeOk &= !executor.accepts(a, ps, &err) && err == (int)a.size();
+    std::cout << "accepted " << accepted << "/400, fast steps " << fast << ", set steps " << sets << "\n";
+    std::cout << (agreeOk ? "[PASS]" : "[FAIL]") << " http10 PDA agrees with Earley over its grammar\n";
+
+    // 2. Nondeterminism: even palindromes guess their middle with an epsilon move
+    PDA palindromes = loadPda("pv_palindromes.json", R"({
+        "States": ["push", "pop"], "Alphabet": ["a", "b"], "StackAlphabet": ["Z", "A", "B"],
+        "StartState": "push", "StartStack": "Z",
+        "Transitions": [
+            {"from": "push", "to": "push", "input": "a", "stacktop": "Z", "replacement": ["A", "Z"]},
+            {"from": "push", "to": "push", "input": "b", "stacktop": "Z", "replacement": ["B", "Z"]},
+            {"from": "push", "to": "push", "input": "a", "stacktop": "A", "replacement": ["A", "A"]},
+            {"from": "push", "to": "push", "input": "b", "stacktop": "A", "replacement": ["B", "A"]},
+            {"from": "push", "to": "push", "input": "a", "stacktop": "B", "replacement": ["A", "B"]},
+            {"from": "push", "to": "push", "input": "b", "stacktop": "B", "replacement": ["B", "B"]},
+            {"from": "push", "to": "pop", "input": "", "stacktop": "Z", "replacement": ["Z"]},
+            {"from": "push", "to": "pop", "input": "", "stacktop": "A", "replacement": ["A"]},
+            {"from": "push", "to": "pop", "input": "", "stacktop": "B", "replacement": ["B"]},
+            {"from": "pop", "to": "pop", "input": "a", "stacktop": "A", "replacement": []},
+            {"from": "pop", "to": "pop", "input": "b", "stacktop": "B", "replacement": []},
+            {"from": "pop", "to": "pop", "input": "", "stacktop": "Z", "replacement": []}
+        ]})");
+    PDAExecutor pal(palindromes);
+    auto word = [&](const std::string& w) {
+        std::vector<int> ids;
+        for (char c : w) ids.push_back(pal.terminalId(std::string(1, c)));
+        return ids;
+    };
+    bool nondetOk = pal.accepts(word(""), ps) && pal.accepts(word("abba"), ps) && ps.setSteps > 0 &&
+                    pal.accepts(word("babbbbab"), ps) && !pal.accepts(word("abab"), ps) &&
+                    !pal.accepts(word("aba"), ps) && !pal.accepts({0, 7}, ps);
+    std::string longWord(200, 'a');
+    nondetOk &= pal.accepts(word(longWord), ps) && !pal.accepts(word(longWord + "b"), ps);
+
+    // An epsilon move that pushes forever (language a*) is cut at
+    // maxStackDepth; the closure regrows after every pop, so it still accepts
+    PDA growing = loadPda("pv_growing.json", R"({
+        "States": ["q"], "Alphabet": ["a"], "StackAlphabet": ["Z"], "StartState": "q", "StartStack": "Z",
+        "Transitions": [
+            {"from": "q", "to": "q", "input": "", "stacktop": "Z", "replacement": ["Z", "Z"]},
+            {"from": "q", "to": "q", "input": "a", "stacktop": "Z", "replacement": []}
+        ]})");
+    PdaExecutorOptions small;
+    small.maxStackDepth = 64;
+    PDAExecutor grow(growing, small);
+    nondetOk &= grow.accepts({0, 0, 0}, ps) && grow.accepts(std::vector<int>(100, 0), ps) && ps.limitHit &&
+                !grow.accepts({0, 1}, ps);
+    std::cout << (nondetOk ? "[PASS]" : "[FAIL]") << " configuration sets handle nondeterminism and epsilon loops\n";
+
+    return agreeOk && nondetOk;
+}
+
+bool HTTP10Tests::runDpda() {
+    std::cout << "\n=== TEST: compiled DPDA ===\n";
+
+    // 1. http10_pda.json is deterministic; its table agrees with the
+    //    general executor on sentences and mutants
+    PDA pda("protocols/HTTP10/http10_pda.json");
+    const PdaDeterminismReport report = analyzeDeterminism(pda);
+    CompiledDPDA dpda(pda);
+    PDAExecutor executor(pda);
+    CFG grammar = pda.toReducedCFG();
+    SentenceGenerator sentences(grammar);
+    SentenceScratch sscratch;
+    PdaScratch ps;
+    DpdaScratch ds;
+    Xoshiro256 rng(47);
+    const std::vector<std::string>& alphabet = grammar.getTerminals();
+    std::vector<int> sentence, ids;
+    bool agreeOk = report.deterministic();
+    size_t accepted = 0;
+    for (int i = 0; i < 400; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        ids.clear();
+        for (int t : sentence) ids.push_back(dpda.terminalId(sentences.terminals()[t]));
+        if (i & 1) ids[rng.below(ids.size())] = dpda.terminalId(alphabet[rng.below(alphabet.size())]);
+
+        // Both number terminals in the order of the PDA's alphabet
+        int e1 = -1, e2 = -1;
+        const bool ok = dpda.accepts(ids, ds, &e1);
+        agreeOk &= ok == executor.accepts(ids, ps, &e2) && (ok || e1 == e2) && (ok || (i & 1));
+        accepted += ok;
+    }
+    HTTP10Validator validator;
+    ValidatorScratch vs;
+    Verdict v;
+    (void)validator.tokenizeStage(loadFile("protocols/HTTP10/cases/valid_request_1.txt"),
+                                  vs.tokenizer, vs.tokens, vs.terminals, v);
+    ids.clear();
+    for (int t : vs.terminals) ids.push_back(dpda.terminalId(validator.parser().terminalName(t)));
+    agreeOk &= dpda.accepts(ids, ds);
+    std::cout << "accepted " << accepted << "/400\n";
+    std::cout << (agreeOk ? "[PASS]" : "[FAIL]") << " http10 PDA compiles and agrees with the executor\n";
+
+    // 2. Nondeterministic specs are reported, transition by transition
+    PDA guess = loadPda("pv_guess.json", R"({
+        "States": ["p", "q"], "Alphabet": ["a", "b"], "StackAlphabet": ["Z", "A"],
+        "StartState": "p", "StartStack": "Z",
+        "Transitions": [
+            {"from": "p", "to": "p", "input": "a", "stacktop": "Z", "replacement": ["A", "Z"]},
+            {"from": "p", "to": "q", "input": "a", "stacktop": "Z", "replacement": []},
+            {"from": "p", "to": "q", "input": "", "stacktop": "A", "replacement": ["A"]},
+            {"from": "p", "to": "p", "input": "b", "stacktop": "A", "replacement": []},
+            {"from": "q", "to": "q", "input": "b", "stacktop": "A", "replacement": []}
+        ]})");
+    const PdaDeterminismReport bad = analyzeDeterminism(guess);
+    const std::string text = bad.format(guess);
+    std::cout << text;
+    bool reportOk = bad.conflicts.size() == 2 &&
+                    bad.conflicts[0].input.empty() && bad.conflicts[0].transitions == std::vector<size_t>{2, 3} &&
+                    bad.conflicts[1].input == "a" && bad.conflicts[1].transitions == std::vector<size_t>{0, 1} &&
+                    text.find("#2 p --eps, A / [A]--> q") != std::string::npos;
+    try {
+        CompiledDPDA rejected(guess);
+        reportOk = false;
+    } catch (const std::invalid_argument& ex) {
+        reportOk &= std::string(ex.what()).find("#3") != std::string::npos;
+    }
+    std::cout << (reportOk ? "[PASS]" : "[FAIL]") << " conflicting transitions are reported\n";
+
+    // 3. a^n b^n (n >= 1) against a fixed-capacity stack
+    PDA anbn = loadPda("pv_anbn.json", R"({
+        "States": ["q", "p"], "Alphabet": ["a", "b"], "StackAlphabet": ["Z", "A"],
+        "StartState": "q", "StartStack": "Z",
+        "Transitions": [
+            {"from": "q", "to": "q", "input": "a", "stacktop": "Z", "replacement": ["A", "Z"]},
+            {"from": "q", "to": "q", "input": "a", "stacktop": "A", "replacement": ["A", "A"]},
+            {"from": "q", "to": "p", "input": "b", "stacktop": "A", "replacement": []},
+            {"from": "p", "to": "p", "input": "b", "stacktop": "A", "replacement": []},
+            {"from": "p", "to": "p", "input": "", "stacktop": "Z", "replacement": []}
+        ]})");
+    DpdaOptions four;
+    four.stackCapacity = 4;
+    CompiledDPDA counter(anbn, four);
+    auto word = [&](const std::string& w) {
+        std::vector<int> out;
+        for (char c : w) out.push_back(counter.terminalId(std::string(1, c)));
+        return out;
+    };
+    int err = -1;
+    bool stackOk = counter.accepts(word("ab"), ds) && counter.accepts(word("aaabbb"), ds) &&
+                   !counter.accepts(word(""), ds) && !counter.accepts(word("aabbb"), ds, &err) && err == 4 &&
+                   !counter.accepts(word("aab"), ds, &err) && err == 3 && !ds.overflow &&
+                   !counter.accepts(word("aaaabbbb"), ds, &err) && ds.overflow && err == 3;
+    std::cout << (stackOk ? "[PASS]" : "[FAIL]") << " fixed-capacity stack rejects on overflow\n";
+
+    return agreeOk && reportOk && stackOk;
+}
+
+bool HTTP10Tests::runDfa() {
+    std::cout << "\n=== TEST: DFA compilation ===\n";
+
+    // 1. http10.json is regular: the DFA agrees with SLR, error index
+    //    included, on sentences and one-token mutants
+    CFG grammar("protocols/HTTP10/http10.json");
+    SLR slr(grammar);
+    DfaCompileStats stats;
+    TerminalDFA dfa = TerminalDFA::fromGrammar(grammar, {}, &stats);
+    SentenceGenerator sentences(grammar);
+    SentenceScratch sscratch;
+    Xoshiro256 rng(48);
+    std::vector<int> sentence, ids, stack;
+    bool agreeOk = findSelfEmbedding(grammar).empty() && dfa.terminalCount() == slr.eosId();
+    size_t accepted = 0;
+    for (int i = 0; i < 400; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        ids.clear();
+        for (int t : sentence) ids.push_back(slr.terminalId(sentences.terminals()[t]));
+        if (i & 1) ids[rng.below(ids.size())] = (int)rng.below(slr.eosId());
+        if (i % 4 == 3) ids.resize(rng.below(ids.size()));
+
+        int e1 = -1, e2 = -1;
+        const bool ok = dfa.accepts(ids, &e1);
+        agreeOk &= ok == slr.accepts(ids, stack, &e2) && (ok || e1 == e2) && (ok || (i & 1));
+        accepted += ok;
+    }
+
+    // As the validator's syntax engine
+    HTTP10Validator reference(grammar);
+    ValidatorOptions options;
+    options.engine = SyntaxEngine::Dfa;
+    HTTP10Validator validator(grammar, options);
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(reference, storage, corpus);
+    ValidatorScratch scratch;
+    std::vector<Verdict> got;
+    for (auto msg : corpus) got.push_back(validator.validate(msg, scratch));
+    agreeOk &= validator.syntaxDfa() != nullptr && sameVerdicts(got, expected);
+    std::cout << "NFA " << stats.nfaStates << ", subsets " << stats.subsetStates << ", minimized "
+              << stats.states << "; accepted " << accepted << "/400\n";
+    std::cout << (agreeOk ? "[PASS]" : "[FAIL]") << " http10 grammar compiles to a DFA that agrees with SLR\n";
+
+    // 2. The bounded-stack PDA gives the same minimal DFA as its grammar
+    PDA pda("protocols/HTTP10/http10_pda.json");
+    DfaCompileStats pdaStats;
+    TerminalDFA fromPda = TerminalDFA::fromPda(pda, {}, &pdaStats);
+    TerminalDFA fromCfg = TerminalDFA::fromGrammar(pda.toReducedCFG());
+    CompiledDPDA dpda(pda);
+    DpdaScratch ds;
+    bool pdaOk = fromPda.stateCount() == fromCfg.stateCount();
+    for (int i = 0; i < 400; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        ids.clear();
+        for (int t : sentence) ids.push_back(fromPda.terminalId(sentences.terminals()[t]));
+        if (i & 1) ids[rng.below(ids.size())] = (int)rng.below(fromPda.terminalCount());
+
+        // fromPda() and CompiledDPDA both number terminals as the PDA's alphabet
+        int e1 = -1, e2 = -1;
+        const bool ok = fromPda.accepts(ids, &e1);
+        pdaOk &= ok == dpda.accepts(ids, ds, &e2) && (ok || e1 == e2);
+    }
+    std::cout << "PDA configurations " << pdaStats.nfaStates << ", minimized " << pdaStats.states << "\n";
+    std::cout << (pdaOk ? "[PASS]" : "[FAIL]") << " http10 PDA compiles to the same DFA\n";
+
+    // 3. Self-embedding and unbounded stacks are refused; left recursion
+    //    and redundant variables are fine
+    json nested = json::parse(R"({
+        "Variables": ["S"], "Terminals": ["a", "b"], "Start": "S",
+        "Productions": [{"head": "S", "body": ["a", "S", "b"]}, {"head": "S", "body": []}]})");
+    CFG anbn(nested);
+    bool limitsOk = findSelfEmbedding(anbn) == "S";
+    try {
+        (void)TerminalDFA::fromGrammar(anbn);
+        limitsOk = false;
+    } catch (const std::invalid_argument& ex) {
+        limitsOk &= std::string(ex.what()).find("self-embedding at S") != std::string::npos;
+    }
+    PDA counter = loadPda("pv_counter.json", R"({
+        "States": ["q", "p"], "Alphabet": ["a", "b"], "StackAlphabet": ["Z", "A"],
+        "StartState": "q", "StartStack": "Z",
+        "Transitions": [
+            {"from": "q", "to": "q", "input": "a", "stacktop": "Z", "replacement": ["A", "Z"]},
+            {"from": "q", "to": "q", "input": "a", "stacktop": "A", "replacement": ["A", "A"]},
+            {"from": "q", "to": "p", "input": "b", "stacktop": "A", "replacement": []},
+            {"from": "p", "to": "p", "input": "b", "stacktop": "A", "replacement": []},
+            {"from": "p", "to": "p", "input": "", "stacktop": "Z", "replacement": []}
+        ]})");
+    try {
+        (void)TerminalDFA::fromPda(counter);
+        limitsOk = false;
+    } catch (const std::invalid_argument& ex) {
+        limitsOk &= std::string(ex.what()).find("grows past 64") != std::string::npos;
+    }
+
+    json leftSpec = json::parse(R"({
+        "Variables": ["L"], "Terminals": ["a", "b"], "Start": "L",
+        "Productions": [{"head": "L", "body": ["L", "a"]}, {"head": "L", "body": ["b"]}]})");
+    TerminalDFA left = TerminalDFA::fromGrammar(CFG(leftSpec));
+    int err = -1;
+    limitsOk &= left.accepts({1}) && left.accepts({1, 0, 0}) && !left.accepts({1, 0, 1}, &err) && err == 2 &&
+                !left.accepts({}, &err) && err == 0 && left.stateCount() == 2;
+
+    json twinSpec = json::parse(R"({
+        "Variables": ["S", "A", "B"], "Terminals": ["a"], "Start": "S",
+        "Productions": [{"head": "S", "body": ["A"]}, {"head": "S", "body": ["B"]},
+                        {"head": "A", "body": ["a", "A"]}, {"head": "A", "body": []},
+                        {"head": "B", "body": ["a", "B"]}, {"head": "B", "body": []}]})");
+    DfaCompileStats twinStats;
+    TerminalDFA twins = TerminalDFA::fromGrammar(CFG(twinSpec), {}, &twinStats);
+    limitsOk &= twins.stateCount() == 1 && twinStats.subsetStates > 1 && twins.accepts({}) && twins.accepts({0, 0});
+    std::cout << (limitsOk ? "[PASS]" : "[FAIL]") << " non-regular inputs are refused, the rest minimized\n";
+
+    return agreeOk && pdaOk && limitsOk;
+}
+
+bool HTTP10Tests::runPrefilter() {
+    std::cout << "\n=== TEST: regular prefilter ===\n";
+
+    // 1. A regular grammar is its own approximation
+    CFG grammar("protocols/HTTP10/http10.json");
+    const TerminalDFA exact = TerminalDFA::fromGrammar(grammar);
+    const TerminalDFA same = TerminalDFA::fromGrammar(regularApproximation(grammar));
+    bool exactOk = same.stateCount() == exact.stateCount() && same.terminalCount() == exact.terminalCount();
+    for (int s = 0; s < exact.stateCount(); ++s) {
+        exactOk &= same.accepting(s) == exact.accepting(s);
+        for (int a = 0; a < exact.terminalCount(); ++a) exactOk &= same.next(s, a) == exact.next(s, a);
+    }
+    std::cout << (exactOk ? "[PASS]" : "[FAIL]") << " regular grammar approximates to itself\n";
+
+    // 2. Expressions nest: the approximation keeps every sentence and only
+    //    rejects what Earley rejects too
+    json exprSpec = json::parse(R"js({
+        "Variables": ["E", "T"], "Terminals": ["+", "(", ")", "x"], "Start": "E",
+        "Productions": [{"head": "E", "body": ["E", "+", "T"]}, {"head": "E", "body": ["T"]},
+                        {"head": "T", "body": ["(", "E", ")"]}, {"head": "T", "body": ["x"]}]})js");
+    CFG expr(exprSpec);
+    const TerminalDFA approx = TerminalDFA::fromGrammar(regularApproximation(expr));
+    EarleyRecognizer earley(expr);
+    EarleyScratch es;
+    SentenceGenerator sentences(expr);
+    SentenceScratch sscratch;
+    Xoshiro256 rng(49);
+    std::vector<int> sentence, a, b;
+    bool soundOk = findSelfEmbedding(expr) == "E";
+    size_t invalid = 0, caught = 0;
+    for (int i = 0; i < 600; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        a.clear();
+        b.clear();
+        for (int t : sentence) {
+            a.push_back(approx.terminalId(sentences.terminals()[t]));
+            b.push_back(earley.terminalId(sentences.terminals()[t]));
+        }
+        if (i & 1) {
+            const size_t at = rng.below(a.size());
+            const std::string t = expr.getTerminals()[rng.below(4)];
+            a[at] = approx.terminalId(t);
+            b[at] = earley.terminalId(t);
+        }
+        const bool valid = earley.accepts(b, es);
+        const bool passed = approx.accepts(a);
+        soundOk &= passed || !valid;
+        invalid += !valid;
+        caught += !passed;
+    }
+    json anbnSpec = json::parse(R"({
+        "Variables": ["S"], "Terminals": ["a", "b"], "Start": "S",
+        "Productions": [{"head": "S", "body": ["a", "S", "b"]}, {"head": "S", "body": []}]})");
+    const TerminalDFA anbn = TerminalDFA::fromGrammar(regularApproximation(CFG(anbnSpec)));
+    int err = -1;
+    soundOk &= anbn.accepts({0, 0, 1, 1}) && anbn.accepts({}) && anbn.accepts({0, 0, 1}) &&
+               !anbn.accepts({1, 0}, &err) && err == 1;
+    std::cout << "prefilter caught " << caught << " of " << invalid << " invalid expressions\n";
+    soundOk &= caught > 0;
+
+    // Unbalanced brackets are what gets through
+    auto tokens = [&](const std::string& w, const auto& ids) {
+        std::vector<int> out;
+        for (char c : w) out.push_back(ids(std::string(1, c)));
+        return out;
+    };
+    soundOk &= approx.accepts(tokens("((x)", [&](const std::string& t) { return approx.terminalId(t); })) &&
+               !earley.accepts(tokens("((x)", [&](const std::string& t) { return earley.terminalId(t); }), es);
+    std::cout << (soundOk ? "[PASS]" : "[FAIL]") << " approximation is a superset and still rejects\n";
+
+    // 3. In the validator: same verdicts, every syntax error caught up front
+    HTTP10Validator reference(grammar);
+    ValidatorOptions options;
+    options.prefilter = true;
+    HTTP10Validator validator(grammar, options);
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(reference, storage, corpus);
+
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    Metrics::setEnabled(true);
+    ValidatorScratch scratch;
+    std::vector<Verdict> got;
+    for (auto msg : corpus) got.push_back(validator.validate(msg, scratch));
+    Metrics::setEnabled(false);
+    const MetricsSnapshot m = Metrics::snapshot();
+    Metrics::reset();
+
+    uint64_t syntax = 0, parsed = 0;
+    for (const Verdict& v : expected) {
+        syntax += v.code == VerdictCode::SyntaxError;
+        parsed += v.code != VerdictCode::EmptyInput;
+    }
+    const bool validatorOk = validator.prefilterDfa() != nullptr && sameVerdicts(got, expected) &&
+                             m.counter(Counter::PrefilterRejects) == syntax &&
+                             m.counter(Counter::PrefilterRejects) + m.counter(Counter::PrefilterPasses) == parsed;
+    std::cout << "prefilter rejects " << m.counter(Counter::PrefilterRejects) << ", passes "
+              << m.counter(Counter::PrefilterPasses) << "\n";
+    std::cout << (validatorOk ? "[PASS]" : "[FAIL]") << " prefilter keeps verdicts and counts its hits\n";
+
+    return exactOk && soundOk && validatorOk;
+}
+
+bool HTTP10Tests::runInterleave() {
+    std::cout << "\n=== TEST: interleaved table walks ===\n";
+
+    // 1. acceptsMany() matches accepts() input by input, for batches below,
+    //    at and well above the lane count
+    CFG grammar("protocols/HTTP10/http10.json");
+    SLR slr(grammar);
+    TerminalDFA dfa = TerminalDFA::fromGrammar(grammar);
+    SentenceGenerator sentences(grammar);
+    SentenceScratch sscratch;
+    Xoshiro256 rng(50);
+    std::vector<int> sentence, stack;
+    std::vector<std::vector<int>> inputs;
+    for (int i = 0; i < 300; ++i) {
+        if (!sentences.generate(rng, sscratch, sentence)) continue;
+        auto& ids = inputs.emplace_back();
+        for (int t : sentence) ids.push_back(slr.terminalId(sentences.terminals()[t]));
+        if (i % 3 == 1) ids[rng.below(ids.size())] = (int)rng.below(slr.eosId() + 1) - 1;
+        if (i % 3 == 2) ids.resize(rng.below(ids.size()));
+    }
+    std::vector<const std::vector<int>*> pointers;
+    for (const auto& ids : inputs) pointers.push_back(&ids);
+
+    std::vector<std::vector<int>> stacks;
+    std::vector<uint8_t> slrOk(inputs.size()), dfaOk(inputs.size());
+    std::vector<int> slrErr(inputs.size()), dfaErr(inputs.size());
+    bool manyOk = true;
+    size_t accepted = 0;
+    for (size_t count : {size_t(0), size_t(1), size_t(5), SLR::LANES, TerminalDFA::LANES + 3, inputs.size()}) {
+        std::fill(slrOk.begin(), slrOk.end(), 2);
+        std::fill(dfaOk.begin(), dfaOk.end(), 2);
+        slr.acceptsMany(pointers.data(), count, stacks, slrOk.data(), slrErr.data());
+        dfa.acceptsMany(pointers.data(), count, dfaOk.data(), dfaErr.data());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (i >= count) {
+                manyOk &= slrOk[i] == 2 && dfaOk[i] == 2;
+                continue;
+            }
+            int err = -1;
+            const bool ok = slr.accepts(inputs[i], stack, &err);
+            manyOk &= slrOk[i] == ok && dfaOk[i] == ok && slrErr[i] == (ok ? -1 : err) && dfaErr[i] == slrErr[i];
+            if (count == inputs.size()) accepted += ok;
+        }
+    }
+    std::cout << "inputs " << inputs.size() << ", accepted " << accepted << "\n";
+    std::cout << (manyOk ? "[PASS]" : "[FAIL]") << " acceptsMany agrees with accepts\n";
+
+    // 2. validateMany() and interleaved batches give validate()'s verdicts
+    //    for every engine
+    HTTP10Validator reference(grammar);
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(reference, storage, corpus);
+    ValidatorScratch referenceScratch;
+    corpus.emplace_back("");
+    expected.push_back(reference.validate("", referenceScratch));
+
+    bool verdictsOk = true;
+    ValidatorOptions dfaOptions, prefilterOptions;
+    dfaOptions.engine = SyntaxEngine::Dfa;
+    prefilterOptions.prefilter = true;
+    for (const ValidatorOptions& options : {ValidatorOptions(), dfaOptions, prefilterOptions}) {
+        HTTP10Validator validator(grammar, options);
+        ValidatorScratch scratch;
+        std::vector<Verdict> got(corpus.size());
+
+        // Same samples as one validate() per message: Parse is per message
+        Metrics::setEnabled(false);
+        Metrics::reset();
+        Metrics::setEnabled(true);
+        for (auto msg : corpus) (void)validator.validate(msg, scratch);
+        const MetricsSnapshot single = Metrics::snapshot();
+        Metrics::setEnabled(false);
+        Metrics::reset();
+        Metrics::setEnabled(true);
+        validator.validateMany(corpus.data(), corpus.size(), scratch, got.data());
+        Metrics::setEnabled(false);
+        const MetricsSnapshot many = Metrics::snapshot();
+        Metrics::reset();
+
+        verdictsOk &= sameVerdicts(got, expected) &&
+                      single.stage(Stage::Parse).count > 0 &&
+                      many.stage(Stage::Parse).count == single.stage(Stage::Parse).count &&
+                      many.counter(Counter::Messages) == single.counter(Counter::Messages);
+
+        BatchOptions batchOptions{4, 100};
+        batchOptions.interleave = true;
+        BatchReport report = BatchValidator(validator, batchOptions).run(corpus);
+        verdictsOk &= sameVerdicts(report.verdicts, expected) && report.total.messages == corpus.size();
+    }
+    std::cout << (verdictsOk ? "[PASS]" : "[FAIL]") << " validateMany matches validate for every engine\n";
+
+    return manyOk && verdictsOk;
+}
+
+bool HTTP10Tests::runFuzz() {
+    std::cout << "\n=== TEST: fuzz targets ===\n";
+
+    // 1. The shipped dictionary is what fuzzDictionary() generates
+    bool dictOk = loadFile("fuzz/http10.dict") == fuzzDictionary();
+    std::cout << (dictOk ? "[PASS]" : "[FAIL]") << " fuzz/http10.dict matches the grammar terminals\n";
+
+    // 2. Malformed sequences end in a clean rejection, never a crash or throw
+    CFG grammar("protocols/HTTP10/http10.json");
+    SLR slr(grammar);
+    bool robustOk = true;
+    const std::vector<std::vector<std::string>> bad = {
+        {}, {"CRLF"}, {"<UNKNOWN>"}, {"METHOD_GET", "SP", "SP", "SP"},
+        {"CRLF", "CRLF", "CRLF", "CRLF", "CRLF", "CRLF", "CRLF", "CRLF"},
+    };
+    for (const auto& seq : bad) {
+        robustOk &= !slr.parse(seq);
+        robustOk &= slr.lastErrorIndex >= 0 && slr.lastErrorIndex <= (int)seq.size();
+    }
+
+    HTTPRequest req;
+    std::string error;
+    HTTP10Tokenizer tokenizer;
+    robustOk &= !HTTPRequest::tryFromTokens({}, req, error) && error == "Missing HTTP method";
+    std::vector<Token> truncated = tokenizer.tokenize("GET /a HTTP/1.0\r\nHost:");
+    truncated.pop_back();           // no END_OF_INPUT either
+    robustOk &= !HTTPRequest::tryFromTokens(truncated, req, error) && error == "Expected CRLF after header value";
+    robustOk &= HTTPRequest::tryFromTokens(tokenizer.tokenize("GET /a HTTP/1.0\r\nHost: x\r\n\r\n"), req, error) &&
+                req.headers.size() == 1 && req.headers[0].value == "x";
+    try {
+        (void)HTTPRequest::fromTokens({});
+        robustOk = false;
+    } catch (const std::runtime_error&) {}
+    std::cout << (robustOk ? "[PASS]" : "[FAIL]") << " SLR::parse and HTTPRequest reject malformed input cleanly\n";
+
+    // 3. Earley on an ambiguous CNF grammar, then against the SLR tables
+    CFG cnf("bench/cyk_cnf.json");
+    EarleyRecognizer small(cnf);
+    EarleyScratch es;
+    const int ta = small.terminalId("a"), tb = small.terminalId("b");
+    bool earleyOk = small.accepts({ta, tb}, es) && small.accepts({tb, ta}, es) &&
+                    !small.accepts({ta}, es) && !small.accepts({}, es) && !small.accepts({ta, 7}, es);
+
+    const LogLevel before = Log::level();
+    fuzzInitialize();
+    std::string report;
+    for (const char* file : cases) {
+        const std::string input = "\x02" + loadFile(file);     // even first byte: tokenize
+        earleyOk &= fuzzCrossCheck(reinterpret_cast<const uint8_t*>(input.data()), input.size(), &report);
+    }
+
+    Xoshiro256 rng(44);
+    std::string input;
+    for (int i = 0; i < 3000 && earleyOk; ++i) {
+        input.assign(1, (char)(i & 1));
+        const size_t len = rng.below(40);
+        for (size_t k = 0; k < len; ++k) input += (char)rng.below(256);
+        const auto* data = reinterpret_cast<const uint8_t*>(input.data());
+        earleyOk &= fuzzCrossCheck(data, input.size(), &report);
+        fuzzPipeline(data + 1, input.size() - 1);
+        fuzzParser(data + 1, input.size() - 1);
+    }
+
+    // Grammar sentences as terminal-mode inputs: both must accept them
+    SentenceGenerator sentences(grammar);
+    SentenceScratch scratch;
+    std::vector<int> sentence, ids, stack;
+    for (int i = 0; i < 200 && earleyOk; ++i) {
+        if (!sentences.generate(rng, scratch, sentence)) continue;
+        ids.clear();
+        input.assign(1, '\x01');
+        for (int t : sentence) {
+            ids.push_back(slr.terminalId(sentences.terminals()[t]));
+            input += (char)ids.back();
+        }
+        earleyOk &= slr.accepts(ids, stack);
+        earleyOk &= fuzzCrossCheck(reinterpret_cast<const uint8_t*>(input.data()), input.size(), &report);
+    }
+    Log::setLevel(before);
+    if (!report.empty()) std::cout << report << "\n";
+    std::cout << (earleyOk ? "[PASS]" : "[FAIL]") << " Earley and SLR agree on acceptance\n";
+
+    return dictOk && robustOk && earleyOk;
+}
+
+bool HTTP10Tests::runPipeline() {
+    std::cout << "\n=== TEST: staged pipeline ===\n";
+
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+
+    // Tiny rings so backpressure actually kicks in
+    StagedPipeline pipeline(validator, {8, 2});
+    PipelineReport report = pipeline.run(corpus);
+
+    for (const auto& st : report.stages) {
+        std::cout << st.name << ": batches=" << st.batches
+                  << " starved=" << st.starved << " blocked=" << st.blocked << "\n";
+    }
+    for (const auto& q : report.queues) {
+        std::cout << q.name << ": mean depth=" << q.meanDepth()
+                  << " max=" << q.maxDepth << "/" << q.capacity << "\n";
+    }
+
+    bool ok = report.total.messages == corpus.size() &&
+              sameVerdicts(report.verdicts, expected);
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " pipeline verdicts match sequential run\n";
+    return ok;
+}
+
+bool HTTP10Tests::runServer() {
+#ifdef HAVE_VALIDATION_SERVER
+    std::cout << "\n=== TEST: validation daemon ===\n";
+
+    HTTP10Validator validator;
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+
+    // Wire verdicts carry both stage flags for every code; anything else is refused
+    bool ok = true;
+    for (int c = 0; c < (int)VerdictCode::Count; ++c) {
+        for (int flags = 0; flags < 4; ++flags) {
+            Verdict v, back;
+            v.code = (VerdictCode)c;
+            v.syntaxOk = flags & 1;
+            v.semanticsOk = flags & 2;
+            v.errorOffset = c * 7 - 1;
+            std::string bytes;
+            wire::appendVerdict(bytes, v);
+            ok &= bytes.size() == wire::VERDICT_SIZE && wire::readVerdict(bytes.data(), back) &&
+                  back.code == v.code && back.syntaxOk == v.syntaxOk &&
+                  back.semanticsOk == v.semanticsOk && back.errorOffset == v.errorOffset;
+        }
+    }
+    Verdict unused;
+    const char badCode[] = {0, (char)VerdictCode::Count, 0, 0, 0, 0, 0, 0};
+    const char badFlags[] = {1, (char)VerdictCode::Ok, 4, 0, 0, 0, 0, 0};
+    ok &= !wire::readVerdict(badCode, unused) && !wire::readVerdict(badFlags, unused);
+
+    try {
+        // Loopback TCP, pipelined: one write with every request
+        ServerOptions tcpOptions;
+        tcpOptions.workers = 2;
+        ValidationServer tcpServer(validator, tcpOptions);
+        tcpServer.start();
+
+        ValidationClient client;
+        client.connectTcp("127.0.0.1", tcpServer.boundPort());
+        auto got = client.validatePipelined(corpus);
+        ok &= sameVerdicts(got, expected);
+        for (size_t i = 0; i < got.size() && i < expected.size(); ++i)
+            ok &= got[i].syntaxOk == expected[i].syntaxOk && got[i].semanticsOk == expected[i].semanticsOk;
+
+        // Unix socket, one request per round trip
+        ServerOptions unixOptions;
+        unixOptions.unixPath = "http10_validation_test.sock";
+        ValidationServer unixServer(validator, unixOptions);
+        unixServer.start();
+
+        ValidationClient unixClient;
+        unixClient.connectUnix(unixOptions.unixPath);
+
+        const int rounds = 2000;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; ++i) {
+            Verdict v = unixClient.validate(corpus[i % corpus.size()]);
+            ok &= v.code == expected[i % corpus.size()].code;
+        }
+        double us = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - t0).count() / rounds;
+
+        unixClient.close();
+        client.close();
+        tcpServer.stop();
+        unixServer.stop();
+
+        ok &= tcpServer.stats().messages == corpus.size();
+        std::cout << "unix round trip: " << us << " us/message\n";
+    } catch (const std::exception& ex) {
+        std::cout << "[ERROR] " << ex.what() << "\n";
+        ok = false;
+    }
+
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " daemon verdicts match sequential run\n";
+    return ok;
+#else
+    return true;
+#endif
+}
+
+#ifdef HAVE_VALIDATION_SERVER
+// Minimal HTTP/1.0 backend: reads a header block plus whatever follows it
+// shortly after, answers 200, closes
+struct StandInUpstream {
+    int fd = -1;
+    uint16_t port = 0;
+    std::atomic<int> requests{0};
+    std::atomic<bool> running{true};
+    std::thread thread;
+    std::mutex seenMutex;
+    std::vector<std::string> seen;      // bytes received, per connection
+
+    StandInUpstream() {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd, (sockaddr*)&addr, sizeof(addr));
+        listen(fd, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(fd, (sockaddr*)&addr, &len);
+        port = ntohs(addr.sin_port);
+
+        thread = std::thread([this] {
+            while (running) {
+                pollfd pfd{fd, POLLIN, 0};
+                if (poll(&pfd, 1, 50) <= 0) continue;
+                int c = accept(fd, nullptr, nullptr);
+                if (c < 0) continue;
+
+                std::string req;
+                char buf[1024];
+                while (req.find("\r\n\r\n") == std::string::npos && req.find("\n\n") == std::string::npos) {
+                    ssize_t r = recv(c, buf, sizeof(buf), 0);
+                    if (r <= 0) break;
+                    req.append(buf, (size_t)r);
+                }
+                pollfd more{c, POLLIN, 0};
+                while (poll(&more, 1, 50) > 0) {
+                    ssize_t r = recv(c, buf, sizeof(buf), 0);
+                    if (r <= 0) break;
+                    req.append(buf, (size_t)r);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(seenMutex);
+                    seen.push_back(req);
+                }
+                requests++;
+                const char resp[] = "HTTP/1.0 200 OK\r\nContent-Length: 5\r\n\r\nhello";
+                send(c, resp, sizeof(resp) - 1, MSG_NOSIGNAL);
+                close(c);
+            }
+        });
+    }
+
+    ~StandInUpstream() {
+        running = false;
+        thread.join();
+        close(fd);
+    }
+};
+
+// Loopback connection to `port`, -1 on failure
+static int connectLoopback(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Send `request`, return everything the proxy answers
+static std::string proxyExchange(uint16_t port, const std::string& request) {
+    int fd = connectLoopback(port);
+    if (fd < 0) return "";
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+    std::string resp;
+    char buf[1024];
+    ssize_t r;
+    while ((r = recv(fd, buf, sizeof(buf), 0)) > 0)
+        resp.append(buf, (size_t)r);
+    close(fd);
+    return resp;
+}
+#endif
+
+bool HTTP10Tests::runProxy() {
+#ifdef HAVE_VALIDATION_SERVER
+    std::cout << "\n=== TEST: validating proxy ===\n";
+
+    HTTP10Validator validator;
+    StandInUpstream upstream;
+
+    // Early rejection fed one byte at a time: valid requests pass, syntax
+    // errors on a complete line are caught at validate()'s offset, and
+    // nothing reaches the metrics
+    std::vector<std::string> storage;
+    std::vector<std::string_view> corpus;
+    auto expected = buildCorpus(validator, storage, corpus);
+    bool prefixOk = true;
+    size_t early = 0;
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    Metrics::setEnabled(true);
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        PrefixCheck state;
+        HTTP10Tokenizer tokenizer;
+        Verdict v;
+        bool rejected = false;
+        for (size_t n = 1; n <= corpus[i].size() && !rejected; ++n)
+            rejected = !validator.checkPrefix(corpus[i].substr(0, n), state, tokenizer, v);
+
+        const Verdict& e = expected[i];
+        const size_t lastLine = corpus[i].rfind('\n') + 1;
+        if (e.code == VerdictCode::SyntaxError && e.errorOffset >= 0 && (size_t)e.errorOffset < lastLine) {
+            prefixOk &= rejected && v.errorOffset == e.errorOffset;
+            early++;
+        } else if (e.syntaxOk) {
+            prefixOk &= !rejected;
+        }
+    }
+    Metrics::setEnabled(false);
+    const MetricsSnapshot quiet = Metrics::snapshot();
+    Metrics::reset();
+    prefixOk &= quiet.counter(Counter::Tokens) == 0 && quiet.stage(Stage::Tokenize).count == 0;
+    std::cout << "rejected early: " << early << " of " << corpus.size() << "\n";
+    std::cout << (prefixOk ? "[PASS]" : "[FAIL]") << " line-by-line check agrees with validate\n";
+
+    ProxyOptions options;
+    options.upstreamPort = upstream.port;
+    ValidatingProxy proxy(validator, options);
+
+    bool ok = true;
+    try {
+        proxy.start();
+
+        std::string valid = proxyExchange(proxy.boundPort(),
+            "GET /index.html HTTP/1.0\r\nHost: example.com\r\n\r\n");
+        ok &= valid.rfind("HTTP/1.0 200", 0) == 0;
+
+        // Complete but invalid
+        std::string invalid = proxyExchange(proxy.boundPort(),
+            "GET /index.html HTTP/1.0\r\nHost example.com\r\n\r\n");
+        ok &= invalid.rfind("HTTP/1.0 400", 0) == 0;
+
+        // Broken request line, header block never finished: rejected on the first line
+        std::string early = proxyExchange(proxy.boundPort(), "GEX /index.html HTTP/1.0\r\n");
+        ok &= early.rfind("HTTP/1.0 400", 0) == 0;
+
+        // A second, invalid request pipelined behind a valid one with a body:
+        // only the first request, body included, may reach upstream
+        const std::string first = "POST /form HTTP/1.0\r\nContent-Length: 4\r\n\r\nabcd";
+        std::string smuggled = proxyExchange(proxy.boundPort(),
+            first + "GET /admin HTTP/1.0\r\nHost example.com\r\n\r\n");
+        ok &= smuggled.rfind("HTTP/1.0 200", 0) == 0;
+        {
+            std::lock_guard<std::mutex> lock(upstream.seenMutex);
+            ok &= upstream.seen.size() == 2 && upstream.seen.back() == first;
+        }
+
+        // Connection cap: while one client holds the only slot, the next is refused
+        ProxyOptions capped = options;
+        capped.maxConnections = 1;
+        ValidatingProxy cappedProxy(validator, capped);
+        cappedProxy.start();
+
+        int held = connectLoopback(cappedProxy.boundPort());
+        ok &= held >= 0;
+        const char partial[] = "GET /index.html HTTP/1.0\r\n";
+        send(held, partial, sizeof(partial) - 1, MSG_NOSIGNAL);
+        while (cappedProxy.stats().connections == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::string refused = proxyExchange(cappedProxy.boundPort(),
+            "GET /index.html HTTP/1.0\r\nHost: example.com\r\n\r\n");
+        ok &= refused.rfind("HTTP/1.0 503", 0) == 0 && cappedProxy.stats().refused == 1;
+        close(held);
+        cappedProxy.stop();
+
+        // An upstream that accepts (in the kernel) but never answers: the
+        // relay waits on it alone, and stop() must still return
+        int silent = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in silentAddr{};
+        silentAddr.sin_family = AF_INET;
+        silentAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(silent, (sockaddr*)&silentAddr, sizeof(silentAddr));
+        listen(silent, 4);
+        socklen_t silentLen = sizeof(silentAddr);
+        getsockname(silent, (sockaddr*)&silentAddr, &silentLen);
+
+        ProxyOptions stalled = options;
+        stalled.upstreamPort = ntohs(silentAddr.sin_port);
+        ValidatingProxy stalledProxy(validator, stalled);
+        stalledProxy.start();
+        int waiting = connectLoopback(stalledProxy.boundPort());
+        const char get[] = "GET /index.html HTTP/1.0\r\nHost: example.com\r\n\r\n";
+        send(waiting, get, sizeof(get) - 1, MSG_NOSIGNAL);
+        for (int i = 0; i < 2000 && stalledProxy.stats().forwarded == 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        auto t0 = std::chrono::steady_clock::now();
+        stalledProxy.stop();
+        double stopMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        ok &= stalledProxy.stats().forwarded == 1 && stopMs < 1000.0;
+        close(waiting);
+
+        // Timeouts free the slot: a header block that never completes gets
+        // 408, an upstream that never answers 504
+        ProxyOptions timed = stalled;
+        timed.headerTimeoutMs = 100;
+        timed.idleTimeoutMs = 100;
+        ValidatingProxy timedProxy(validator, timed);
+        timedProxy.start();
+        std::string slowHeaders = proxyExchange(timedProxy.boundPort(), "GET /index.html HTTP/1.0\r\n");
+        std::string slowUpstream = proxyExchange(timedProxy.boundPort(), get);
+        timedProxy.stop();
+        ProxyStats ts = timedProxy.stats();
+        ok &= slowHeaders.rfind("HTTP/1.0 408", 0) == 0 && slowUpstream.rfind("HTTP/1.0 504", 0) == 0 &&
+              ts.headerTimeouts == 1 && ts.idleTimeouts == 1;
+        close(silent);
+
+        proxy.stop();
+    } catch (const std::exception& ex) {
+        std::cout << "[ERROR] " << ex.what() << "\n";
+        ok = false;
+    }
+
+    ProxyStats st = proxy.stats();
+    ok &= upstream.requests == 2 && st.forwarded == 2 && st.rejected == 2 && st.rejectedEarly == 1 &&
+          st.trailingDropped == 1;
+
+    std::cout << "forwarded=" << st.forwarded << " rejected=" << st.rejected
+              << " trailing dropped=" << st.trailingDropped
+              << " upstream saw=" << upstream.requests
+              << " validate=" << st.meanValidateMicros() << "us"
+              << " forward=" << st.meanForwardMicros() << "us\n";
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " only valid requests reach the upstream\n";
+    return ok && prefixOk;
+#else
+    return true;
+#endif
+}
+
+// ----------------------------------------------------------
+// Synthetic captures: Ethernet + IPv4/IPv6 + TCP, written as pcap or pcapng
+// ----------------------------------------------------------
+struct TestPacket {
+    bool ipv6;
+    uint16_t srcPort;
+    uint32_t seq;
+    uint8_t flags;
+    std::string payload;
+};
+
+static std::string buildFrame(const TestPacket& p) {
+    auto be16 = [](std::string& o, uint16_t v) { o.push_back((char)(v >> 8)); o.push_back((char)v); };
+    auto be32 = [&](std::string& o, uint32_t v) { be16(o, (uint16_t)(v >> 16)); be16(o, (uint16_t)v); };
+
+    std::string tcp;
+    be16(tcp, p.srcPort);
+    be16(tcp, 80);
+    be32(tcp, p.seq);
+    be32(tcp, 0);
+    tcp.push_back((char)0x50);          // data offset 5 words
+    tcp.push_back((char)p.flags);
+    be16(tcp, 65535);
+    be32(tcp, 0);                       // checksum + urgent pointer (unchecked)
+    tcp += p.payload;
+
+    std::string frame(12, '\0');       // MAC addresses
+    if (!p.ipv6) {
+        be16(frame, 0x0800);
+        frame.push_back((char)0x45);
+        frame.push_back(0);
+        be16(frame, (uint16_t)(20 + tcp.size()));
+        be32(frame, 0);                 // id, flags, fragment offset
+        frame.push_back(64);
+        frame.push_back(6);
+        be16(frame, 0);
+        be32(frame, 0x0a000001);        // 10.0.0.1
+        be32(frame, 0x0a000002);        // 10.0.0.2
+    } else {
+        be16(frame, 0x86dd);
+        be32(frame, 0x60000000);
+        be16(frame, (uint16_t)tcp.size());
+        frame.push_back(6);
+        frame.push_back(64);
+        frame += std::string(15, '\0') + "\x01";   // ::1
+        frame += std::string(15, '\0') + "\x02";   // ::2
+    }
+    return frame + tcp;
+}
+
+static void writeCapture(const std::string& path, const std::vector<TestPacket>& packets, bool ng) {
+    auto le16 = [](std::string& o, uint16_t v) { o.push_back((char)v); o.push_back((char)(v >> 8)); };
+    auto le32 = [&](std::string& o, uint32_t v) { le16(o, (uint16_t)v); le16(o, (uint16_t)(v >> 16)); };
+
+    std::string out;
+    if (!ng) {
+        le32(out, 0xa1b2c3d4); le16(out, 2); le16(out, 4);
+        le32(out, 0); le32(out, 0); le32(out, 65535); le32(out, 1);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            std::string f = buildFrame(packets[i]);
+            le32(out, (uint32_t)i); le32(out, 0);
+            le32(out, (uint32_t)f.size()); le32(out, (uint32_t)f.size());
+            out += f;
+        }
+    } else {
+        // SHB, IDB (Ethernet), one EPB per packet
+        le32(out, 0x0A0D0D0A); le32(out, 28); le32(out, 0x1A2B3C4D);
+        le16(out, 1); le16(out, 0); le32(out, 0xffffffff); le32(out, 0xffffffff); le32(out, 28);
+        le32(out, 1); le32(out, 20); le16(out, 1); le16(out, 0); le32(out, 65535); le32(out, 20);
+        for (size_t i = 0; i < packets.size(); ++i) {
+            std::string f = buildFrame(packets[i]);
+            size_t padded = (f.size() + 3) & ~(size_t)3;
+            uint32_t len = (uint32_t)(32 + padded);
+            le32(out, 6); le32(out, len);
+            le32(out, 0); le32(out, 0); le32(out, (uint32_t)i * 1000000u);
+            le32(out, (uint32_t)f.size()); le32(out, (uint32_t)f.size());
+            out += f + std::string(padded - f.size(), '\0');
+            le32(out, len);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file << out;
+}
+
+bool HTTP10Tests::runCapture() {
+    std::cout << "\n=== TEST: pcap ingestion ===\n";
+
+    const std::string r1 = "GET /index.html HTTP/1.0\r\nHost: example.com\r\n\r\n";
+    const std::string r2 = "HEAD /a/b.txt HTTP/1.0\r\n\r\n";
+    const std::string bad = "GET /index.html HTTP/1.0\r\nHost example.com\r\n\r\n";
+    const std::string post = "POST /form HTTP/1.0\r\nContent-Length: 6\r\n\r\na\n\nb\n\n";
+    const size_t postSplit = post.find("a\n") + 2;     // body arrives in two segments
+
+    // Flow A (IPv4): request split over two segments, a retransmission, a POST
+    // whose body (split over two segments) holds blank lines, then a last request
+    // Flow B (IPv6): invalid request whose halves arrive out of order
+    std::vector<TestPacket> packets = {
+        {false, 40000, 999, 0x02, ""},
+        {true,  40001, 4999, 0x02, ""},
+        {false, 40000, 1000, 0x18, r1.substr(0, 10)},
+        {true,  40001, 5000 + 12, 0x18, bad.substr(12)},
+        {false, 40000, 1010, 0x18, r1.substr(10)},
+        {false, 40000, 1010, 0x18, r1.substr(10)},
+        {true,  40001, 5000, 0x18, bad.substr(0, 12)},
+        {false, 40000, (uint32_t)(1000 + r1.size()), 0x18, post.substr(0, postSplit)},
+        {false, 40000, (uint32_t)(1000 + r1.size() + postSplit), 0x18, post.substr(postSplit)},
+        {false, 40000, (uint32_t)(1000 + r1.size() + post.size()), 0x19, r2},
+    };
+
+    HTTP10Validator validator;
+    CaptureOptions options;
+    options.batch.workers = 2;
+    CaptureValidator runner(validator, options);
+
+    bool ok = true;
+    for (bool ng : {false, true}) {
+        std::string path = ng ? "http10_capture_test.pcapng" : "http10_capture_test.pcap";
+        writeCapture(path, packets, ng);
+
+        CaptureReport r = runner.run(path);
+        std::remove(path.c_str());
+
+        bool pass = r.packets == packets.size() &&
+                    r.validation.messages == 4 &&
+                    r.validation.accepted == 3 &&
+                    r.reassembly.retransmittedBytes == r1.size() - 10 &&
+                    r.reassembly.bodyBytes == 6 &&
+                    r.flows.size() == 2 &&
+                    r.flows[0].accepted == 3 &&
+                    r.flows[1].requests == 1 && r.flows[1].firstError == VerdictCode::SyntaxError;
+
+        std::cout << (ng ? "pcapng" : "pcap") << ": packets=" << r.packets
+                  << " requests=" << r.validation.messages
+                  << " accepted=" << r.validation.accepted << "\n";
+        ok &= pass;
+    }
+
+    std::cout << (ok ? "[PASS]" : "[FAIL]") << " requests reassembled and validated per flow\n";
+    return ok;
+}
+
+bool HTTP10Tests::runAll() {
     for (auto f : cases) {
         runSingle(f);
     }
+
+    bool ok = true;
+    ok &= runFraming();
+    ok &= runBody();
+    ok &= runBatch();
+    ok &= runCache();
+    ok &= runDiagnostics();
+    ok &= runLogging();
+    ok &= runMetrics();
+    ok &= runTrace();
+    ok &= runCorpus();
+    ok &= runSentences();
+    ok &= runCoverage();
+    ok &= runMutation();
+    ok &= runFuzz();
+    ok &= runPdaConversion();
+    ok &= runPdaExecutor();
+    ok &= runDpda();
+    ok &= runDfa();
+    ok &= runPrefilter();
+    ok &= runInterleave();
+    ok &= runPipeline();
+    ok &= runServer();
+    ok &= runProxy();
+    ok &= runCapture();
+    return ok;
 }
@@ -9,8 +9,77 @@
 
 class HTTP10Tests {
 public:
-    static void runAll();
+    static bool runAll();
     static bool runSingle(const std::string& filename);
+
+    // Multithreaded batch validation must match sequential validation
+    static bool runBatch();
+
+    // Sharded LRU verdict cache in front of the validator
+    static bool runCache();
+
+    // Silent verdicts, diagnostics re-run only for rejects
+    static bool runDiagnostics();
+
+    // Leveled logging: engines write to sinks, never to std::cout
+    static bool runLogging();
+
+    // Per-stage latency histograms, counters and their exports
+    static bool runMetrics();
+
+    // Chrome trace_event timelines from per-thread rings
+    static bool runTrace();
+
+    // Seeded bulk corpus generation (records, formats, threads)
+    static bool runCorpus();
+
+    // Grammar-driven random sentences for any CFG
+    static bool runSentences();
+
+    // Coverage-guided corpus over productions, SLR states and ACTION cells
+    static bool runCoverage();
+
+    // Grammar-aware mutants of valid requests
+    static bool runMutation();
+
+    // Fuzz entry points, malformed-input hardening, SLR vs Earley
+    static bool runFuzz();
+
+    // Worklist PDA -> CFG against the eager triple construction
+    static bool runPdaConversion();
+
+    // Direct PDA execution: deterministic fast path and configuration sets
+    static bool runPdaExecutor();
+
+    // PDA determinism analysis and the compiled DPDA table
+    static bool runDpda();
+
+    // Regular grammars and bounded PDAs compiled to a minimized DFA
+    static bool runDfa();
+
+    // Regular over-approximation of a CFG as a validator prefilter
+    static bool runPrefilter();
+
+    // Several messages interleaved through the SLR and DFA tables
+    static bool runInterleave();
+
+    // Splitting streams into requests (blank line + Content-Length)
+    static bool runFraming();
+
+    // Content-Length semantics and streamed (never buffered) bodies
+    static bool runBody();
+
+    // Stage-parallel pipeline must match sequential validation
+    static bool runPipeline();
+
+    // Validation daemon round trips (Linux builds only)
+    static bool runServer();
+
+    // Validating proxy in front of a stand-in upstream (Linux builds only)
+    static bool runProxy();
+
+    // pcap + pcapng ingestion with TCP reassembly
+    static bool runCapture();
 };
 
 #endif
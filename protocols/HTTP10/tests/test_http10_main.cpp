@@ -1,6 +1,5 @@
 #include "HTTP10tests.h"
 
 int main() {
-    HTTP10Tests::runAll();
-    return 0;
+    return HTTP10Tests::runAll() ? 0 : 1;
 }
@@ -0,0 +1,440 @@
+#include "ValidatingProxy.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t nanosBetween(Clock::time_point a, Clock::time_point b) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count();
+}
+
+// Bounds blocking connect/send on `fd`; <= 0 leaves them unbounded
+void setSendTimeout(int fd, int ms) {
+    if (ms <= 0) return;
+    timeval tv{ms / 1000, (ms % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool sendAll(int fd, const char* data, size_t n) {
+    size_t off = 0;
+    while (off < n) {
+        ssize_t w = send(fd, data + off, n - off, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        off += (size_t)w;
+    }
+    return true;
+}
+
+void sendStatus(int fd, const char* status, const std::string& body) {
+    std::string resp = std::string("HTTP/1.0 ") + status + "\r\n"
+                       "Content-Type: text/plain\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "\r\n" + body;
+    sendAll(fd, resp.data(), resp.size());
+}
+
+// Closing with the request still unread would reset the connection and
+// could discard the answer before the client reads it: end our side, then
+// give the request a moment to arrive and be thrown away
+void lingeringClose(int fd) {
+    shutdown(fd, SHUT_WR);
+    char sink[4096];
+    pollfd pfd{fd, POLLIN, 0};
+    while (poll(&pfd, 1, 10) > 0 && recv(fd, sink, sizeof(sink), MSG_DONTWAIT) > 0) {}
+    close(fd);
+}
+
+// Move up to `limit` readable bytes from `src` to `dst` through `pipeFds`
+// without copying through user space. Returns bytes moved, 0 on EOF, -1 on error.
+ssize_t pump(int src, int dst, const int pipeFds[2], size_t limit = 64 * 1024) {
+    limit = std::min<size_t>(limit, 64 * 1024);
+    ssize_t in = splice(src, nullptr, pipeFds[1], nullptr, limit, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (in < 0 && errno == EINVAL) {
+        // splice not supported for this pair: plain copy
+        char buf[16 * 1024];
+        ssize_t r = recv(src, buf, std::min(sizeof(buf), limit), 0);
+        if (r <= 0) return r;
+        return sendAll(dst, buf, (size_t)r) ? r : -1;
+    }
+    if (in <= 0) return in;
+
+    ssize_t left = in;
+    while (left > 0) {
+        ssize_t out = splice(pipeFds[0], nullptr, dst, nullptr, (size_t)left, SPLICE_F_MOVE);
+        if (out < 0 && errno == EINTR) continue;
+        if (out <= 0) {
+            if (out < 0 && errno == EAGAIN) errno = ETIMEDOUT;    // SO_SNDTIMEO, not "no data"
+            return -1;
+        }
+        left -= out;
+    }
+    return in;
+}
+
+} // namespace
+
+double ProxyStats::meanValidateMicros() const {
+    uint64_t n = forwarded + rejected - rejectedEarly;
+    return n ? (double)validateNanosTotal / (double)n / 1000.0 : 0.0;
+}
+
+double ProxyStats::meanForwardMicros() const {
+    return forwarded ? (double)forwardNanosTotal / (double)forwarded / 1000.0 : 0.0;
+}
+
+ValidatingProxy::ValidatingProxy(const HTTP10Validator& validator, ProxyOptions options)
+    : validator(validator), options(std::move(options))
+{
+}
+
+ValidatingProxy::~ValidatingProxy() {
+    stop();
+}
+
+void ValidatingProxy::start() {
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options.listenPort);
+    if (inet_pton(AF_INET, options.listenHost.c_str(), &addr.sin_addr) != 1)
+        throw std::runtime_error("Invalid listen address: " + options.listenHost);
+
+    if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, SOMAXCONN) < 0)
+        throw std::runtime_error("bind/listen " + options.listenHost + ": " + std::strerror(errno));
+
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, (sockaddr*)&addr, &len);
+    port = ntohs(addr.sin_port);
+
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0)
+        throw std::runtime_error(std::string("eventfd: ") + std::strerror(errno));
+
+    running = true;
+    acceptThread = std::thread(&ValidatingProxy::acceptLoop, this);
+}
+
+void ValidatingProxy::stop() {
+    if (!running.exchange(false)) return;
+
+    if (acceptThread.joinable()) acceptThread.join();
+    close(listenFd);
+    listenFd = -1;
+
+    // The eventfd stays readable from here on: every session poll sees it,
+    // including a relay waiting on an upstream that never answers
+    uint64_t one = 1;
+    (void)!write(wakeFd, &one, sizeof(one));
+
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    for (auto& s : sessions)
+        shutdown(s.clientFd, SHUT_RDWR);    // wakes a session blocked in recv/send
+    for (auto& s : sessions) {
+        if (s.thread.joinable()) s.thread.join();
+        close(s.clientFd);
+    }
+    sessions.clear();
+    close(wakeFd);
+    wakeFd = -1;
+}
+
+ProxyStats ValidatingProxy::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return counters;
+}
+
+void ValidatingProxy::reapFinished() {
+    // Caller holds sessionsMutex. The client fd is closed here, after the
+    // join, so stop() can never shut down a recycled descriptor.
+    for (auto it = sessions.begin(); it != sessions.end();) {
+        if (it->done) {
+            it->thread.join();
+            close(it->clientFd);
+            it = sessions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ValidatingProxy::acceptLoop() {
+    while (running) {
+        pollfd pfd{listenFd, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) continue;
+
+        int cfd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (cfd < 0) continue;
+
+        int one = 1;
+        setsockopt(cfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        setSendTimeout(cfd, options.idleTimeoutMs);     // a client that never reads
+
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        reapFinished();
+
+        if (sessions.size() >= options.maxConnections) {
+            {
+                std::lock_guard<std::mutex> statsLock(statsMutex);
+                counters.refused++;
+            }
+            sendStatus(cfd, "503 Service Unavailable", "Too many connections\n");
+            lingeringClose(cfd);
+            continue;
+        }
+
+        Session& s = sessions.emplace_back();
+        s.clientFd = cfd;
+        s.thread = std::thread(&ValidatingProxy::handle, this, std::ref(s));
+
+        std::lock_guard<std::mutex> statsLock(statsMutex);
+        counters.connections++;
+    }
+}
+
+int ValidatingProxy::connectUpstream() const {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    setSendTimeout(fd, options.idleTimeoutMs);          // bounds connect() too
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options.upstreamPort);
+    inet_pton(AF_INET, options.upstreamHost.c_str(), &addr.sin_addr);
+
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+void ValidatingProxy::handle(Session& session) {
+    const int cfd = session.clientFd;
+    ValidatorScratch scratch;
+    PrefixCheck prefix;
+    std::string buf;
+    char chunk[4096];
+
+    // The fd itself is closed by reapFinished(); shutting it down here is
+    // what tells the client the (HTTP/1.0) response is complete.
+    auto finish = [&]() {
+        shutdown(cfd, SHUT_RDWR);
+        session.done = true;
+    };
+
+    // Verdicts come from the silent fast path. The full diagnostic is opt-in
+    // (explainRejects): by default a flood of malformed requests costs no
+    // more than validating it
+    auto reject = [&](const Verdict& v, bool early, std::string_view message = {}) {
+        std::string body = std::string("Rejected by validator: ") + verdictCodeName(v.code) +
+                           " at offset " + std::to_string(v.errorOffset) + "\n";
+        if (options.explainRejects && !message.empty() && v.code != VerdictCode::FramingError)
+            body += "\n" + validator.explain(message).format();
+        sendStatus(cfd, "400 Bad Request", body);
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.rejected++;
+        if (early) counters.rejectedEarly++;
+    };
+
+    // ----- 1. header block, validated line by line as it arrives -----
+    const auto headerDeadline = Clock::now() + std::chrono::milliseconds(options.headerTimeoutMs);
+    size_t headerEnd = std::string::npos;
+    while (headerEnd == std::string::npos) {
+        int waitMs = -1;
+        if (options.headerTimeoutMs > 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(headerDeadline - Clock::now());
+            waitMs = (int)std::max<int64_t>(left.count(), 0);
+        }
+        pollfd pfds[2] = {{cfd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        int ready = waitMs == 0 ? 0 : poll(pfds, 2, waitMs);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0 || pfds[1].revents) return finish();
+        if (ready == 0) {
+            sendStatus(cfd, "408 Request Timeout", "Header block not received in time\n");
+            std::lock_guard<std::mutex> lock(statsMutex);
+            counters.headerTimeouts++;
+            return finish();
+        }
+
+        ssize_t r = recv(cfd, chunk, sizeof(chunk), 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return finish();
+
+        size_t scanFrom = buf.size() >= 2 ? buf.size() - 2 : 0;
+        buf.append(chunk, (size_t)r);
+        headerEnd = HTTP10Framer::findHeaderEnd(buf, scanFrom);
+        if (headerEnd != std::string::npos) break;
+
+        if (buf.size() > options.maxHeaderBytes) {
+            Verdict v;
+            v.code = VerdictCode::SyntaxError;
+            v.errorOffset = (int32_t)options.maxHeaderBytes;
+            reject(v, true);
+            return finish();
+        }
+
+        // Complete lines are parsed once, as they arrive; only the final
+        // validate() below counts the request in the metrics
+        Verdict v;
+        if (!validator.checkPrefix(buf, prefix, scratch.tokenizer, v)) {
+            reject(v, true, std::string_view(buf.data(), prefix.checked));
+            return finish();
+        }
+    }
+
+    // ----- 2. full validation of the header block -----
+    auto tHeaders = Clock::now();
+    std::string_view head(buf.data(), headerEnd);
+    Verdict verdict = validator.validate(head, scratch, options.cache);
+
+    // An ambiguous body length would let upstream see a different request
+    // boundary than the one we validated
+    uint64_t bodyLength = 0;
+    bool hasBody = false;
+    if (verdict.ok() && !HTTP10Framer::contentLength(head, bodyLength, hasBody))
+        verdict.code = VerdictCode::FramingError;
+    auto tValidated = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        uint64_t ns = nanosBetween(tHeaders, tValidated);
+        counters.validateNanosTotal += ns;
+        counters.validateNanosMax = std::max(counters.validateNanosMax, ns);
+    }
+
+    if (!verdict.ok()) {
+        reject(verdict, false, head);
+        return finish();
+    }
+
+    // ----- 3. forward and relay -----
+    // HTTP/1.0 carries one request per connection: exactly the validated
+    // head and its declared body go upstream. Anything the client sent
+    // past them is dropped, a second request must never get through.
+    const uint64_t bodyBuffered = std::min<uint64_t>(buf.size() - headerEnd, bodyLength);
+    const size_t requestBuffered = headerEnd + (size_t)bodyBuffered;
+    if (buf.size() > requestBuffered) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.trailingDropped++;
+    }
+
+    int ufd = connectUpstream();
+    if (ufd < 0 || !sendAll(ufd, buf.data(), requestBuffered)) {
+        sendStatus(cfd, "502 Bad Gateway", "Upstream unavailable\n");
+        if (ufd >= 0) close(ufd);
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters.upstreamErrors++;
+        return finish();
+    }
+    auto tForwarded = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        uint64_t ns = nanosBetween(tHeaders, tForwarded);
+        counters.forwarded++;
+        counters.forwardNanosTotal += ns;
+        counters.forwardNanosMax = std::max(counters.forwardNanosMax, ns);
+    }
+
+    RelayEnd end = relay(cfd, ufd, bodyLength - bodyBuffered);
+    if (end != RelayEnd::Complete) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        if (end == RelayEnd::Timeout) counters.idleTimeouts++;
+        else                          counters.upstreamErrors++;
+    }
+    close(ufd);
+    finish();
+}
+
+ValidatingProxy::RelayEnd ValidatingProxy::relay(int clientFd, int upstreamFd, uint64_t bodyLeft) {
+    int toUpstream[2], toClient[2];
+    if (pipe2(toUpstream, O_CLOEXEC) < 0) return RelayEnd::Error;
+    if (pipe2(toClient, O_CLOEXEC) < 0) {
+        close(toUpstream[0]);
+        close(toUpstream[1]);
+        return RelayEnd::Error;
+    }
+
+    RelayEnd end = RelayEnd::Complete;
+    bool clientOpen = bodyLeft > 0;     // the rest of the declared body, nothing more
+    bool answered = false;              // response bytes reached the client
+
+    // HTTP/1.0: the response ends when the upstream closes
+    while (true) {
+        // A closed side leaves the set: poll reports POLLHUP/POLLERR even
+        // with no events requested, and nothing would consume them
+        pollfd pfds[3] = {
+            { upstreamFd, POLLIN, 0 },
+            { clientOpen ? clientFd : -1, POLLIN, 0 },
+            { wakeFd, POLLIN, 0 },
+        };
+        int ready = poll(pfds, 3, options.idleTimeoutMs > 0 ? options.idleTimeoutMs : -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            end = RelayEnd::Error;
+            break;
+        }
+        if (ready == 0) {
+            // Mid-response the status line is gone; cutting it short is all that is left
+            if (!answered) sendStatus(clientFd, "504 Gateway Timeout", "Upstream did not answer in time\n");
+            end = RelayEnd::Timeout;
+            break;
+        }
+        if (pfds[2].revents) break;         // stop()
+
+        if (pfds[0].revents) {
+            ssize_t n = pump(upstreamFd, clientFd, toClient);
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+            if (n <= 0) {
+                if (n < 0) end = errno == ETIMEDOUT ? RelayEnd::Timeout : RelayEnd::Error;
+                break;
+            }
+            answered = true;
+        }
+
+        if (clientOpen && pfds[1].revents) {
+            ssize_t n = pump(clientFd, upstreamFd, toUpstream, (size_t)std::min<uint64_t>(bodyLeft, SIZE_MAX));
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+            if (n == 0) {
+                shutdown(upstreamFd, SHUT_WR);      // client ended before the body did
+                clientOpen = false;
+            } else if (n < 0) {
+                if (errno == ETIMEDOUT) end = RelayEnd::Timeout;
+                break;                              // client gone, nothing to deliver to
+            } else if ((bodyLeft -= (uint64_t)n) == 0) {
+                clientOpen = false;                 // anything after the body is never read
+            }
+        }
+    }
+
+    close(toUpstream[0]);
+    close(toUpstream[1]);
+    close(toClient[0]);
+    close(toClient[1]);
+    return end;
+}
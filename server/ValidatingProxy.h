@@ -0,0 +1,117 @@
+//
+// Inline validating reverse proxy for HTTP/1.0: requests are checked while
+// they arrive and only valid ones ever reach the upstream server.
+// Linux only (splice).
+//
+
+#ifndef SERVER_VALIDATINGPROXY_H
+#define SERVER_VALIDATINGPROXY_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../pipeline/HTTP10Validator.h"
+
+struct ProxyOptions {
+    std::string listenHost = "127.0.0.1";
+    uint16_t listenPort = 0;            // 0 = pick a free port (see boundPort())
+    std::string upstreamHost = "127.0.0.1";
+    uint16_t upstreamPort = 80;
+    size_t maxHeaderBytes = 16 * 1024;  // larger header blocks are rejected
+    size_t maxConnections = 256;        // beyond this, new clients get "503 Service Unavailable"
+    int headerTimeoutMs = 10000;        // whole header block must arrive within this, else 408
+    int idleTimeoutMs = 30000;          // no upstream answer (or no progress writing) this long -> 504
+    VerdictCache* cache = nullptr;      // optional, shared by all connections
+    bool explainRejects = false;        // re-run rejects through explain() for a detailed 400 body
+};
+
+struct ProxyStats {
+    uint64_t connections = 0;
+    uint64_t refused = 0;               // turned away at maxConnections
+    uint64_t forwarded = 0;
+    uint64_t rejected = 0;
+    uint64_t rejectedEarly = 0;         // rejected before the header block was complete
+    uint64_t trailingDropped = 0;       // forwarded, but bytes past the request were dropped
+    uint64_t upstreamErrors = 0;
+    uint64_t headerTimeouts = 0;        // answered 408: header block too slow
+    uint64_t idleTimeouts = 0;          // relay idle past idleTimeoutMs (upstream silent, client not reading)
+
+    // Latency the proxy adds, measured from the last header byte arriving
+    // to the request being handed to the upstream socket
+    uint64_t validateNanosTotal = 0;
+    uint64_t validateNanosMax = 0;
+    uint64_t forwardNanosTotal = 0;
+    uint64_t forwardNanosMax = 0;
+
+    [[nodiscard]] double meanValidateMicros() const;
+    [[nodiscard]] double meanForwardMicros() const;
+};
+
+// One thread per client connection: HTTP/1.0 carries one request per
+// connection, so a connection is a short, strictly sequential exchange.
+// At most maxConnections are served at once, counting those waiting on a
+// slow upstream; further clients are answered 503 and closed. Timeouts
+// keep a slot from being held forever: headerTimeoutMs for the whole
+// header block, idleTimeoutMs for any wait on upstream or a socket write.
+//
+//  1. Read the header block. After every read, complete lines are run
+//     through the SLR tables; a syntax error there rejects immediately.
+//  2. On the blank line, validate the whole block (syntax + semantics).
+//     Invalid -> "400 Bad Request", the upstream is never contacted.
+//  3. Valid -> connect upstream, write the buffered header block, then
+//     relay both directions with splice() (kernel-side copy) until EOF.
+//     Client bytes are relayed only up to the declared Content-Length;
+//     whatever follows is dropped, so a second, unvalidated request
+//     pipelined behind a valid one never reaches upstream.
+class ValidatingProxy {
+public:
+    ValidatingProxy(const HTTP10Validator& validator, ProxyOptions options);
+    ~ValidatingProxy();
+
+    ValidatingProxy(const ValidatingProxy&) = delete;
+    ValidatingProxy& operator=(const ValidatingProxy&) = delete;
+
+    // Bind and start accepting. Throws std::runtime_error on failure.
+    void start();
+
+    // Stop accepting, cut open connections and join every thread
+    void stop();
+
+    [[nodiscard]] uint16_t boundPort() const { return port; }
+    [[nodiscard]] ProxyStats stats() const;
+
+private:
+    struct Session {
+        int clientFd = -1;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    void acceptLoop();
+    void handle(Session& session);
+    enum class RelayEnd { Complete, Error, Timeout };
+    RelayEnd relay(int clientFd, int upstreamFd, uint64_t bodyLeft);
+    int connectUpstream() const;
+    void reapFinished();
+
+    const HTTP10Validator& validator;
+    ProxyOptions options;
+
+    int listenFd = -1;
+    int wakeFd = -1;                    // eventfd, readable once stop() began
+    uint16_t port = 0;
+    std::atomic<bool> running{false};
+    std::thread acceptThread;
+
+    std::mutex sessionsMutex;
+    std::list<Session> sessions;
+
+    mutable std::mutex statsMutex;
+    ProxyStats counters;
+};
+
+#endif // SERVER_VALIDATINGPROXY_H
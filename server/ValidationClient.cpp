@@ -0,0 +1,111 @@
+#include "ValidationClient.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "WireFormat.h"
+
+ValidationClient::~ValidationClient() {
+    close();
+}
+
+void ValidationClient::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+void ValidationClient::connectUnix(const std::string& path) {
+    close();
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0)
+        throw std::runtime_error("connect " + path + ": " + std::strerror(errno));
+}
+
+void ValidationClient::connectTcp(const std::string& host, uint16_t port) {
+    close();
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+
+    if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0)
+        throw std::runtime_error("connect " + host + ":" + std::to_string(port) + ": " + std::strerror(errno));
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+void ValidationClient::sendAll(const std::string& data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) throw std::runtime_error(std::string("send: ") + std::strerror(errno));
+        off += (size_t)n;
+    }
+}
+
+void ValidationClient::recvExact(char* dst, size_t n) {
+    size_t off = 0;
+    while (off < n) {
+        ssize_t r = recv(fd, dst + off, n - off, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) throw std::runtime_error("validation daemon closed the connection");
+        off += (size_t)r;
+    }
+}
+
+Verdict ValidationClient::validate(std::string_view message) {
+    sendBuffer.clear();
+    wire::appendRequest(sendBuffer, message);
+    sendAll(sendBuffer);
+
+    char reply[wire::VERDICT_SIZE];
+    recvExact(reply, sizeof(reply));
+    Verdict v;
+    if (!wire::readVerdict(reply, v)) throw std::runtime_error("validation daemon sent a malformed verdict");
+    return v;
+}
+
+std::vector<Verdict> ValidationClient::validatePipelined(const std::vector<std::string_view>& messages) {
+    // The daemon stops reading while too many replies sit unread, so the
+    // replies of one write must fit well under its maxPendingReplyBytes
+    constexpr size_t BATCH = 16 * 1024;
+
+    std::vector<Verdict> out;
+    out.reserve(messages.size());
+    std::string replies;
+    for (size_t first = 0; first < messages.size(); first += BATCH) {
+        size_t n = std::min(BATCH, messages.size() - first);
+        sendBuffer.clear();
+        for (size_t i = 0; i < n; ++i)
+            wire::appendRequest(sendBuffer, messages[first + i]);
+        sendAll(sendBuffer);
+
+        replies.resize(n * wire::VERDICT_SIZE);
+        recvExact(replies.data(), replies.size());
+        for (size_t i = 0; i < n; ++i) {
+            Verdict v;
+            if (!wire::readVerdict(replies.data() + i * wire::VERDICT_SIZE, v))
+                throw std::runtime_error("validation daemon sent a malformed verdict");
+            out.push_back(v);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,45 @@
+//
+// Blocking client for the validation daemon (tests, tools, benchmarks).
+//
+
+#ifndef SERVER_VALIDATIONCLIENT_H
+#define SERVER_VALIDATIONCLIENT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../pipeline/Verdict.h"
+
+class ValidationClient {
+public:
+    ValidationClient() = default;
+    ~ValidationClient();
+
+    ValidationClient(const ValidationClient&) = delete;
+    ValidationClient& operator=(const ValidationClient&) = delete;
+
+    // Throw std::runtime_error when the daemon cannot be reached
+    void connectUnix(const std::string& path);
+    void connectTcp(const std::string& host, uint16_t port);
+
+    // One request, one round trip
+    Verdict validate(std::string_view message);
+
+    // Requests in large writes, each followed by its replies: the daemon
+    // answers in order. Both throw std::runtime_error if the connection
+    // drops or a reply is not a well-formed verdict.
+    std::vector<Verdict> validatePipelined(const std::vector<std::string_view>& messages);
+
+    void close();
+
+private:
+    void sendAll(const std::string& data);
+    void recvExact(char* dst, size_t n);
+
+    int fd = -1;
+    std::string sendBuffer;
+};
+
+#endif // SERVER_VALIDATIONCLIENT_H
@@ -0,0 +1,319 @@
+#include "ValidationServer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "WireFormat.h"
+
+namespace {
+
+struct Connection {
+    int fd = -1;
+    std::string in;
+    size_t inOff = 0;
+    std::string out;
+    size_t outOff = 0;
+    uint32_t events = EPOLLIN | EPOLLRDHUP;   // current epoll interest
+    bool readClosed = false;                  // peer shut down its write side
+};
+
+[[noreturn]] void fail(const std::string& what) {
+    throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+struct ValidationServer::Worker {
+    int epollFd = -1;
+    int wakeFd = -1;
+    ValidatorScratch scratch;
+    std::unordered_map<int, Connection> connections;
+
+    // Written by this worker only, read by stats()
+    std::atomic<uint64_t> connectionsSeen{0};
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> protocolErrors{0};
+};
+
+ValidationServer::ValidationServer(const HTTP10Validator& validator, ServerOptions options)
+    : validator(validator), options(std::move(options))
+{
+    if (this->options.workers == 0) this->options.workers = 1;
+}
+
+ValidationServer::~ValidationServer() {
+    stop();
+    if (listenFd >= 0) close(listenFd);
+    if (!options.unixPath.empty()) unlink(options.unixPath.c_str());
+}
+
+void ValidationServer::start() {
+    // ----- listening socket -----
+    if (!options.unixPath.empty()) {
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) fail("socket");
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (options.unixPath.size() >= sizeof(addr.sun_path))
+            throw std::runtime_error("Unix socket path too long: " + options.unixPath);
+        std::strncpy(addr.sun_path, options.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+
+        unlink(options.unixPath.c_str());   // stale socket from a previous run
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0) fail("bind " + options.unixPath);
+    } else {
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) fail("socket");
+
+        int one = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(options.tcpPort);
+        if (inet_pton(AF_INET, options.tcpHost.c_str(), &addr.sin_addr) != 1)
+            throw std::runtime_error("Invalid listen address: " + options.tcpHost);
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0) fail("bind " + options.tcpHost);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd, (sockaddr*)&addr, &len);
+        port = ntohs(addr.sin_port);
+    }
+
+    if (listen(listenFd, SOMAXCONN) < 0) fail("listen");
+
+    // ----- workers -----
+    for (unsigned i = 0; i < options.workers; ++i) {
+        auto w = std::make_unique<Worker>();
+
+        w->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (w->epollFd < 0) fail("epoll_create1");
+
+        w->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (w->wakeFd < 0) fail("eventfd");
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLEXCLUSIVE;   // only one worker woken per new connection
+        ev.data.fd = listenFd;
+        if (epoll_ctl(w->epollFd, EPOLL_CTL_ADD, listenFd, &ev) < 0) fail("epoll_ctl listen");
+
+        ev.events = EPOLLIN;
+        ev.data.fd = w->wakeFd;
+        if (epoll_ctl(w->epollFd, EPOLL_CTL_ADD, w->wakeFd, &ev) < 0) fail("epoll_ctl eventfd");
+
+        workers.push_back(std::move(w));
+    }
+
+    for (auto& w : workers)
+        threads.emplace_back(&ValidationServer::workerLoop, this, std::ref(*w));
+}
+
+void ValidationServer::stop() {
+    for (auto& w : workers) {
+        uint64_t one = 1;
+        if (w->wakeFd >= 0) (void)!write(w->wakeFd, &one, sizeof(one));
+    }
+    wait();
+}
+
+void ValidationServer::wait() {
+    for (auto& t : threads)
+        if (t.joinable()) t.join();
+    threads.clear();
+
+    for (auto& w : workers) {
+        for (auto& [fd, c] : w->connections) close(fd);
+        w->connections.clear();
+        if (w->epollFd >= 0) { close(w->epollFd); w->epollFd = -1; }
+        if (w->wakeFd >= 0)  { close(w->wakeFd);  w->wakeFd = -1; }
+    }
+}
+
+ServerStats ValidationServer::stats() const {
+    ServerStats s;
+    for (const auto& w : workers) {
+        s.connections    += w->connectionsSeen.load(std::memory_order_relaxed);
+        s.messages       += w->messages.load(std::memory_order_relaxed);
+        s.accepted       += w->accepted.load(std::memory_order_relaxed);
+        s.protocolErrors += w->protocolErrors.load(std::memory_order_relaxed);
+    }
+    s.rejected = s.messages - s.accepted;
+    return s;
+}
+
+void ValidationServer::workerLoop(Worker& w) {
+    const bool tcp = options.unixPath.empty();
+
+    auto closeConnection = [&](int fd) {
+        epoll_ctl(w.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        w.connections.erase(fd);
+    };
+
+    // Replies queued but not yet taken by the socket
+    auto pending = [](const Connection& c) { return c.out.size() - c.outOff; };
+
+    // Read while the peer still sends and keeps up with its replies, write
+    // while replies are pending
+    auto updateInterest = [&](Connection& c) {
+        bool readable = !c.readClosed && pending(c) <= options.maxPendingReplyBytes;
+        uint32_t want = (readable ? (uint32_t)(EPOLLIN | EPOLLRDHUP) : 0u) |
+                        (c.out.empty() ? 0u : (uint32_t)EPOLLOUT);
+        if (want == c.events) return;
+        epoll_event ev{};
+        ev.events = want;
+        ev.data.fd = c.fd;
+        epoll_ctl(w.epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+        c.events = want;
+    };
+
+    // Flush as much of the reply buffer as the socket takes. false = connection broken.
+    auto flush = [&](Connection& c) {
+        while (c.outOff < c.out.size()) {
+            ssize_t n = send(c.fd, c.out.data() + c.outOff, c.out.size() - c.outOff, MSG_NOSIGNAL);
+            if (n > 0) { c.outOff += (size_t)n; continue; }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            return false;
+        }
+        if (c.outOff == c.out.size()) {
+            c.out.clear();
+            c.outOff = 0;
+        } else if (c.outOff > c.out.size() / 2) {
+            c.out.erase(0, c.outOff);
+            c.outOff = 0;
+        }
+        updateInterest(c);
+        return true;
+    };
+
+    // Answer every complete frame in the input buffer. false = protocol error.
+    auto processFrames = [&](Connection& c) {
+        uint64_t done = 0, ok = 0;
+        while (c.in.size() - c.inOff >= wire::HEADER_SIZE) {
+            uint32_t len = wire::readU32(c.in.data() + c.inOff);
+            if (len > options.maxMessageBytes) return false;
+            if (c.in.size() - c.inOff - wire::HEADER_SIZE < len) break;   // partial frame
+
+            std::string_view msg(c.in.data() + c.inOff + wire::HEADER_SIZE, len);
+            Verdict v = validator.validate(msg, w.scratch, options.cache);
+            wire::appendVerdict(c.out, v);
+
+            c.inOff += wire::HEADER_SIZE + len;
+            done++;
+            if (v.ok()) ok++;
+        }
+
+        // Drop consumed bytes once they dominate the buffer
+        if (c.inOff == c.in.size()) {
+            c.in.clear();
+            c.inOff = 0;
+        } else if (c.inOff > c.in.size() / 2) {
+            c.in.erase(0, c.inOff);
+            c.inOff = 0;
+        }
+
+        w.messages.fetch_add(done, std::memory_order_relaxed);
+        w.accepted.fetch_add(ok, std::memory_order_relaxed);
+        return true;
+    };
+
+    epoll_event events[64];
+    char buf[64 * 1024];
+
+    while (true) {
+        int n = epoll_wait(w.epollFd, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+
+            // ----- shutdown -----
+            if (fd == w.wakeFd) return;
+
+            // ----- new connections -----
+            if (fd == listenFd) {
+                while (true) {
+                    int cfd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (cfd < 0) break;     // EAGAIN: another worker took it / backlog empty
+
+                    if (tcp) {
+                        int one = 1;
+                        setsockopt(cfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    }
+
+                    epoll_event ev{};
+                    ev.events = EPOLLIN | EPOLLRDHUP;
+                    ev.data.fd = cfd;
+                    if (epoll_ctl(w.epollFd, EPOLL_CTL_ADD, cfd, &ev) < 0) {
+                        close(cfd);
+                        continue;
+                    }
+                    w.connections[cfd].fd = cfd;
+                    w.connectionsSeen.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            auto it = w.connections.find(fd);
+            if (it == w.connections.end()) continue;
+            Connection& c = it->second;
+            uint32_t ev = events[i].events;
+
+            if (ev & EPOLLOUT) {
+                if (!flush(c) || (c.readClosed && c.out.empty())) {
+                    closeConnection(fd);
+                    continue;
+                }
+            }
+
+            if (!c.readClosed && (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                // Frames are answered after every chunk, so at most one
+                // partial frame (< HEADER_SIZE + maxMessageBytes) stays
+                // buffered; reading pauses once the replies back up
+                bool broken = false;
+                while (!c.readClosed && pending(c) <= options.maxPendingReplyBytes) {
+                    ssize_t r = recv(fd, buf, sizeof(buf), 0);
+                    if (r > 0) {
+                        c.in.append(buf, (size_t)r);
+                        if (!processFrames(c)) {
+                            broken = true;
+                            break;
+                        }
+                        continue;
+                    }
+                    if (r < 0 && errno == EINTR) continue;
+                    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+                    c.readClosed = true;    // orderly shutdown or hard error
+                }
+
+                if (broken) {
+                    w.protocolErrors.fetch_add(1, std::memory_order_relaxed);
+                    closeConnection(fd);
+                    continue;
+                }
+                // A half-closed peer still gets every pending reply
+                if (!flush(c) || (c.readClosed && c.out.empty())) {
+                    closeConnection(fd);
+                    continue;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Long-running validation daemon: compiled grammar loaded once, messages
+// arrive length-prefixed over a Unix domain socket or loopback TCP.
+// Linux only (epoll / eventfd).
+//
+
+#ifndef SERVER_VALIDATIONSERVER_H
+#define SERVER_VALIDATIONSERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../pipeline/HTTP10Validator.h"
+
+struct ServerOptions {
+    std::string unixPath;               // non-empty: listen on this Unix socket
+    std::string tcpHost = "127.0.0.1";  // used when unixPath is empty
+    uint16_t tcpPort = 0;               // 0 = pick a free port (see boundPort())
+    unsigned workers = 1;               // event-loop threads
+    uint32_t maxMessageBytes = 1u << 20;// larger frames close the connection
+    size_t maxPendingReplyBytes = 1u << 20; // stop reading a client that leaves this much unread
+    VerdictCache* cache = nullptr;      // optional, shared by all workers
+};
+
+struct ServerStats {
+    uint64_t connections = 0;
+    uint64_t messages = 0;
+    uint64_t accepted = 0;
+    uint64_t rejected = 0;
+    uint64_t protocolErrors = 0;        // oversized frames, dropped connections
+};
+
+// Every worker runs its own epoll loop and accepts on the shared listening
+// socket (EPOLLEXCLUSIVE), so a connection lives on exactly one thread from
+// accept to close and needs no locking. Frames are answered inline in
+// arrival order; a client may pipeline any number of requests. Frames are
+// answered after every read, so a connection buffers at most one partial
+// frame, and a client that stops reading its replies stops being read.
+class ValidationServer {
+public:
+    ValidationServer(const HTTP10Validator& validator, ServerOptions options);
+    ~ValidationServer();
+
+    ValidationServer(const ValidationServer&) = delete;
+    ValidationServer& operator=(const ValidationServer&) = delete;
+
+    // Bind, listen and spawn the workers. Throws std::runtime_error on failure.
+    void start();
+
+    // Ask every worker to exit, then join them. Safe from a signal-driven thread.
+    void stop();
+
+    // Block until stop() has been called and all workers exited
+    void wait();
+
+    [[nodiscard]] uint16_t boundPort() const { return port; }
+    [[nodiscard]] ServerStats stats() const;
+
+private:
+    struct Worker;
+
+    void workerLoop(Worker& w);
+
+    const HTTP10Validator& validator;
+    ServerOptions options;
+
+    int listenFd = -1;
+    uint16_t port = 0;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+};
+
+#endif // SERVER_VALIDATIONSERVER_H
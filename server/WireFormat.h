@@ -0,0 +1,69 @@
+//
+// Binary framing shared by the validation daemon and its clients.
+//
+// Request : u32 length (little endian) + `length` raw message bytes
+// Response: 8 bytes, one per request, in request order
+//           u8 ok | u8 VerdictCode | u8 flags | u8 reserved (0) | i32 errorOffset (LE)
+//           flags: bit 0 syntaxOk, bit 1 semanticsOk
+//
+
+#ifndef SERVER_WIREFORMAT_H
+#define SERVER_WIREFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../pipeline/Verdict.h"
+
+namespace wire {
+
+constexpr size_t HEADER_SIZE = 4;
+constexpr size_t VERDICT_SIZE = 8;
+
+constexpr uint8_t FLAG_SYNTAX_OK = 1;
+constexpr uint8_t FLAG_SEMANTICS_OK = 2;
+
+inline uint32_t readU32(const char* p) {
+    const auto* u = reinterpret_cast<const unsigned char*>(p);
+    return (uint32_t)u[0] | ((uint32_t)u[1] << 8) | ((uint32_t)u[2] << 16) | ((uint32_t)u[3] << 24);
+}
+
+inline void appendU32(std::string& out, uint32_t v) {
+    char b[4] = { (char)(v & 0xff), (char)((v >> 8) & 0xff), (char)((v >> 16) & 0xff), (char)((v >> 24) & 0xff) };
+    out.append(b, 4);
+}
+
+inline void appendRequest(std::string& out, std::string_view message) {
+    appendU32(out, (uint32_t)message.size());
+    out.append(message.data(), message.size());
+}
+
+inline void appendVerdict(std::string& out, const Verdict& v) {
+    out.push_back(v.ok() ? 1 : 0);
+    out.push_back((char)v.code);
+    out.push_back((char)((v.syntaxOk ? FLAG_SYNTAX_OK : 0) | (v.semanticsOk ? FLAG_SEMANTICS_OK : 0)));
+    out.push_back(0);
+    appendU32(out, (uint32_t)v.errorOffset);
+}
+
+// false (and `v` untouched) if the bytes are not a verdict appendVerdict()
+// could have written: unknown code or flag bits, or `ok` disagreeing with
+// the code
+inline bool readVerdict(const char* p, Verdict& v) {
+    const auto* u = reinterpret_cast<const unsigned char*>(p);
+    if (u[1] >= (unsigned)VerdictCode::Count || (u[2] & ~(FLAG_SYNTAX_OK | FLAG_SEMANTICS_OK)) != 0 ||
+        u[0] != (u[1] == (unsigned)VerdictCode::Ok ? 1 : 0))
+        return false;
+
+    v.code = (VerdictCode)u[1];
+    v.syntaxOk = (u[2] & FLAG_SYNTAX_OK) != 0;
+    v.semanticsOk = (u[2] & FLAG_SEMANTICS_OK) != 0;
+    v.errorOffset = (int32_t)readU32(p + 4);
+    return true;
+}
+
+} // namespace wire
+
+#endif // SERVER_WIREFORMAT_H
@@ -0,0 +1,87 @@
+//
+// validation_daemon: serve HTTP/1.0 validation over a local socket.
+//
+//   validation_daemon [--unix PATH | --tcp PORT] [--workers N] [--cache-mb N] [--grammar FILE]
+//
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <pthread.h>
+
+#include "ValidationServer.h"
+
+static void usage() {
+    std::cerr << "Usage: validation_daemon [--unix PATH | --tcp PORT] [--workers N] [--cache-mb N] [--grammar FILE]\n";
+}
+
+int main(int argc, char** argv) {
+    ServerOptions options;
+    options.tcpPort = 8610;
+    std::string grammar = "protocols/HTTP10/http10.json";
+    size_t cacheMegabytes = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--unix" && hasValue)         options.unixPath = argv[++i];
+        else if (arg == "--tcp" && hasValue)     options.tcpPort = (uint16_t)std::atoi(argv[++i]);
+        else if (arg == "--workers" && hasValue) options.workers = (unsigned)std::atoi(argv[++i]);
+        else if (arg == "--cache-mb" && hasValue) cacheMegabytes = (size_t)std::atol(argv[++i]);
+        else if (arg == "--grammar" && hasValue) grammar = argv[++i];
+        else { usage(); return 2; }
+    }
+
+    // Block SIGINT/SIGTERM in every thread; main waits for them synchronously
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    HTTP10Validator validator(grammar);
+
+    std::unique_ptr<VerdictCache> cache;
+    if (cacheMegabytes > 0) {
+        CacheOptions co;
+        co.maxBytes = cacheMegabytes << 20;
+        cache = std::make_unique<VerdictCache>(co);
+        options.cache = cache.get();
+    }
+    ValidationServer server(validator, options);
+
+    try {
+        server.start();
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << "\n";
+        return 1;
+    }
+
+    if (!options.unixPath.empty())
+        std::cout << "Listening on unix:" << options.unixPath;
+    else
+        std::cout << "Listening on " << options.tcpHost << ":" << server.boundPort();
+    std::cout << " with " << options.workers << " worker(s)\n";
+
+    int sig = 0;
+    sigwait(&signals, &sig);
+
+    server.stop();
+
+    ServerStats st = server.stats();
+    std::cout << "Shutting down: " << st.connections << " connections, "
+              << st.messages << " messages (" << st.accepted << " accepted, "
+              << st.rejected << " rejected), " << st.protocolErrors << " protocol errors\n";
+    if (cache) {
+        CacheStats cs = cache->stats();
+        std::cout << "Cache: " << cs.entries << " entries, " << cs.hits << " hits / "
+                  << cs.misses << " misses (" << cs.hitRate() * 100.0 << "%), "
+                  << cs.evictions << " evictions\n";
+    }
+    return 0;
+}
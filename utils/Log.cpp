@@ -0,0 +1,65 @@
+#include "Log.h"
+
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+std::mutex& sinkMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::vector<LogSink>& sinks() {
+    static std::vector<LogSink> s{Log::streamSink(std::cerr)};
+    return s;
+}
+
+} // namespace
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Off:   return "OFF";
+    }
+    return "?";
+}
+
+void Log::setLevel(LogLevel level) {
+    threshold.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Log::level() {
+    return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed));
+}
+
+void Log::setSink(LogSink sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex());
+    sinks().clear();
+    if (sink) sinks().push_back(std::move(sink));
+}
+
+void Log::addSink(LogSink sink) {
+    if (!sink) return;
+    std::lock_guard<std::mutex> lock(sinkMutex());
+    sinks().push_back(std::move(sink));
+}
+
+LogSink Log::streamSink(std::ostream& os) {
+    return [&os](LogLevel level, std::string_view component, std::string_view message) {
+        os << '[' << logLevelName(level) << "] " << component << ": " << message;
+        if (message.empty() || message.back() != '\n') os << '\n';
+        os.flush();
+    };
+}
+
+void Log::write(LogLevel level, std::string_view component, std::string_view message) {
+    std::lock_guard<std::mutex> lock(sinkMutex());
+    for (const auto& sink : sinks())
+        sink(level, component, message);
+}
@@ -0,0 +1,96 @@
+//
+// Leveled logging with pluggable sinks for the engines (CFG, PDA, SLR,
+// visualization). Nothing here writes to std::cout on its own.
+//
+
+#ifndef UTILS_LOG_H
+#define UTILS_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <sstream>
+#include <string_view>
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// Lowest level compiled in (0 = Trace ... 5 = Off); CMake sets it from the
+// PV_LOG_LEVEL cache variable. Statements below it generate no code.
+#ifndef PV_LOG_LEVEL
+#define PV_LOG_LEVEL 1
+#endif
+
+const char* logLevelName(LogLevel level);
+
+// Receives one finished record. Sinks are called one at a time under the
+// logger's lock, so they need no locking of their own.
+using LogSink = std::function<void(LogLevel level, std::string_view component, std::string_view message)>;
+
+class Log {
+public:
+    [[nodiscard]] static constexpr bool compiled(LogLevel level) {
+        return static_cast<int>(level) >= PV_LOG_LEVEL && level != LogLevel::Off;
+    }
+
+    // Runtime threshold on top of the compiled one (default Warn)
+    static void setLevel(LogLevel level);
+    [[nodiscard]] static LogLevel level();
+
+    // One relaxed load; folds to false for levels that are compiled out
+    [[nodiscard]] static bool enabled(LogLevel level) {
+        return compiled(level) && static_cast<uint8_t>(level) >= threshold.load(std::memory_order_relaxed);
+    }
+
+    // Replaces every sink with `sink`; an empty function discards records
+    static void setSink(LogSink sink);
+    static void addSink(LogSink sink);
+
+    // "[WARN] CFG: message" lines on `os` (the default sink is std::cerr)
+    static LogSink streamSink(std::ostream& os);
+
+    static void write(LogLevel level, std::string_view component, std::string_view message);
+
+private:
+    static inline std::atomic<uint8_t> threshold{static_cast<uint8_t>(LogLevel::Warn)};
+};
+
+// Collects one record and hands it to the sinks when it goes out of scope.
+// Only constructed once the level check passed; use through the macros.
+class LogRecord {
+public:
+    LogRecord(LogLevel level, std::string_view component) : level(level), component(component) {}
+    ~LogRecord() { Log::write(level, component, out.str()); }
+
+    LogRecord(const LogRecord&) = delete;
+    LogRecord& operator=(const LogRecord&) = delete;
+
+    std::ostream& stream() { return out; }
+
+private:
+    LogLevel level;
+    std::string_view component;
+    std::ostringstream out;
+};
+
+// LOG_WARN("CFG") << "conflict at " << cell;
+// Operands are not evaluated unless the level is enabled.
+#define PV_LOG(level, component)                              \
+    if constexpr (!Log::compiled(level)) {}                   \
+    else if (!Log::enabled(level)) {}                         \
+    else LogRecord(level, component).stream()
+
+#define LOG_TRACE(component) PV_LOG(LogLevel::Trace, component)
+#define LOG_DEBUG(component) PV_LOG(LogLevel::Debug, component)
+#define LOG_INFO(component)  PV_LOG(LogLevel::Info, component)
+#define LOG_WARN(component)  PV_LOG(LogLevel::Warn, component)
+#define LOG_ERROR(component) PV_LOG(LogLevel::Error, component)
+
+#endif // UTILS_LOG_H
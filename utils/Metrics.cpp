@@ -0,0 +1,250 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "json.hpp"
+
+namespace {
+
+// Written only by its owning thread (relaxed load + store, no RMW), read
+// by snapshot() from any thread
+struct alignas(64) ThreadSlot {
+    struct StageData {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> max{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> buckets{};
+    };
+
+    std::array<StageData, (size_t)Stage::Count> stages;
+    std::array<std::atomic<uint64_t>, (size_t)Counter::Count> counters{};
+    std::array<std::atomic<uint64_t>, MAX_ERROR_CODES> errors{};
+};
+
+void bump(std::atomic<uint64_t>& a, uint64_t n) {
+    a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+// Slots outlive their threads so totals survive worker pools being torn down
+std::vector<std::unique_ptr<ThreadSlot>>& registry() {
+    static std::vector<std::unique_ptr<ThreadSlot>> slots;
+    return slots;
+}
+
+ThreadSlot& localSlot() {
+    thread_local ThreadSlot* slot = [] {
+        auto owned = std::make_unique<ThreadSlot>();
+        ThreadSlot* raw = owned.get();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        registry().push_back(std::move(owned));
+        return raw;
+    }();
+    return *slot;
+}
+
+std::string errorLabel(MetricsSnapshot::ErrorNamer errorName, size_t code) {
+    const char* name = errorName ? errorName(code) : nullptr;
+    return name ? std::string(name) : std::to_string(code);
+}
+
+} // namespace
+
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::GrammarLoad: return "grammar_load";
+        case Stage::SlrBuild:    return "slr_build";
+        case Stage::Tokenize:    return "tokenize";
+        case Stage::Parse:       return "parse";
+        case Stage::Semantics:   return "semantics";
+        case Stage::TreeBuild:   return "tree_build";
+        case Stage::Render:      return "render";
+        case Stage::Count:       break;
+    }
+    return "?";
+}
+
+const char* counterName(Counter counter) {
+    switch (counter) {
+        case Counter::Messages:         return "messages";
+        case Counter::Tokens:           return "tokens";
+        case Counter::Rejected:         return "rejected";
+        case Counter::CacheHits:        return "cache_hits";
+        case Counter::CacheMisses:      return "cache_misses";
+        case Counter::PrefilterRejects: return "prefilter_rejects";
+        case Counter::PrefilterPasses:  return "prefilter_passes";
+        case Counter::Count:            break;
+    }
+    return "?";
+}
+
+// ---------------------------------------------------------------------------
+// Histogram layout
+// ---------------------------------------------------------------------------
+
+int LatencyHistogram::bucketOf(uint64_t nanos) {
+    if (nanos < SUB_BUCKETS) return (int)nanos;
+
+    // Row r covers [16 << (r - 1), 16 << r) in 16 equal steps
+    const int msb = 63 - std::countl_zero(nanos);
+    const int shift = msb - SUB_BITS;
+    const int row = shift + 1;
+    return row * SUB_BUCKETS + (int)((nanos >> shift) - SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketUpper(int bucket) {
+    if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+
+    const int row = bucket / SUB_BUCKETS;
+    const int shift = row - 1;
+    const uint64_t sub = (uint64_t)(bucket % SUB_BUCKETS) + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+uint64_t HistogramSnapshot::percentileNanos(double q) const {
+    if (count == 0) return 0;
+
+    q = std::clamp(q, 0.0, 1.0);
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)(q * (double)count + 0.5));
+    uint64_t seen = 0;
+    for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank)
+            return std::min(LatencyHistogram::bucketUpper(b), maxNanos);
+    }
+    return maxNanos;
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+void Metrics::record(Stage stage, uint64_t nanos) {
+    auto& s = localSlot().stages[(size_t)stage];
+    bump(s.count, 1);
+    bump(s.sum, nanos);
+    if (nanos > s.max.load(std::memory_order_relaxed))
+        s.max.store(nanos, std::memory_order_relaxed);
+    bump(s.buckets[LatencyHistogram::bucketOf(nanos)], 1);
+}
+
+void Metrics::add(Counter counter, uint64_t n) {
+    if (!enabled()) return;
+    bump(localSlot().counters[(size_t)counter], n);
+}
+
+void Metrics::countError(size_t code) {
+    if (!enabled() || code >= MAX_ERROR_CODES) return;
+    bump(localSlot().errors[code], 1);
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    MetricsSnapshot out;
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    out.threads = registry().size();
+    for (const auto& slot : registry()) {
+        for (size_t i = 0; i < (size_t)Stage::Count; ++i) {
+            const auto& s = slot->stages[i];
+            auto& h = out.stages[i];
+            h.count += s.count.load(std::memory_order_relaxed);
+            h.sumNanos += s.sum.load(std::memory_order_relaxed);
+            h.maxNanos = std::max(h.maxNanos, s.max.load(std::memory_order_relaxed));
+            for (int b = 0; b < LatencyHistogram::BUCKETS; ++b)
+                h.buckets[b] += s.buckets[b].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < (size_t)Counter::Count; ++i)
+            out.counters[i] += slot->counters[i].load(std::memory_order_relaxed);
+        for (size_t i = 0; i < MAX_ERROR_CODES; ++i)
+            out.errors[i] += slot->errors[i].load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& slot : registry()) {
+        for (auto& s : slot->stages) {
+            s.count.store(0, std::memory_order_relaxed);
+            s.sum.store(0, std::memory_order_relaxed);
+            s.max.store(0, std::memory_order_relaxed);
+            for (auto& b : s.buckets) b.store(0, std::memory_order_relaxed);
+        }
+        for (auto& c : slot->counters) c.store(0, std::memory_order_relaxed);
+        for (auto& e : slot->errors) e.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Export
+// ---------------------------------------------------------------------------
+
+std::string MetricsSnapshot::toJson(ErrorNamer errorName) const {
+    nlohmann::json j;
+
+    for (size_t i = 0; i < (size_t)Stage::Count; ++i) {
+        const auto& h = stages[i];
+        j["stages"][stageName((Stage)i)] = {
+            {"count", h.count},
+            {"sum_ns", h.sumNanos},
+            {"mean_ns", h.meanNanos()},
+            {"p50_ns", h.percentileNanos(0.50)},
+            {"p90_ns", h.percentileNanos(0.90)},
+            {"p99_ns", h.percentileNanos(0.99)},
+            {"p999_ns", h.percentileNanos(0.999)},
+            {"max_ns", h.maxNanos},
+        };
+    }
+
+    for (size_t i = 0; i < (size_t)Counter::Count; ++i)
+        j["counters"][counterName((Counter)i)] = counters[i];
+
+    j["errors"] = nlohmann::json::object();
+    for (size_t code = 0; code < MAX_ERROR_CODES; ++code) {
+        if (errors[code])
+            j["errors"][errorLabel(errorName, code)] = errors[code];
+    }
+
+    j["threads"] = threads;
+    return j.dump(2);
+}
+
+std::string MetricsSnapshot::toPrometheus(ErrorNamer errorName) const {
+    std::ostringstream out;
+
+    // Native Prometheus summaries: quantiles in seconds plus _sum/_count
+    out << "# HELP pv_stage_seconds Time spent per pipeline stage.\n";
+    out << "# TYPE pv_stage_seconds summary\n";
+    for (size_t i = 0; i < (size_t)Stage::Count; ++i) {
+        const auto& h = stages[i];
+        const char* name = stageName((Stage)i);
+        for (double q : {0.5, 0.9, 0.99, 0.999}) {
+            out << "pv_stage_seconds{stage=\"" << name << "\",quantile=\"" << q << "\"} "
+                << (double)h.percentileNanos(q) * 1e-9 << "\n";
+        }
+        out << "pv_stage_seconds_sum{stage=\"" << name << "\"} " << (double)h.sumNanos * 1e-9 << "\n";
+        out << "pv_stage_seconds_count{stage=\"" << name << "\"} " << h.count << "\n";
+    }
+
+    for (size_t i = 0; i < (size_t)Counter::Count; ++i) {
+        const char* name = counterName((Counter)i);
+        out << "# TYPE pv_" << name << "_total counter\n";
+        out << "pv_" << name << "_total " << counters[i] << "\n";
+    }
+
+    out << "# TYPE pv_errors_total counter\n";
+    for (size_t code = 0; code < MAX_ERROR_CODES; ++code) {
+        if (errors[code])
+            out << "pv_errors_total{code=\"" << errorLabel(errorName, code) << "\"} " << errors[code] << "\n";
+    }
+    return out.str();
+}
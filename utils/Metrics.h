@@ -0,0 +1,154 @@
+//
+// Per-stage latency histograms and event counters for the validation
+// engines, exportable as JSON or Prometheus text.
+//
+
+#ifndef UTILS_METRICS_H
+#define UTILS_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Trace.h"
+
+enum class Stage : uint8_t {
+    GrammarLoad,        // CFG from JSON
+    SlrBuild,           // LR(0) items + ACTION/GOTO
+    Tokenize,
+    Parse,              // SLR::parse, or HTTP10Validator's syntax step (any engine, prefilter included)
+    Semantics,
+    TreeBuild,          // HTTPTreeBuilder
+    Render,             // DOT file + Graphviz
+    Count
+};
+
+enum class Counter : uint8_t {
+    Messages,           // messages run through a validator
+    Tokens,             // tokens produced by the tokenizer
+    Rejected,           // messages with a failing verdict (see errors[])
+    CacheHits,
+    CacheMisses,
+    PrefilterRejects,   // messages the regular prefilter turned away
+    PrefilterPasses,    // messages it handed on to the exact parser
+    Count
+};
+
+const char* stageName(Stage stage);
+const char* counterName(Counter counter);
+
+// HDR-style log-linear histogram of nanosecond latencies: every power of
+// two is split into SUB_BUCKETS linear steps, so any recorded value is
+// reported within 1/SUB_BUCKETS (6.25%) of its true value, from 1 ns up to
+// the full uint64_t range, in a fixed 8 KiB.
+struct LatencyHistogram {
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    [[nodiscard]] static int bucketOf(uint64_t nanos);
+    // Largest value that lands in `bucket`
+    [[nodiscard]] static uint64_t bucketUpper(int bucket);
+};
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sumNanos = 0;
+    uint64_t maxNanos = 0;
+    std::array<uint64_t, LatencyHistogram::BUCKETS> buckets{};
+
+    [[nodiscard]] double meanNanos() const { return count ? (double)sumNanos / (double)count : 0.0; }
+    // Upper bound of the bucket holding the q-quantile (q in [0, 1])
+    [[nodiscard]] uint64_t percentileNanos(double q) const;
+};
+
+// Largest VerdictCode (or any other small error code) that gets its own counter
+constexpr size_t MAX_ERROR_CODES = 32;
+
+struct MetricsSnapshot {
+    std::array<HistogramSnapshot, (size_t)Stage::Count> stages{};
+    std::array<uint64_t, (size_t)Counter::Count> counters{};
+    std::array<uint64_t, MAX_ERROR_CODES> errors{};
+    size_t threads = 0;             // threads that ever recorded something
+
+    [[nodiscard]] const HistogramSnapshot& stage(Stage s) const { return stages[(size_t)s]; }
+    [[nodiscard]] uint64_t counter(Counter c) const { return counters[(size_t)c]; }
+
+    // Names error codes in the exports; codes without a name use their number
+    using ErrorNamer = const char* (*)(size_t code);
+
+    [[nodiscard]] std::string toJson(ErrorNamer errorName = nullptr) const;
+    [[nodiscard]] std::string toPrometheus(ErrorNamer errorName = nullptr) const;
+};
+
+// Process-wide, off by default. Every thread records into its own slot (no
+// locks, no shared cache lines); snapshot() sums the slots of all threads
+// that ever recorded, including ones that have since exited. When disabled
+// a timer or counter costs one relaxed atomic load.
+class Metrics {
+public:
+    static void setEnabled(bool on) { enabledFlag.store(on, std::memory_order_relaxed); }
+    [[nodiscard]] static bool enabled() {
+        return enabledFlag.load(std::memory_order_relaxed) && pauseDepth == 0;
+    }
+
+    static void record(Stage stage, uint64_t nanos);
+    static void add(Counter counter, uint64_t n = 1);
+    static void countError(size_t code);
+
+    [[nodiscard]] static MetricsSnapshot snapshot();
+
+    // Zeroes every slot; records racing with it may survive
+    static void reset();
+
+private:
+    friend class MetricsPause;
+
+    static inline std::atomic<bool> enabledFlag{false};
+    static inline thread_local int pauseDepth = 0;     // MetricsPause scopes open on this thread
+};
+
+// While alive, this thread records nothing: for work that looks at a
+// message again without being its validation (early checks, diagnostics),
+// so every message is counted once
+class MetricsPause {
+public:
+    MetricsPause() { ++Metrics::pauseDepth; }
+    ~MetricsPause() { --Metrics::pauseDepth; }
+
+    MetricsPause(const MetricsPause&) = delete;
+    MetricsPause& operator=(const MetricsPause&) = delete;
+};
+
+// Times one stage from construction to destruction (steady_clock, which
+// is a vDSO TSC read on Linux) into Metrics, and into the trace timeline
+// when Trace is recording. With both off the clock is never read.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage)
+        : stage(stage), metrics(Metrics::enabled()), trace(Trace::enabled())
+    {
+        if (metrics || trace) start = Trace::nowNanos();
+    }
+
+    ~ScopedTimer() {
+        if (!metrics && !trace) return;
+
+        const uint64_t ns = Trace::nowNanos() - start;
+        if (metrics) Metrics::record(stage, ns);
+        if (trace) Trace::record(stageName(stage), start, ns);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage stage;
+    bool metrics;
+    bool trace;
+    uint64_t start = 0;
+};
+
+#endif // UTILS_METRICS_H
@@ -0,0 +1,131 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceRing {
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> head{0};          // events ever written; slot = head % size
+    std::atomic<uint64_t> generation{0};    // start() call the ring was sized for
+    uint32_t tid = 0;
+};
+
+std::atomic<uint64_t> currentGeneration{0};
+std::atomic<size_t> ringCapacity{1 << 16};
+std::atomic<uint64_t> originNanos{0};
+
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::vector<std::unique_ptr<TraceRing>>& registry() {
+    static std::vector<std::unique_ptr<TraceRing>> rings;
+    return rings;
+}
+
+TraceRing& localRing() {
+    thread_local TraceRing* ring = [] {
+        auto owned = std::make_unique<TraceRing>();
+        TraceRing* raw = owned.get();
+        std::lock_guard<std::mutex> lock(registryMutex());
+        raw->tid = (uint32_t)registry().size() + 1;
+        registry().push_back(std::move(owned));
+        return raw;
+    }();
+    return *ring;
+}
+
+} // namespace
+
+void Trace::start(size_t eventsPerThread) {
+    ringCapacity.store(std::max<size_t>(1, eventsPerThread), std::memory_order_relaxed);
+    originNanos.store(nowNanos(), std::memory_order_relaxed);
+    currentGeneration.fetch_add(1, std::memory_order_release);
+    enabledFlag.store(true, std::memory_order_relaxed);
+}
+
+void Trace::record(const char* name, uint64_t startNanos, uint64_t durationNanos) {
+    TraceRing& r = localRing();
+
+    // First event of this thread since start(): size and clear its ring
+    const uint64_t gen = currentGeneration.load(std::memory_order_acquire);
+    if (r.generation.load(std::memory_order_relaxed) != gen) {
+        r.events.assign(ringCapacity.load(std::memory_order_relaxed), TraceEvent{});
+        r.head.store(0, std::memory_order_relaxed);
+        r.generation.store(gen, std::memory_order_release);
+    }
+
+    const uint64_t h = r.head.load(std::memory_order_relaxed);
+    r.events[h % r.events.size()] = TraceEvent{name, startNanos, durationNanos};
+    r.head.store(h + 1, std::memory_order_release);
+}
+
+TraceStats Trace::stats() {
+    TraceStats st;
+    const uint64_t gen = currentGeneration.load(std::memory_order_acquire);
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& r : registry()) {
+        if (r->generation.load(std::memory_order_acquire) != gen) continue;
+        const uint64_t h = r->head.load(std::memory_order_acquire);
+        st.threads++;
+        st.recorded += h;
+        st.dropped += h > r->events.size() ? h - r->events.size() : 0;
+    }
+    return st;
+}
+
+std::string Trace::toChromeJson() {
+    const uint64_t gen = currentGeneration.load(std::memory_order_acquire);
+    const uint64_t origin = originNanos.load(std::memory_order_relaxed);
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    char line[256];
+
+    auto append = [&](int n) {
+        if (!first) out += ",\n";
+        out.append(line, (size_t)std::min(n, (int)sizeof(line) - 1));
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    for (const auto& r : registry()) {
+        if (r->generation.load(std::memory_order_acquire) != gen) continue;
+
+        append(std::snprintf(line, sizeof(line),
+                             "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                             "\"args\":{\"name\":\"thread %u\"}}", r->tid, r->tid));
+
+        // Oldest retained event first
+        const uint64_t h = r->head.load(std::memory_order_acquire);
+        const uint64_t size = r->events.size();
+        for (uint64_t i = h > size ? h - size : 0; i < h; ++i) {
+            const TraceEvent& e = r->events[i % size];
+            if (!e.name || e.startNanos < origin) continue;   // began before start()
+
+            append(std::snprintf(line, sizeof(line),
+                                 "{\"name\":\"%s\",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                                 "\"ts\":%.3f,\"dur\":%.3f}",
+                                 e.name, r->tid,
+                                 (double)(e.startNanos - origin) / 1000.0,
+                                 (double)e.durationNanos / 1000.0));
+        }
+    }
+
+    out += "]}\n";
+    return out;
+}
+
+bool Trace::writeChromeJson(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    file << toChromeJson();
+    return (bool)file;
+}
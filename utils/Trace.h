@@ -0,0 +1,73 @@
+//
+// Timeline recording of pipeline stages, exported as Chrome trace_event
+// JSON (load in Perfetto or chrome://tracing).
+//
+
+#ifndef UTILS_TRACE_H
+#define UTILS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct TraceEvent {
+    const char* name = nullptr;     // static string (stage name, span label)
+    uint64_t startNanos = 0;        // steady_clock
+    uint64_t durationNanos = 0;
+};
+
+struct TraceStats {
+    size_t threads = 0;
+    uint64_t recorded = 0;          // events written since start()
+    uint64_t dropped = 0;           // overwritten by newer ones (ring full)
+};
+
+// Off by default; while off a span costs one relaxed load. Each thread
+// writes complete events into its own fixed-size ring (single producer, no
+// locks, no allocation after the first event), overwriting the oldest when
+// full, so memory stays at eventsPerThread * sizeof(TraceEvent) per thread.
+// Export after stop(): events still being written are not synchronised.
+class Trace {
+public:
+    // Discards earlier events; rings are (re)sized lazily by their threads
+    static void start(size_t eventsPerThread = 1 << 16);
+    static void stop() { enabledFlag.store(false, std::memory_order_relaxed); }
+    [[nodiscard]] static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+
+    static void record(const char* name, uint64_t startNanos, uint64_t durationNanos);
+
+    [[nodiscard]] static TraceStats stats();
+
+    // {"traceEvents": [...]} with one "X" event per span, timestamps in
+    // microseconds since start(), one tid per recording thread
+    [[nodiscard]] static std::string toChromeJson();
+    static bool writeChromeJson(const std::string& path);
+
+    static uint64_t nowNanos() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    static inline std::atomic<bool> enabledFlag{false};
+};
+
+// Records one span from construction to destruction when tracing is on
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name(name), start(Trace::enabled() ? Trace::nowNanos() : 0) {}
+    ~TraceSpan() {
+        if (start) Trace::record(name, start, Trace::nowNanos() - start);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#endif // UTILS_TRACE_H
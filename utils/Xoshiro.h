@@ -0,0 +1,68 @@
+//
+// xoshiro256** pseudo-random generator: small, fast, seedable, and
+// independent per instance (unlike rand()), so every thread can own one.
+//
+
+#ifndef UTILS_XOSHIRO_H
+#define UTILS_XOSHIRO_H
+
+#include <cstdint>
+#include <limits>
+
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    // The 256-bit state is filled from splitmix64, as the authors recommend,
+    // so neighbouring seeds (0, 1, 2, ...) still give unrelated streams
+    explicit Xoshiro256(uint64_t seed = 0) {
+        for (auto& word : s) word = splitmix64(seed);
+    }
+
+    uint64_t operator()() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, n) by multiply-shift (Lemire); the bias is below
+    // n / 2^64, far under anything a corpus generator can observe
+    uint64_t below(uint64_t n) {
+#ifdef __SIZEOF_INT128__
+        return (uint64_t)(((unsigned __int128)(*this)() * n) >> 64);
+#else
+        return n ? (*this)() % n : 0;
+#endif
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return (double)((*this)() >> 11) * 0x1.0p-53; }
+
+    bool chance(double p) { return uniform() < p; }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+
+    // Advances `x` and returns the next splitmix64 output; also handy for
+    // deriving per-record or per-thread seeds from one master seed
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
+
+#endif // UTILS_XOSHIRO_H
@@ -3,6 +3,9 @@
 #include <iostream>
 #include <cstdlib>
 
+#include "../utils/Log.h"
+#include "../utils/Metrics.h"
+
 using namespace std;
 
 string DotGenerator::generate(const ParseTree& root) {
@@ -43,13 +46,14 @@ void DotGenerator::saveToFile(const ParseTree& root, const string& filename) {
     if (file.is_open()) {
         file << dot;
         file.close();
-        cout << "DOT file saved to: " << filename << "\n";
+        LOG_INFO("DotGenerator") << "DOT file saved to: " << filename;
     } else {
-        cerr << "Error: Could not open file " << filename << "\n";
+        LOG_ERROR("DotGenerator") << "Could not open file " << filename;
     }
 }
 
 void DotGenerator::generateImage(const ParseTree& root, const string& pngFilename) {
+    ScopedTimer timer(Stage::Render);
     string dotFilename = pngFilename.substr(0, pngFilename.rfind('.')) + ".dot";
     saveToFile(root, dotFilename);
     
@@ -57,11 +61,11 @@ void DotGenerator::generateImage(const ParseTree& root, const string& pngFilenam
     int result = system(command.c_str());
     
     if (result == 0) {
-        cout << "PNG image saved to: " << pngFilename << "\n";
+        LOG_INFO("DotGenerator") << "PNG image saved to: " << pngFilename;
     } else {
-        cerr << "Error: Failed to generate PNG. Is Graphviz installed?\n";
-        cerr << "Install with Mac: brew install graphviz\n";
-        cerr << "Install with Ubuntu: sudo apt-get install graphviz\n";
-        cerr << "Install with Windows: https://graphviz.org/download// \n";
+        LOG_ERROR("DotGenerator") << "Failed to generate PNG. Is Graphviz installed?\n"
+                                  << "Install with Mac: brew install graphviz\n"
+                                  << "Install with Ubuntu: sudo apt-get install graphviz\n"
+                                  << "Install with Windows: https://graphviz.org/download/";
     }
 }
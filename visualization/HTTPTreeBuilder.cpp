@@ -1,5 +1,7 @@
 #include "HTTPTreeBuilder.h"
 
+#include "../utils/Metrics.h"
+
 using namespace std;
 
 string HTTPTreeBuilder::tokenToTerminal(const Token& token) {
@@ -23,6 +25,7 @@ string HTTPTreeBuilder::tokenToTerminal(const Token& token) {
 }
 
 ParseTree HTTPTreeBuilder::build(const vector<Token>& tokens) {
+    ScopedTimer timer(Stage::TreeBuild);
     vector<ParseTree> children;
     
     // Find key positions in token stream
@@ -53,7 +56,8 @@ ParseTree HTTPTreeBuilder::build(const vector<Token>& tokens) {
     vector<ParseTree> headersChildren;
     vector<ParseTree> currentHeader;
     
-    for (size_t i = firstCRLF + 1; i < tokens.size(); i++) {
+    size_t i = firstCRLF + 1;
+    for (; i < tokens.size(); i++) {
         if (tokens[i].base == BaseToken::END_OF_INPUT) break;
         
         string terminal = tokenToTerminal(tokens[i]);
@@ -67,8 +71,11 @@ ParseTree HTTPTreeBuilder::build(const vector<Token>& tokens) {
             if (!currentHeader.empty()) {
                 // Check if this is an empty line (end of headers)
                 if (currentHeader.size() == 1) {
-                    // Final CRLF
+                    // Final CRLF: the request ends here
                     children.push_back(make_shared<ParseTreeNode>("CRLF\\n(end)"));
+                    currentHeader.clear();
+                    i++;
+                    break;
                 } else {
                     headersChildren.push_back(
                         make_shared<ParseTreeNode>("Header", currentHeader)
@@ -85,6 +92,17 @@ ParseTree HTTPTreeBuilder::build(const vector<Token>& tokens) {
         auto headers = make_shared<ParseTreeNode>("Headers", headersChildren);
         children.push_back(headers);
     }
+
+    // Whatever follows the blank line is not part of this request (a body
+    // or a further request); show it instead of dropping it silently
+    size_t trailing = 0;
+    for (; i < tokens.size(); i++) {
+        if (tokens[i].base != BaseToken::END_OF_INPUT) trailing++;
+    }
+    if (trailing > 0) {
+        children.push_back(make_shared<ParseTreeNode>(
+            "Trailing data\\n(" + to_string(trailing) + " tokens)"));
+    }
     
     return make_shared<ParseTreeNode>("Request", children);
 }